@@ -0,0 +1,266 @@
+/**
+ * @file barrido_escalado.cpp
+ * @brief Barrido de escalado: hilos, tamaño del archivo y cantidad de procesos.
+ *
+ * Hace dos barridos para cada tamaño de original.txt, con cada cantidad de hilos (por defecto
+ * 1, 2, 4, ... hasta el doble de los núcleos):
+ * - Escalado fuerte: para cada cantidad de procesos de --procesos, el mismo trabajo con más
+ *   hilos. Se compara con una ejecución secuencial de esos procesos.
+ * - Escalado débil: el trabajo crece con los hilos (--procesos-por-hilo K procesos por hilo), y
+ *   cada medida paralela se compara con la secuencial de los mismos K * hilos procesos
+ *   (aceleración escalada).
+ * Cada medida es la mediana de --repeticiones ejecuciones. Escribe un CSV con una fila por medida:
+ *   escalado,bytes,procesos,hilos,segundos_secuencial,segundos_paralelo,mb_por_segundo,procesos_por_segundo,aceleracion,eficiencia
+ *
+ * Y ajusta por mínimos cuadrados el modelo que corresponde a cada barrido:
+ * - Amdahl, al fuerte (cada cantidad de procesos): A(p) = 1 / ((1 - f) + f / p), con f la
+ *   fracción paralelizable; el límite de la aceleración es 1 / (1 - f).
+ * - Gustafson, al débil: A(p) = (1 - a) + a * p, con a la fracción que escala con los hilos.
+ *   Gustafson describe trabajo que crece con p; ajustarlo a un barrido fuerte no significa nada.
+ * Los ajustes se escriben en un segundo CSV y se muestran por pantalla con su R².
+ *
+ * Los archivos se generan en barrido_workspace/ (no se toca el original.txt del proyecto).
+ *
+ * Uso: barrido_escalado [--hilos 1,2,4] [--tamanos 1024,65536,...] [--procesos 8,32]
+ *                       [--procesos-por-hilo K] [--repeticiones R] [--csv ARCHIVO] [--ajustes ARCHIVO]
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F06_main_secuencial.h y F07_main_paralelo.h: Los dos modos que se comparan.
+ * - F24_banco_pruebas.h: Proporciona la mediana de las repeticiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F06_main_secuencial.h"
+#include "../src/F07_main_paralelo.h"
+#include "../src/F24_banco_pruebas.h"
+#include <random>
+
+const string workspace_root = "barrido_workspace/";
+
+struct MedidaBarrido
+{
+    long long bytes;
+    int procesos, hilos;
+    double secuencial, paralelo;
+};
+
+vector<long long> leerLista(const string &texto)
+{
+    vector<long long> valores;
+    istringstream lista(texto);
+    string valor;
+    while (getline(lista, valor, ','))
+        if (atoll(valor.c_str()) > 0)
+            valores.push_back(atoll(valor.c_str()));
+    return valores;
+}
+
+// Escribe original.txt con texto pseudoaleatorio en los dos directorios de trabajo
+void generarOriginal(long long bytes)
+{
+    const string alfabeto = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:!?\n";
+    mt19937 azar(static_cast<unsigned>(bytes));
+    vector<char> bloque(TAMANO_BLOQUE);
+    ofstream secuencial("file_workspace_sequential/original.txt", ios::binary), paralelo("file_workspace_parallel/original.txt", ios::binary);
+    while (bytes > 0)
+    {
+        long long largo = min<long long>(bytes, bloque.size());
+        for (long long j = 0; j < largo; j++)
+            bloque[j] = alfabeto[azar() % alfabeto.size()];
+        secuencial.write(bloque.data(), largo);
+        paralelo.write(bloque.data(), largo);
+        bytes -= largo;
+    }
+}
+
+// Mediana de varias ejecuciones de un modo, con la salida de los drivers silenciada
+double medirMediana(int repeticiones, const function<Temporizador()> &modo)
+{
+    vector<double> segundos;
+    for (int r = 0; r < repeticiones; r++)
+    {
+        borrarCopiasDirectorio("file_workspace_sequential/");
+        borrarCopiasDirectorio("file_workspace_parallel/");
+        ostringstream descartada;
+        streambuf *original = cout.rdbuf(descartada.rdbuf());
+        segundos.push_back(modo().duracionSegundos());
+        cout.rdbuf(original);
+    }
+    return calcularEstadistica(segundos).mediana;
+}
+
+// Aceleración medida de una fila
+double aceleracion(const MedidaBarrido &m) { return m.secuencial / m.paralelo; }
+
+// R² de un modelo A(p) sobre las aceleraciones medidas
+double calcularR2(const vector<MedidaBarrido> &medidas, const function<double(double)> &modelo)
+{
+    double media = 0;
+    for (const auto &m : medidas)
+        media += aceleracion(m) / medidas.size();
+    double total = 0, residuo = 0;
+    for (const auto &m : medidas)
+    {
+        double s = aceleracion(m), estimada = modelo(m.hilos);
+        total += (s - media) * (s - media);
+        residuo += (s - estimada) * (s - estimada);
+    }
+    return total > 0 ? 1 - residuo / total : 1;
+}
+
+/**
+ * @brief Ajusta Amdahl a un barrido fuerte: 1 - 1/A = f (1 - 1/p), recta por el origen.
+ */
+void ajustarAmdahl(const vector<MedidaBarrido> &medidas, double &f, double &r2)
+{
+    double sxy = 0, sxx = 0;
+    for (const auto &m : medidas)
+    {
+        double p = m.hilos;
+        sxy += (1 - 1 / p) * (1 - 1 / aceleracion(m));
+        sxx += (1 - 1 / p) * (1 - 1 / p);
+    }
+    f = sxx > 0 ? sxy / sxx : 0;
+    r2 = calcularR2(medidas, [f](double p)
+                    { return 1 / ((1 - f) + f / p); });
+}
+
+/**
+ * @brief Ajusta Gustafson a un barrido débil: A - 1 = a (p - 1), recta por el origen.
+ */
+void ajustarGustafson(const vector<MedidaBarrido> &medidas, double &a, double &r2)
+{
+    double sxy = 0, sxx = 0;
+    for (const auto &m : medidas)
+    {
+        double p = m.hilos;
+        sxy += (p - 1) * (aceleracion(m) - 1);
+        sxx += (p - 1) * (p - 1);
+    }
+    a = sxx > 0 ? sxy / sxx : 0;
+    r2 = calcularR2(medidas, [a](double p)
+                    { return (1 - a) + a * p; });
+}
+
+// Escribe una medida en el CSV y por pantalla
+void mostrarMedida(ofstream &csv, const string &escalado, const MedidaBarrido &m)
+{
+    double s = aceleracion(m);
+    csv << escalado << "," << m.bytes << "," << m.procesos << "," << m.hilos << "," << setprecision(6) << m.secuencial << "," << m.paralelo << ","
+        << m.bytes * m.procesos / m.paralelo / 1e6 << "," << m.procesos / m.paralelo << "," << s << "," << s / m.hilos << "\n";
+    cout << setprecision(3) << left << setw(7) << escalado << right << "bytes " << setw(12) << m.bytes << "  procesos " << setw(5) << m.procesos
+         << "  hilos " << setw(3) << m.hilos << "  secuencial " << m.secuencial << " s  paralelo " << m.paralelo << " s  aceleracion " << s
+         << "  eficiencia " << s / m.hilos << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int nucleos = max(1u, thread::hardware_concurrency());
+    vector<long long> hilos, tamanos = {64 * 1024, 1024 * 1024}, procesos = {8, 32};
+    for (int h = 1; h <= 2 * nucleos; h *= 2)
+        hilos.push_back(h);
+    if (hilos.back() != 2 * nucleos)
+        hilos.push_back(2 * nucleos);
+    int repeticiones = 3, procesosPorHilo = 4;
+    string archivoCSV = "barrido.csv", archivoAjustes = "barrido_ajustes.csv";
+
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        if (opcion == "--hilos" && a + 1 < argc)
+            hilos = leerLista(argv[++a]);
+        else if (opcion == "--tamanos" && a + 1 < argc)
+            tamanos = leerLista(argv[++a]);
+        else if (opcion == "--procesos" && a + 1 < argc)
+            procesos = leerLista(argv[++a]);
+        else if (opcion == "--procesos-por-hilo" && a + 1 < argc)
+            procesosPorHilo = max(1, atoi(argv[++a]));
+        else if (opcion == "--repeticiones" && a + 1 < argc)
+            repeticiones = max(1, atoi(argv[++a]));
+        else if (opcion == "--csv" && a + 1 < argc)
+            archivoCSV = argv[++a];
+        else if (opcion == "--ajustes" && a + 1 < argc)
+            archivoAjustes = argv[++a];
+        else
+        {
+            cerr << "Opcion desconocida: " << opcion << endl;
+            return 1;
+        }
+    }
+
+    ofstream csv(archivoCSV), ajustes(archivoAjustes);
+    if (!csv.is_open() || !ajustes.is_open())
+    {
+        cerr << "No se pudieron crear " << archivoCSV << " y " << archivoAjustes << endl;
+        return 1;
+    }
+    csv << "escalado,bytes,procesos,hilos,segundos_secuencial,segundos_paralelo,mb_por_segundo,procesos_por_segundo,aceleracion,eficiencia\n";
+    // procesos es el total en el fuerte y los procesos por hilo en el débil
+    ajustes << "modelo,bytes,procesos,fraccion,aceleracion_maxima,r2\n";
+
+    // Los drivers usan rutas relativas: se trabaja dentro de barrido_workspace/
+    crearDirectorio(workspace_root);
+    if (chdir(workspace_root.c_str()) != 0)
+    {
+        cerr << "No se pudo entrar en " << workspace_root << endl;
+        return 1;
+    }
+    crearDirectorio("file_workspace_sequential/");
+    crearDirectorio("file_workspace_parallel/");
+
+    cout << "Nucleos: " << nucleos << "  Repeticiones por medida: " << repeticiones << endl;
+    cout << fixed;
+    for (long long bytes : tamanos)
+    {
+        generarOriginal(bytes);
+
+        // Escalado fuerte: mismos procesos, más hilos
+        for (long long n : procesos)
+        {
+            int copias = static_cast<int>(n);
+            double secuencial = medirMediana(repeticiones, [&]
+                                             { return mainSecuencial(copias); });
+            vector<MedidaBarrido> medidas;
+            for (long long h : hilos)
+            {
+                int numHilos = static_cast<int>(h);
+                double paralelo = medirMediana(repeticiones, [&]
+                                               { return mainParalelo(copias, OpcionesProceso(), numHilos); });
+                medidas.push_back({bytes, copias, numHilos, secuencial, paralelo});
+                mostrarMedida(csv, "fuerte", medidas.back());
+            }
+
+            double f, r2;
+            ajustarAmdahl(medidas, f, r2);
+            double limite = f < 1 ? 1 / (1 - f) : INFINITY;
+            ajustes << "amdahl," << bytes << "," << copias << "," << setprecision(6) << f << "," << limite << "," << r2 << "\n";
+            cout << setprecision(3) << "  Amdahl: fraccion paralela " << f << ", aceleracion maxima " << limite << " (R2 " << r2 << ")" << endl;
+        }
+
+        // Escalado débil: procesosPorHilo procesos por hilo, comparado con la secuencial del mismo trabajo
+        vector<MedidaBarrido> medidas;
+        for (long long h : hilos)
+        {
+            int numHilos = static_cast<int>(h), copias = procesosPorHilo * numHilos;
+            double secuencial = medirMediana(repeticiones, [&]
+                                             { return mainSecuencial(copias); });
+            double paralelo = medirMediana(repeticiones, [&]
+                                           { return mainParalelo(copias, OpcionesProceso(), numHilos); });
+            medidas.push_back({bytes, copias, numHilos, secuencial, paralelo});
+            mostrarMedida(csv, "debil", medidas.back());
+        }
+        double a, r2;
+        ajustarGustafson(medidas, a, r2);
+        ajustes << "gustafson," << bytes << "," << procesosPorHilo << "," << setprecision(6) << a << ",," << r2 << "\n";
+        cout << setprecision(3) << "  Gustafson (" << procesosPorHilo << " procesos por hilo): fraccion escalable " << a << " (R2 " << r2 << ")" << endl;
+    }
+
+    borrarCopiasDirectorio("file_workspace_sequential/");
+    borrarCopiasDirectorio("file_workspace_parallel/");
+    cout << "CSV: " << archivoCSV << "  Ajustes: " << archivoAjustes << endl;
+    return 0;
+}
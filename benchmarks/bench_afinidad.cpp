@@ -0,0 +1,116 @@
+/**
+ * @file bench_afinidad.cpp
+ * @brief Benchmark de las políticas de afinidad y de la ubicación NUMA de los buffers.
+ *
+ * Cada hilo cifra y descifra repetidamente un buffer propio (trabajo limitado por memoria, como
+ * la etapa de cifrado con bloques grandes) y se mide el rendimiento total en MB/s para:
+ * - Sin afinidad, con los buffers reservados y tocados por el hilo principal (el caso original:
+ *   la memoria queda en el nodo del hilo principal).
+ * - Cada política (round-robin, compacta, dispersa) con los buffers locales de cada hilo.
+ * - Política compacta con los buffers tocados por el hilo principal (memoria remota a propósito).
+ *
+ * En una máquina de un solo nodo se pueden simular nodos para probar el reparto; la diferencia
+ * de rendimiento solo aparece con nodos reales.
+ *
+ * Uso: bench_afinidad [hilos] [MiB_por_hilo] [pasadas] [nodos_simulados]
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F01_archivo.h: Proporciona el cifrado por carácter y, a través de F17, la colocación de hilos.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F01_archivo.h"
+#include <atomic>
+
+volatile long long sumidero; // Evita que el compilador descarte el recorrido
+
+// Reserva un buffer desde el hilo que llama (primer toque en su nodo) con texto de prueba
+char *reservarBufferRemoto(size_t bytes)
+{
+    char *datos = new char[bytes];
+    for (size_t j = 0; j < bytes; j++)
+        datos[j] = 'a' + j % 26;
+    return datos;
+}
+
+// Cifra y descifra el buffer 'pasadas' veces; devuelve una suma para que no se elimine el trabajo
+long long recorrerBuffer(char *datos, size_t bytes, int pasadas)
+{
+    long long suma = 0;
+    for (int p = 0; p < pasadas; p++)
+    {
+        for (size_t j = 0; j < bytes; j++)
+            datos[j] = encriptarCaracter(datos[j]);
+        for (size_t j = 0; j < bytes; j++)
+            datos[j] = desencriptarCaracter(datos[j]);
+        suma += datos[p % bytes];
+    }
+    return suma;
+}
+
+// Ejecuta el trabajo con una colocación; buffersLocales indica si cada hilo reserva los suyos
+double medir(const ColocacionHilos &colocacion, int hilos, size_t bytes, int pasadas, bool buffersLocales)
+{
+    vector<char *> remotos(hilos, nullptr);
+    if (!buffersLocales)
+        for (int h = 0; h < hilos; h++)
+            remotos[h] = reservarBufferRemoto(bytes);
+
+    atomic<long long> suma{0};
+    atomic<int> listos{0};
+    atomic<bool> salida{false};
+    chrono::steady_clock::time_point inicio;
+    vector<thread> grupo;
+    for (int h = 0; h < hilos; h++)
+    {
+        grupo.emplace_back([&, h]
+                           {
+            colocacion.aplicar(h);
+            char *datos = remotos[h];
+            if (buffersLocales)
+            {
+                datos = bufferLocal(0, bytes);
+                for (size_t j = 0; j < bytes; j++)
+                    datos[j] = 'a' + j % 26;
+            }
+            listos++;
+            while (!salida)
+                this_thread::yield();
+            suma += recorrerBuffer(datos, bytes, pasadas); });
+    }
+    while (listos < hilos)
+        this_thread::yield();
+    inicio = chrono::steady_clock::now();
+    salida = true;
+    for (auto &hilo : grupo)
+        hilo.join();
+    double segundos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count() / 1e9;
+
+    for (char *datos : remotos)
+        delete[] datos;
+    sumidero = suma;
+    return 2.0 * hilos * bytes * pasadas / segundos / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    int hilos = argc > 1 ? atoi(argv[1]) : max(1u, thread::hardware_concurrency());
+    size_t bytes = (argc > 2 ? atoll(argv[2]) : 64) * 1024 * 1024;
+    int pasadas = argc > 3 ? atoi(argv[3]) : 4;
+    int nodosSimulados = argc > 4 ? atoi(argv[4]) : 0;
+
+    cout << ColocacionHilos(AFINIDAD_NINGUNA, nodosSimulados).describir(0);
+    cout << "Hilos: " << hilos << "  Buffer por hilo: " << bytes / (1024 * 1024) << " MiB  Pasadas: " << pasadas << endl;
+    cout << "--------------------------------" << endl;
+    cout << fixed << setprecision(1);
+
+    cout << "ninguna (buffers del hilo principal): " << medir(ColocacionHilos(AFINIDAD_NINGUNA, nodosSimulados), hilos, bytes, pasadas, false) << " MB/s" << endl;
+    for (PoliticaAfinidad p : {AFINIDAD_ROUND_ROBIN, AFINIDAD_COMPACTA, AFINIDAD_DISPERSA})
+        cout << nombresAfinidad[p] << " (buffers locales): " << medir(ColocacionHilos(p, nodosSimulados), hilos, bytes, pasadas, true) << " MB/s" << endl;
+    cout << "compacta (buffers remotos): " << medir(ColocacionHilos(AFINIDAD_COMPACTA, nodosSimulados), hilos, bytes, pasadas, false) << " MB/s" << endl;
+    return 0;
+}
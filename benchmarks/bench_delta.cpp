@@ -0,0 +1,136 @@
+/**
+ * @file bench_delta.cpp
+ * @brief Coste de reprocesar un archivo grande con pocos cambios: completo frente a delta por bloques.
+ *
+ * Genera un archivo de --megas MiB y mide, como referencia, encriptarArchivo más generarHashArchivo
+ * sobre el archivo entero. Después mide reencriptarDelta (F31_delta.h) en cuatro situaciones: la
+ * primera pasada (sin firma, reescribe todo), una segunda sin cambios (solo mira tamaño y fecha),
+ * una tras modificar --cambios bytes repartidos por el archivo y una tras tocar la fecha sin
+ * cambiar el contenido (relee y compara digestos, pero no escribe nada). En cada caso comprueba
+ * que la salida es idéntica a la de encriptarArchivo.
+ *
+ * Los archivos se generan en bench_workspace/delta/.
+ *
+ * Uso: bench_delta [--megas N] [--cambios N] [--hilos N]
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F31_delta.h: El reencriptado por bloques que se mide (incluye F01_archivo.h para la referencia).
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F31_delta.h"
+#include <random>
+
+const string workspace_root = "bench_workspace/delta/";
+
+// Escribe el archivo de entrada con texto pseudoaleatorio
+void generarEntrada(const string &ruta, long long megas)
+{
+    const string alfabeto = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:!?\n";
+    mt19937 azar(42);
+    vector<char> bloque(1 << 20);
+    ofstream salida(ruta, ios::binary);
+    for (long long m = 0; m < megas; m++)
+    {
+        for (char &c : bloque)
+            c = alfabeto[azar() % alfabeto.size()];
+        salida.write(bloque.data(), bloque.size());
+    }
+}
+
+// Sobrescribe un byte en cada una de 'cambios' posiciones repartidas por el archivo
+void modificarBytes(const string &ruta, long long bytes, int cambios)
+{
+    int fd = open(ruta.c_str(), O_WRONLY | O_CLOEXEC);
+    for (int k = 0; k < cambios && fd >= 0; k++)
+    {
+        char c = 'A' + k % 26;
+        if (pwrite(fd, &c, 1, bytes / cambios * k + bytes / (2 * cambios)) != 1)
+            break;
+    }
+    close(fd);
+}
+
+// Compara byte a byte dos archivos
+bool mismosBytes(const string &a, const string &b)
+{
+    ifstream fa(a, ios::binary), fb(b, ios::binary);
+    return fa && fb && equal(istreambuf_iterator<char>(fa), istreambuf_iterator<char>(), istreambuf_iterator<char>(fb));
+}
+
+void mostrarFila(const string &nombre, double segundos, long long leidos, long long escritos, const string &detalle, bool coincide)
+{
+    cout << left << setw(22) << nombre << right << fixed << setprecision(3) << setw(9) << segundos << " s" << setw(10)
+         << setprecision(1) << leidos / 1048576.0 << " MiB" << setw(10) << escritos / 1048576.0 << " MiB  " << detalle
+         << (coincide ? "" : "  SALIDA DISTINTA") << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    long long megas = 256;
+    int cambios = 4, hilos = 0;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        bool valor = a + 1 < argc;
+        if (opcion == "--megas" && valor)
+            megas = max(1LL, atoll(argv[++a]));
+        else if (opcion == "--cambios" && valor)
+            cambios = max(1, atoi(argv[++a]));
+        else if (opcion == "--hilos" && valor)
+            hilos = max(1, atoi(argv[++a]));
+        else
+        {
+            cerr << "Opcion desconocida: " << opcion << endl;
+            return 1;
+        }
+    }
+
+    crearDirectorio("bench_workspace/");
+    crearDirectorio(workspace_root);
+    const string entrada = workspace_root + "entrada.txt", referencia = workspace_root + "referencia.enc",
+                 salida = workspace_root + "delta.enc";
+    generarEntrada(entrada, megas);
+    unlink(salida.c_str());
+    unlink((salida + EXTENSION_FIRMA_BLOQUES).c_str());
+    long long bytes = megas << 20;
+    bool correcto = true;
+
+    cout << "Archivo: " << megas << " MiB  Bloque: " << TAMANO_BLOQUE_DELTA / 1024 << " KiB  Cambios: " << cambios << endl;
+    cout << left << setw(22) << "variante" << right << setw(11) << "tiempo" << setw(14) << "leido" << setw(14) << "escrito" << endl;
+
+    auto completa = [&](const string &nombre)
+    {
+        auto inicio = chrono::steady_clock::now();
+        encriptarArchivo(entrada, referencia);
+        generarHashArchivo(entrada);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        mostrarFila(nombre, segundos, 2 * bytes, bytes, "", true);
+    };
+    auto delta = [&](const string &nombre)
+    {
+        ResultadoDelta r = reencriptarDelta(entrada, salida, hilos);
+        bool coincide = r.correcto && mismosBytes(salida, referencia);
+        correcto = correcto && coincide;
+        mostrarFila(nombre, r.segundos, r.sinCambios ? 0 : r.bytesLeidos, r.bytesEscritos,
+                    to_string(r.bloquesCambiados) + "/" + to_string(r.bloques) + " bloques", coincide);
+    };
+
+    completa("completo");
+    delta("delta primera pasada");
+    delta("delta sin cambios");
+
+    modificarBytes(entrada, bytes, cambios);
+    completa("completo tras cambios");
+    delta("delta tras cambios");
+
+    // Fecha nueva con el mismo contenido: relee y compara digestos, pero no reescribe nada
+    utimensat(AT_FDCWD, entrada.c_str(), nullptr, 0);
+    delta("delta solo fecha");
+
+    return correcto ? 0 : 1;
+}
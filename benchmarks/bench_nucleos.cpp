@@ -0,0 +1,314 @@
+/**
+ * @file bench_nucleos.cpp
+ * @brief Microbenchmarks de cada núcleo de cálculo: cifrado, SHA-256, hexadecimal, comparación y copia.
+ *
+ * Cada núcleo se ejecuta en tandas de al menos MS_TANDA_NUCLEO milisegundos (la cantidad de
+ * repeticiones por tanda se ajusta sola) y se toma la mediana de TANDAS_NUCLEO tandas. Para cada
+ * uno se muestra ns por operación, GB/s y ciclos por byte (con el contador de F20_ciclos.h).
+ *
+ * Núcleos medidos:
+ * - cifrado: encriptarLinea (cifra una copia de la cadena recibida) frente a recorrer un buffer con
+ *   encriptarCaracter en el sitio, y frente a una tabla de 256 entradas precalculada.
+ * - sha: sha_append + sha_digest con mensajes de 0 B hasta --max-bytes (por defecto 64 MiB; con
+ *   --max-bytes 1073741824 llega a 1 GiB), y bloques sueltos de 64 B (una llamada a
+ *   sha_transform por bloque, que es privada y se alcanza a través de sha_append).
+ * - hex: bytesAHexadecimal de un digest de 32 B.
+ * - comparar: compararArchivos y verificarDesencriptado sobre archivos de --archivo-bytes.
+ * - copia: generarCopia (byte a byte) frente a copiar con rdbuf y frente a read/write en bloques.
+ *
+ * Línea base: --guardar-base ARCHIVO escribe "nombre ns_por_op" por núcleo; --comparar ARCHIVO
+ * compara con una línea base y termina con código 1 si algún núcleo es más lento que la
+ * tolerancia (--tolerancia, por defecto 0.15 = 15 %). La línea base incluida
+ * (linea_base_nucleos.txt) es de la máquina de desarrollo: conviene regenerarla en la máquina
+ * donde se vaya a comparar.
+ *
+ * Uso: bench_nucleos [--filtro TEXTO] [--max-bytes N] [--archivo-bytes N]
+ *                    [--guardar-base ARCHIVO] [--comparar ARCHIVO] [--tolerancia T]
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F01_archivo.h: Proporciona las operaciones de archivo y, a través de F02/F03, el cifrado y el hash.
+ * - F20_ciclos.h: Proporciona el contador de ciclos.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F01_archivo.h"
+#include "../src/F20_ciclos.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define MS_TANDA_NUCLEO 50
+#define TANDAS_NUCLEO 5
+
+const string workspace_root = "bench_workspace/";
+
+volatile long long sumidero; // Evita que el compilador descarte los resultados
+
+struct ResultadoNucleo
+{
+    string nombre;
+    double nsPorOperacion;
+    double bytesPorOperacion;
+    double ciclosPorByte;
+};
+
+// Mide una operación: tandas de al menos MS_TANDA_NUCLEO ms y mediana de TANDAS_NUCLEO tandas
+ResultadoNucleo medirNucleo(const string &nombre, double bytes, const function<void()> &operacion)
+{
+    operacion(); // Calentamiento: caché, páginas y predictor de saltos
+
+    long long repeticiones = 1;
+    while (true)
+    {
+        auto inicio = chrono::steady_clock::now();
+        for (long long r = 0; r < repeticiones; r++)
+            operacion();
+        if (chrono::steady_clock::now() - inicio >= chrono::milliseconds(MS_TANDA_NUCLEO))
+            break;
+        repeticiones *= 2;
+    }
+
+    vector<double> ns, ciclos;
+    for (int t = 0; t < TANDAS_NUCLEO; t++)
+    {
+        auto inicio = chrono::steady_clock::now();
+        unsigned long long ciclosInicio = leerCiclos();
+        for (long long r = 0; r < repeticiones; r++)
+            operacion();
+        unsigned long long ciclosFin = leerCiclos();
+        ns.push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count() / static_cast<double>(repeticiones));
+        ciclos.push_back(static_cast<double>(ciclosFin - ciclosInicio) / repeticiones);
+    }
+    sort(ns.begin(), ns.end());
+    sort(ciclos.begin(), ciclos.end());
+    return {nombre, ns[TANDAS_NUCLEO / 2], bytes, bytes > 0 ? ciclos[TANDAS_NUCLEO / 2] / bytes : 0.0};
+}
+
+string formatoBytes(long long bytes)
+{
+    if (bytes >= 1024 * 1024 * 1024LL && bytes % (1024 * 1024 * 1024LL) == 0)
+        return to_string(bytes / (1024 * 1024 * 1024LL)) + "GiB";
+    if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0)
+        return to_string(bytes / (1024 * 1024)) + "MiB";
+    if (bytes >= 1024 && bytes % 1024 == 0)
+        return to_string(bytes / 1024) + "KiB";
+    return to_string(bytes) + "B";
+}
+
+// Texto pseudoaleatorio con letras, dígitos, signos y saltos de línea (recorre todas las ramas del cifrado)
+string generarTexto(size_t bytes, unsigned semilla)
+{
+    const string alfabeto = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:!?\n";
+    mt19937 azar(semilla);
+    string texto(bytes, ' ');
+    for (auto &c : texto)
+        c = alfabeto[azar() % alfabeto.size()];
+    return texto;
+}
+
+void escribirArchivo(const string &ruta, const string &contenido)
+{
+    ofstream salida(ruta, ios::binary);
+    salida.write(contenido.data(), contenido.size());
+}
+
+void copiarConRdbuf(const string &entrada, const string &destino)
+{
+    ifstream origen(entrada, ios::binary);
+    ofstream salida(destino, ios::binary);
+    salida << origen.rdbuf();
+}
+
+void copiarEnBloques(const string &entrada, const string &destino)
+{
+    int fdEntrada = open(entrada.c_str(), O_RDONLY);
+    int fdSalida = open(destino.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    char *bloque = bufferLocal(0, TAMANO_BLOQUE);
+    ssize_t leidos;
+    while (fdEntrada >= 0 && fdSalida >= 0 && (leidos = read(fdEntrada, bloque, TAMANO_BLOQUE)) > 0)
+        if (write(fdSalida, bloque, leidos) != leidos)
+            break;
+    if (fdEntrada >= 0)
+        close(fdEntrada);
+    if (fdSalida >= 0)
+        close(fdSalida);
+}
+
+int main(int argc, char *argv[])
+{
+    string filtro, archivoBase, archivoComparar;
+    long long maxBytes = 64LL * 1024 * 1024, archivoBytes = 1024 * 1024;
+    double tolerancia = 0.15;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        if (opcion == "--filtro" && a + 1 < argc)
+            filtro = argv[++a];
+        else if (opcion == "--max-bytes" && a + 1 < argc)
+            maxBytes = atoll(argv[++a]);
+        else if (opcion == "--archivo-bytes" && a + 1 < argc)
+            archivoBytes = atoll(argv[++a]);
+        else if (opcion == "--guardar-base" && a + 1 < argc)
+            archivoBase = argv[++a];
+        else if (opcion == "--comparar" && a + 1 < argc)
+            archivoComparar = argv[++a];
+        else if (opcion == "--tolerancia" && a + 1 < argc)
+            tolerancia = atof(argv[++a]);
+        else
+        {
+            cerr << "Opcion desconocida: " << opcion << endl;
+            return 2;
+        }
+    }
+
+    calibrarCiclos();
+    crearDirectorio(workspace_root);
+    vector<ResultadoNucleo> resultados;
+    auto medir = [&](const string &nombre, double bytes, const function<void()> &operacion)
+    {
+        if (!filtro.empty() && nombre.find(filtro) == string::npos)
+            return;
+        resultados.push_back(medirNucleo(nombre, bytes, operacion));
+        const ResultadoNucleo &r = resultados.back();
+        cout << left << setw(40) << r.nombre << right << fixed << setprecision(1) << setw(14) << r.nsPorOperacion << " ns/op";
+        if (r.bytesPorOperacion > 0)
+            cout << setprecision(3) << setw(10) << r.bytesPorOperacion / r.nsPorOperacion << " GB/s" << setprecision(2) << setw(10) << r.ciclosPorByte << " ciclos/byte";
+        cout << endl;
+    };
+
+    cout << describirContadorCiclos() << endl;
+    cout << "--------------------------------" << endl;
+
+    // Cifrado
+    {
+        const size_t tamano = 64 * 1024;
+        string texto = generarTexto(tamano, 1);
+        string buffer = texto;
+        char tabla[256];
+        for (int c = 0; c < 256; c++)
+            tabla[c] = encriptarCaracter(static_cast<char>(c));
+
+        medir("cifrado/encriptarLinea/" + formatoBytes(tamano), tamano, [&]
+              { sumidero = encriptarLinea(texto).size(); });
+        medir("cifrado/encriptarCaracter-buffer/" + formatoBytes(tamano), tamano, [&]
+              {
+            for (auto &c : buffer)
+                c = encriptarCaracter(c);
+            sumidero = buffer[0]; });
+        medir("cifrado/tabla-buffer/" + formatoBytes(tamano), tamano, [&]
+              {
+            for (auto &c : buffer)
+                c = tabla[static_cast<unsigned char>(c)];
+            sumidero = buffer[0]; });
+        medir("cifrado/desencriptarLinea/" + formatoBytes(tamano), tamano, [&]
+              { sumidero = desencriptarLinea(texto).size(); });
+    }
+
+    // SHA-256
+    {
+        string bloque = generarTexto(64, 2);
+        sha256 contexto;
+        medir("sha/transform-64B", 64, [&]
+              { contexto.sha_append(reinterpret_cast<const BYTE *>(bloque.data()), bloque.size()); });
+
+        vector<long long> tamanos = {0, 64, 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024, 256 * 1024 * 1024, 1024 * 1024 * 1024LL};
+        string mensaje = generarTexto(min<long long>(maxBytes, tamanos.back()), 3);
+        for (long long tamano : tamanos)
+        {
+            if (tamano > maxBytes)
+                break;
+            medir("sha/digest/" + formatoBytes(tamano), tamano, [&, tamano]
+                  {
+                contexto.sha_reset();
+                contexto.sha_append(reinterpret_cast<const BYTE *>(mensaje.data()), tamano);
+                sumidero = contexto.sha_digest()[0]; });
+        }
+    }
+
+    // Hexadecimal
+    {
+        BYTE digest[SHA256_SIZE];
+        for (int i = 0; i < SHA256_SIZE; i++)
+            digest[i] = static_cast<BYTE>(i * 37);
+        medir("hex/digest-32B", SHA256_SIZE, [&]
+              { sumidero = bytesAHexadecimal(digest, SHA256_SIZE)[0]; });
+    }
+
+    // Comparación y copia sobre archivos
+    {
+        string original = workspace_root + "nucleos_original.txt", copia = workspace_root + "nucleos_copia.txt";
+        string encriptado = workspace_root + "nucleos_encriptado.sha", destino = workspace_root + "nucleos_destino.txt";
+        string texto = generarTexto(archivoBytes, 4);
+        escribirArchivo(original, texto);
+        escribirArchivo(copia, texto);
+        encriptarArchivo(original, encriptado);
+        string tamano = formatoBytes(archivoBytes);
+
+        medir("comparar/compararArchivos/" + tamano, archivoBytes, [&]
+              { sumidero = compararArchivos(original, copia); });
+        medir("comparar/verificarDesencriptado/" + tamano, archivoBytes, [&]
+              { sumidero = verificarDesencriptado(encriptado, original); });
+        medir("copia/generarCopia/" + tamano, archivoBytes, [&]
+              { generarCopia(original, destino); });
+        medir("copia/rdbuf/" + tamano, archivoBytes, [&]
+              { copiarConRdbuf(original, destino); });
+        medir("copia/bloques-read-write/" + tamano, archivoBytes, [&]
+              { copiarEnBloques(original, destino); });
+
+        for (const string &ruta : {original, copia, encriptado, destino})
+            remove(ruta.c_str());
+    }
+
+    if (!archivoBase.empty())
+    {
+        ofstream base(archivoBase);
+        if (!base.is_open())
+        {
+            cerr << "No se pudo crear " << archivoBase << endl;
+            return 2;
+        }
+        base << fixed << setprecision(1);
+        for (const auto &r : resultados)
+            base << r.nombre << " " << r.nsPorOperacion << "\n";
+        cout << "Linea base guardada en " << archivoBase << endl;
+    }
+
+    if (archivoComparar.empty())
+        return 0;
+
+    ifstream base(archivoComparar);
+    if (!base.is_open())
+    {
+        cerr << "No se pudo abrir " << archivoComparar << endl;
+        return 2;
+    }
+    map<string, double> referencia;
+    string nombre;
+    double ns;
+    while (base >> nombre >> ns)
+        referencia[nombre] = ns;
+
+    int regresiones = 0;
+    cout << "--------------------------------" << endl;
+    cout << "Comparacion con " << archivoComparar << " (tolerancia " << setprecision(0) << tolerancia * 100 << " %)" << endl;
+    for (const auto &r : resultados)
+    {
+        auto it = referencia.find(r.nombre);
+        if (it == referencia.end() || it->second <= 0)
+            continue;
+        double cambio = r.nsPorOperacion / it->second - 1;
+        bool regresion = cambio > tolerancia;
+        regresiones += regresion;
+        cout << left << setw(40) << r.nombre << right << showpos << setprecision(1) << setw(8) << cambio * 100 << " %" << noshowpos
+             << (regresion ? "  REGRESION" : "") << endl;
+    }
+    cout << (regresiones == 0 ? "Sin regresiones" : to_string(regresiones) + " regresiones") << endl;
+    return regresiones == 0 ? 0 : 1;
+}
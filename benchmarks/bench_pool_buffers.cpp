@@ -0,0 +1,139 @@
+/**
+ * @file bench_pool_buffers.cpp
+ * @brief Efecto del pool de buffers por hilo en el rendimiento y en la cola de latencia.
+ *
+ * Ejecuta la fase paralela (mainParalelo, con los siete pasos de cada copia) con el pool de
+ * buffers desactivado, como referencia, y activado, alternando las variantes con el banco de
+ * pruebas de F24_banco_pruebas.h. Para cada variante muestra la mediana del tiempo total, el
+ * rendimiento en MB/s y los percentiles de la duración de cada proceso (sin las rondas de
+ * calentamiento), que es donde se notan las reservas de memoria con muchos hilos. Al final
+ * muestra los contadores del pool.
+ *
+ * Los archivos se generan en bench_workspace/pool/ (no se toca el original.txt del proyecto).
+ *
+ * Uso: bench_pool_buffers [--copias N] [--bytes N] [--hilos N] [--repeticiones R]
+ *                         [--calentamiento W] [--paginas-grandes] [--json ARCHIVO]
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F07_main_paralelo.h: La fase paralela que se mide.
+ * - F24_banco_pruebas.h: Repite y alterna las variantes y da medianas con intervalo de confianza.
+ * - F27_pool_buffers.h: El pool que se activa y desactiva (incluido a través de F01_archivo.h).
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F07_main_paralelo.h"
+#include "../src/F24_banco_pruebas.h"
+#include <random>
+
+const string workspace_root = "bench_workspace/pool/";
+
+// Escribe original.txt con texto pseudoaleatorio
+void generarOriginal(long long bytes)
+{
+    const string alfabeto = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:!?\n";
+    mt19937 azar(42);
+    vector<char> bloque(TAMANO_BLOQUE);
+    ofstream salida("file_workspace_parallel/original.txt", ios::binary);
+    while (bytes > 0)
+    {
+        long long largo = min<long long>(bytes, bloque.size());
+        for (long long j = 0; j < largo; j++)
+            bloque[j] = alfabeto[azar() % alfabeto.size()];
+        salida.write(bloque.data(), largo);
+        bytes -= largo;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int copias = 64, hilos = 0;
+    long long bytes = 256 * 1024;
+    ConfiguracionBanco configuracion;
+    configuracion.regenerar = true;
+    string archivoJSON;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        if (opcion == "--copias" && a + 1 < argc)
+            copias = max(1, atoi(argv[++a]));
+        else if (opcion == "--bytes" && a + 1 < argc)
+            bytes = max(1LL, atoll(argv[++a]));
+        else if (opcion == "--hilos" && a + 1 < argc)
+            hilos = atoi(argv[++a]);
+        else if (opcion == "--repeticiones" && a + 1 < argc)
+            configuracion.repeticiones = atoi(argv[++a]);
+        else if (opcion == "--calentamiento" && a + 1 < argc)
+            configuracion.calentamiento = atoi(argv[++a]);
+        else if (opcion == "--paginas-grandes")
+            activarPaginasGrandes();
+        else if (opcion == "--json" && a + 1 < argc)
+            archivoJSON = argv[++a];
+        else
+        {
+            cerr << "Opcion desconocida: " << opcion << endl;
+            return 1;
+        }
+    }
+
+    // mainParalelo usa rutas relativas: se trabaja dentro de bench_workspace/pool/
+    crearDirectorio("bench_workspace/");
+    crearDirectorio(workspace_root);
+    if (chdir(workspace_root.c_str()) != 0)
+    {
+        cerr << "No se pudo entrar en " << workspace_root << endl;
+        return 1;
+    }
+    crearDirectorio("file_workspace_parallel/");
+    generarOriginal(bytes);
+    configuracion.directorios = {"file_workspace_parallel/"};
+
+    const char *nombres[] = {"sin-pool", "pool"};
+    HistogramaLatencia procesos[2];
+    vector<double> medidas[2];
+    int ejecuciones[2] = {0, 0};
+    BancoPruebas banco(configuracion);
+    for (int v = 0; v < 2; v++)
+    {
+        banco.agregar(nombres[v], [&, v]
+                      {
+            poolBuffersActivo.store(v == 1);
+            TiemposEtapas tiempos;
+            OpcionesProceso opciones;
+            opciones.tiempos = &tiempos;
+            double segundos = mainParalelo(copias, opciones, hilos).duracionSegundos();
+            if (++ejecuciones[v] > configuracion.calentamiento)
+            {
+                procesos[v].combinar(tiempos.procesos);
+                medidas[v].push_back(segundos);
+            }
+            return segundos; });
+    }
+
+    cout << "Copias: " << copias << "  Bytes: " << bytes << "  Hilos: " << (hilos > 0 ? to_string(hilos) : "nucleos") << endl;
+    banco.ejecutar();
+    cout << banco.resumen() << endl;
+
+    for (int v = 0; v < 2; v++)
+    {
+        double mediana = calcularEstadistica(medidas[v]).mediana;
+        cout << left << setw(12) << nombres[v] << right << fixed << setprecision(1) << setw(8)
+             << (mediana > 0 ? bytes * copias / mediana / 1e6 : 0.0) << " MB/s  proceso " << procesos[v].resumen() << endl;
+    }
+    poolBuffersActivo.store(true);
+    cout << describirPoolBuffers() << endl;
+
+    if (!archivoJSON.empty())
+    {
+        ofstream salida(archivoJSON);
+        if (!salida.is_open())
+            cerr << "No se pudo crear " << archivoJSON << endl;
+        else
+            salida << banco.json() << endl;
+    }
+    borrarCopiasDirectorio("file_workspace_parallel/");
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file bench_robo_trabajo.cpp
+ * @brief Benchmark de reparto estático frente a robo de trabajo con tamaños de archivo sesgados.
+ *
+ * Genera un lote con muchos archivos pequeños y uno grande, y lo procesa de dos formas con la
+ * misma cantidad de hilos y el mismo trabajo por byte (cifrar, verificar en memoria y calcular
+ * el hash):
+ * - Reparto estático: los archivos se dividen en bloques contiguos, uno por hilo, y cada archivo
+ *   se procesa entero por el hilo que lo recibió.
+ * - Robo de trabajo: EjecutorRoboTrabajo con cada archivo dividido en fragmentos robables.
+ *
+ * Para cada modo muestra el tiempo total y los percentiles del momento en que terminó cada
+ * archivo; la cola (p99 y máximo) es donde se nota el archivo rezagado.
+ *
+ * Uso: bench_robo_trabajo [hilos] [archivos_pequenos] [bytes_pequeno] [bytes_grande]
+ *      bench_robo_trabajo --manifiesto ARCHIVO [hilos]
+ *
+ * Con --manifiesto se usan los archivos de un corpus generado con generar_corpus (por ejemplo
+ * con distribucion=pareto) en lugar del lote de pequeños y uno grande.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F15_robo_trabajo.h: Contiene EjecutorRoboTrabajo y el procesamiento por fragmentos.
+ * - F25_corpus.h: Lee el manifiesto de un corpus sintético.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F15_robo_trabajo.h"
+#include "../src/F25_corpus.h"
+
+const string workspace_root = "bench_workspace/";
+
+// Escribe un archivo de texto pseudoaleatorio (letras, dígitos y espacios) del tamaño pedido
+void generarArchivo(const string &ruta, long long bytes, mt19937 &azar)
+{
+    const string alfabeto = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 \n";
+    vector<char> bloque(TAMANO_BLOQUE);
+    ofstream salida(ruta, ios::binary);
+    while (bytes > 0)
+    {
+        long long largo = min<long long>(bytes, bloque.size());
+        for (long long j = 0; j < largo; j++)
+            bloque[j] = alfabeto[azar() % alfabeto.size()];
+        salida.write(bloque.data(), largo);
+        bytes -= largo;
+    }
+}
+
+// Muestra el tiempo total y los percentiles del instante de fin de cada archivo
+void mostrarResultados(const string &modo, double totalMs, vector<double> finMs)
+{
+    sort(finMs.begin(), finMs.end());
+    auto percentil = [&](double p)
+    { return finMs[min(finMs.size() - 1, static_cast<size_t>(p * finMs.size()))]; };
+
+    cout << fixed << setprecision(3);
+    cout << modo << endl;
+    cout << "  Tiempo total:     " << totalMs << " ms" << endl;
+    cout << "  Fin p50:          " << percentil(0.50) << " ms" << endl;
+    cout << "  Fin p99:          " << percentil(0.99) << " ms" << endl;
+    cout << "  Fin maximo:       " << finMs.back() << " ms" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    string manifiesto;
+    if (argc > 2 && string(argv[1]) == "--manifiesto")
+    {
+        manifiesto = argv[2];
+        argv += 2;
+        argc -= 2;
+    }
+    int hilos = argc > 1 ? atoi(argv[1]) : max(2u, thread::hardware_concurrency());
+    int pequenos = argc > 2 ? atoi(argv[2]) : 2000;
+    long long bytesPequeno = argc > 3 ? atoll(argv[3]) : 16 * 1024;
+    long long bytesGrande = argc > 4 ? atoll(argv[4]) : 64LL * 1024 * 1024;
+
+    const string entrada = workspace_root + "robo_entrada/", salida = workspace_root + "robo_salida/";
+    crearDirectorio(workspace_root);
+    crearDirectorio(entrada);
+    crearDirectorio(salida);
+
+    vector<string> archivos;
+    if (!manifiesto.empty())
+    {
+        ConfiguracionCorpus corpus;
+        vector<EntradaCorpus> entradas;
+        if (!leerManifiestoCorpus(manifiesto, corpus, entradas) || entradas.empty())
+            return 1;
+        long long total = 0;
+        for (const auto &e : entradas)
+        {
+            archivos.push_back(e.ruta);
+            total += e.bytes;
+        }
+        cout << "Hilos: " << hilos << "  Corpus: " << archivos.size() << " archivos, " << total << " B ("
+             << describirConfiguracionCorpus(corpus) << ")" << endl;
+    }
+    else
+    {
+        // El archivo grande va primero: en el reparto estático le toca al primer hilo junto con su bloque
+        mt19937 azar(42);
+        archivos.push_back(entrada + "grande.txt");
+        generarArchivo(archivos.back(), bytesGrande, azar);
+        for (int k = 0; k < pequenos; k++)
+        {
+            archivos.push_back(entrada + "p" + to_string(k) + ".txt");
+            generarArchivo(archivos.back(), bytesPequeno, azar);
+        }
+        cout << "Hilos: " << hilos << "  Pequenos: " << pequenos << " x " << bytesPequeno << " B  Grande: " << bytesGrande << " B" << endl;
+    }
+    cout << "--------------------------------" << endl;
+
+    size_t n = archivos.size();
+
+    // Reparto estático: cada hilo procesa un bloque contiguo de archivos, cada uno en un solo fragmento
+    {
+        vector<unique_ptr<TrabajoArchivoFragmentado>> trabajos;
+        for (size_t k = 0; k < n; k++)
+        {
+            trabajos.emplace_back(new TrabajoArchivoFragmentado());
+            trabajos[k]->entrada = archivos[k];
+            trabajos[k]->salida = salida + to_string(k + 1) + ".sha";
+        }
+
+        vector<double> finMs(n);
+        auto inicio = chrono::steady_clock::now();
+        vector<thread> grupo;
+        for (int h = 0; h < hilos; h++)
+        {
+            grupo.emplace_back([&, h]
+                               {
+                size_t desde = n * h / hilos, hasta = n * (h + 1) / hilos;
+                for (size_t k = desde; k < hasta; k++)
+                {
+                    TrabajoArchivoFragmentado &t = *trabajos[k];
+                    t.tamano = devolverTamanoArchivo(t.entrada);
+                    int fd = open(t.salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                    if (fd >= 0)
+                        close(fd);
+                    t.digestos.assign(1, "");
+                    procesarFragmento(t, 0, 0, t.tamano);
+                    finMs[k] = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count() / 1e6;
+                } });
+        }
+        for (auto &hilo : grupo)
+            hilo.join();
+        double totalMs = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count() / 1e6;
+        mostrarResultados("Reparto estatico", totalMs, finMs);
+    }
+
+    // Robo de trabajo con archivos divididos en fragmentos
+    {
+        vector<unique_ptr<TrabajoArchivoFragmentado>> trabajos;
+        vector<double> finMs(n);
+        auto inicio = chrono::steady_clock::now();
+        long long robadas = 0;
+        {
+            EjecutorRoboTrabajo ejecutor(hilos);
+            for (size_t k = 0; k < n; k++)
+            {
+                trabajos.emplace_back(new TrabajoArchivoFragmentado());
+                trabajos[k]->entrada = archivos[k];
+                trabajos[k]->salida = salida + to_string(k + 1) + ".sha";
+                enviarArchivoFragmentado(ejecutor, *trabajos[k]);
+            }
+            ejecutor.esperarTodo();
+            robadas = ejecutor.totalRobadas();
+        }
+        double totalMs = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count() / 1e6;
+        for (size_t k = 0; k < n; k++)
+            finMs[k] = chrono::duration_cast<chrono::nanoseconds>(trabajos[k]->fin - inicio).count() / 1e6;
+        mostrarResultados("Robo de trabajo", totalMs, finMs);
+        cout << "  Tareas robadas:   " << robadas << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file carga_demonio.cpp
+ * @brief Generador de carga para el demonio (F29_demonio.h): peticiones por segundo y latencia.
+ *
+ * Abre --conexiones conexiones con el demonio; cada una mantiene --en-vuelo peticiones en curso
+ * y envía otra en cuanto recibe una respuesta, hasta completar --peticiones entre todas (o hasta
+ * que pasen --segundos). Los archivos de --lista o -i se piden por turnos. La latencia de cada
+ * petición se mide de extremo a extremo en el cliente y se resume con HistogramaLatencia.
+ *
+ * Con --procesos RUTA_CRYPTO mide además, como referencia, el mismo trabajo lanzando un proceso
+ * "crypto hash" (o encrypt) por petición, que es lo que el demonio evita.
+ *
+ * Uso: carga_demonio [--socket RUTA] [--operacion hash|encrypt] [--fd] [--conexiones C]
+ *                    [--en-vuelo P] [--peticiones N] [--segundos S] [--salida DIR]
+ *                    [--procesos RUTA_CRYPTO] [-i ARCHIVO]... [--lista ARCHIVO]
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F13_lote.h: Lee la lista de archivos (acepta el manifiesto de generar_corpus).
+ * - F21_histograma.h: Histograma de latencias.
+ * - F29_demonio.h: El cliente del demonio.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F13_lote.h"
+#include "../src/F21_histograma.h"
+#include "../src/F29_demonio.h"
+#include <sys/wait.h>
+
+struct ConfiguracionCarga
+{
+    string socket = RUTA_SOCKET_DEMONIO;
+    OperacionDemonio operacion = OP_HASH;
+    bool pasarDescriptores = false;
+    int conexiones = 4, enVuelo = 4;
+    long long peticiones = 10000;
+    double segundos = 0.0;
+    string salida = "bench_workspace/demonio/";
+    vector<string> archivos;
+};
+
+struct ResultadoConexion
+{
+    HistogramaLatencia latencias;
+    long long bytes = 0, errores = 0, cache = 0;
+    bool desconectada = false;
+};
+
+// Una conexión: mantiene enVuelo peticiones en curso hasta agotar el cupo compartido
+void ejecutarConexion(const ConfiguracionCarga &c, int indice, atomic<long long> &restantes, chrono::steady_clock::time_point limite,
+                      ResultadoConexion &resultado)
+{
+    ClienteDemonio cliente;
+    if (!cliente.conectar(c.socket))
+    {
+        resultado.desconectada = true;
+        return;
+    }
+
+    // Cada petición de encrypt escribe en una salida propia de su hueco de vuelo
+    vector<int> libres;
+    for (int h = c.enVuelo - 1; h >= 0; h--)
+        libres.push_back(h);
+    unordered_map<uint64_t, pair<chrono::steady_clock::time_point, int>> enCurso;
+    uint64_t siguiente = 0;
+
+    auto enviar = [&]
+    {
+        if (restantes.fetch_sub(1) <= 0 || (c.segundos > 0 && chrono::steady_clock::now() >= limite))
+            return false;
+        int hueco = libres.back();
+        libres.pop_back();
+        uint64_t id = siguiente++;
+        const string &entrada = c.archivos[(id * c.conexiones + indice) % c.archivos.size()];
+        string salida = c.operacion == OP_HASH ? "" : c.salida + to_string(indice) + "_" + to_string(hueco) + ".enc";
+        vector<int> descriptores;
+        if (c.pasarDescriptores)
+        {
+            descriptores.push_back(open(entrada.c_str(), O_RDONLY | O_CLOEXEC));
+            if (c.operacion != OP_HASH)
+                descriptores.push_back(open(salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+        }
+        enCurso[id] = {chrono::steady_clock::now(), hueco};
+        bool enviado = cliente.enviar(c.operacion, id, entrada, salida, descriptores);
+        cerrarDescriptores(descriptores);
+        return enviado;
+    };
+
+    for (int p = 0; p < c.enVuelo && enviar(); p++)
+        ;
+    while (!enCurso.empty())
+    {
+        RespuestaDemonio r;
+        if (!cliente.recibir(r) || enCurso.count(r.id) == 0)
+        {
+            resultado.desconectada = true;
+            return;
+        }
+        auto [enviada, hueco] = enCurso[r.id];
+        resultado.latencias.registrar(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - enviada).count());
+        enCurso.erase(r.id);
+        libres.push_back(hueco);
+        resultado.bytes += r.bytes;
+        resultado.errores += r.estado != ESTADO_DEMONIO_OK;
+        resultado.cache += r.cache;
+        enviar();
+    }
+}
+
+// Referencia: un proceso "crypto OPERACION" por petición, uno detrás de otro
+void medirProcesos(const ConfiguracionCarga &c, const string &ejecutable, long long peticiones)
+{
+    HistogramaLatencia latencias;
+    long long errores = 0;
+    auto inicio = chrono::steady_clock::now();
+    for (long long k = 0; k < peticiones; k++)
+    {
+        const string &entrada = c.archivos[k % c.archivos.size()];
+        string salida = c.salida + "proceso.enc";
+        vector<string> argumentos = {ejecutable, nombresOperacionesDemonio[c.operacion][0], "-i", entrada, "--backend", "bloques", "--hilos", "1"};
+        if (c.operacion != OP_HASH)
+            argumentos.insert(argumentos.end(), {"-o", salida});
+        vector<char *> argv;
+        for (auto &a : argumentos)
+            argv.push_back(&a[0]);
+        argv.push_back(nullptr);
+
+        auto antes = chrono::steady_clock::now();
+        pid_t hijo = fork();
+        if (hijo == 0)
+        {
+            int nulo = open("/dev/null", O_WRONLY);
+            dup2(nulo, STDOUT_FILENO);
+            execv(ejecutable.c_str(), argv.data());
+            _exit(127);
+        }
+        int estado = 0;
+        if (hijo < 0 || waitpid(hijo, &estado, 0) < 0 || !WIFEXITED(estado) || WEXITSTATUS(estado) != 0)
+            errores++;
+        latencias.registrar(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - antes).count());
+    }
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    cout << left << setw(12) << "procesos" << right << latencias.resumen(segundos) << (errores ? "  errores=" + to_string(errores) : "") << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    ConfiguracionCarga c;
+    string ejecutable;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        bool valor = a + 1 < argc;
+        if (opcion == "--socket" && valor)
+            c.socket = argv[++a];
+        else if (opcion == "--operacion" && valor)
+        {
+            int op = buscarOperacionDemonio(argv[++a]);
+            if (op != OP_HASH && op != OP_ENCRIPTAR && op != OP_DESENCRIPTAR)
+            {
+                cerr << "Operacion no valida: " << argv[a] << endl;
+                return 1;
+            }
+            c.operacion = static_cast<OperacionDemonio>(op);
+        }
+        else if (opcion == "--fd")
+            c.pasarDescriptores = true;
+        else if (opcion == "--conexiones" && valor)
+            c.conexiones = max(1, atoi(argv[++a]));
+        else if (opcion == "--en-vuelo" && valor)
+            c.enVuelo = max(1, min(atoi(argv[++a]), MAX_PENDIENTES_CONEXION)); // Más no llega a estar en curso: el demonio deja de leer
+        else if (opcion == "--peticiones" && valor)
+            c.peticiones = max(1LL, atoll(argv[++a]));
+        else if (opcion == "--segundos" && valor)
+            c.segundos = atof(argv[++a]);
+        else if (opcion == "--salida" && valor)
+            c.salida = normalizarDirectorio(argv[++a]);
+        else if (opcion == "--procesos" && valor)
+            ejecutable = argv[++a];
+        else if (opcion == "-i" && valor)
+            c.archivos.push_back(argv[++a]);
+        else if (opcion == "--lista" && valor)
+        {
+            vector<string> lista = leerListaArchivos(argv[++a]);
+            c.archivos.insert(c.archivos.end(), lista.begin(), lista.end());
+        }
+        else
+        {
+            cerr << "Opcion desconocida: " << opcion << endl;
+            return 1;
+        }
+    }
+    if (c.archivos.empty())
+    {
+        cerr << "Faltan archivos (-i o --lista)" << endl;
+        return 1;
+    }
+    if (c.segundos > 0)
+        c.peticiones = LLONG_MAX / 2;
+    if (c.operacion != OP_HASH)
+    {
+        crearDirectorio("bench_workspace/");
+        crearDirectorio(c.salida);
+    }
+
+    atomic<long long> restantes(c.peticiones);
+    vector<ResultadoConexion> resultados(c.conexiones);
+    vector<thread> hilos;
+    auto inicio = chrono::steady_clock::now();
+    auto limite = inicio + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(c.segundos));
+    for (int k = 0; k < c.conexiones; k++)
+        hilos.emplace_back(ejecutarConexion, cref(c), k, ref(restantes), limite, ref(resultados[k]));
+    for (auto &h : hilos)
+        h.join();
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    HistogramaLatencia total;
+    long long bytes = 0, errores = 0, cache = 0, desconectadas = 0;
+    for (const auto &r : resultados)
+    {
+        total.combinar(r.latencias);
+        bytes += r.bytes;
+        errores += r.errores;
+        cache += r.cache;
+        desconectadas += r.desconectada;
+    }
+    if (desconectadas == c.conexiones && total.getCantidad() == 0)
+    {
+        cerr << "No se pudo conectar con el demonio en " << c.socket << endl;
+        return 1;
+    }
+
+    cout << "Operacion: " << nombresOperacionesDemonio[c.operacion][0] << (c.pasarDescriptores ? " (descriptores)" : " (rutas)")
+         << "  Conexiones: " << c.conexiones << "  En vuelo: " << c.enVuelo << "  Archivos: " << c.archivos.size() << endl;
+    cout << left << setw(12) << "demonio" << right << total.resumen(segundos) << endl;
+    cout << fixed << setprecision(1) << "MB/s atendidos: " << bytes / segundos / 1e6 << "  aciertos de cache: " << cache << "  errores: " << errores
+         << (desconectadas ? "  conexiones perdidas: " + to_string(desconectadas) : "") << endl;
+
+    if (!ejecutable.empty())
+        medirProcesos(c, ejecutable, min<long long>(total.getCantidad(), 200));
+    return errores == 0 && desconectadas == 0 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file comparar_histogramas.cpp
+ * @brief Compara los histogramas de latencia guardados con --histogramas.
+ *
+ * Cada argumento es un archivo generado por el programa principal. Los histogramas con el mismo
+ * nombre dentro de un archivo se suman; si se pasan varios archivos separados por comas en un
+ * mismo argumento (a.txt,b.txt) se combinan como una sola ejecución, lo que sirve para juntar
+ * varias repeticiones. Para cada histograma se muestra una fila por ejecución con los percentiles
+ * y, desde la segunda, la variación del p50 y del p99 respecto de la primera.
+ *
+ * Uso: comparar_histogramas base.txt[,base2.txt...] nuevo.txt[,nuevo2.txt...] ...
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F21_histograma.h: Proporciona HistogramaLatencia y la carga de los archivos.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F21_histograma.h"
+
+typedef map<string, unique_ptr<HistogramaLatencia>> Ejecucion;
+
+// Variación relativa en porcentaje, con signo
+string variacion(long long base, long long nuevo)
+{
+    if (base <= 0)
+        return "      -";
+    ostringstream oss;
+    oss << fixed << setprecision(1) << showpos << setw(7) << 100.0 * (nuevo - base) / base << "%";
+    return oss.str();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "Uso: " << argv[0] << " base.txt[,base2.txt...] nuevo.txt[,nuevo2.txt...] ..." << endl;
+        return 1;
+    }
+
+    vector<string> nombres;
+    vector<Ejecucion> ejecuciones(argc - 1);
+    for (int a = 1; a < argc; a++)
+    {
+        nombres.push_back(argv[a]);
+        istringstream lista(argv[a]);
+        string ruta;
+        while (getline(lista, ruta, ','))
+            if (!cargarHistogramas(ruta, ejecuciones[a - 1]))
+                return 1;
+    }
+
+    // Todos los nombres de histograma, en orden, aunque falten en alguna ejecución
+    map<string, bool> histogramas;
+    for (const auto &e : ejecuciones)
+        for (const auto &h : e)
+            histogramas[h.first] = true;
+
+    cout << fixed << setprecision(3);
+    for (const auto &entrada : histogramas)
+    {
+        const string &nombre = entrada.first;
+        cout << nombre << endl;
+        const HistogramaLatencia *base = nullptr;
+        for (size_t k = 0; k < ejecuciones.size(); k++)
+        {
+            auto it = ejecuciones[k].find(nombre);
+            cout << "  " << left << setw(24) << nombres[k] << right << " ";
+            if (it == ejecuciones[k].end())
+            {
+                cout << "(sin datos)" << endl;
+                continue;
+            }
+            const HistogramaLatencia &h = *it->second;
+            cout << h.resumen();
+            if (base == nullptr)
+                base = &h;
+            else
+                cout << "  p50 " << variacion(base->percentil(50), h.percentil(50)) << "  p99 " << variacion(base->percentil(99), h.percentil(99));
+            cout << endl;
+        }
+    }
+    return 0;
+}
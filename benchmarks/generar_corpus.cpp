@@ -0,0 +1,107 @@
+/**
+ * @file generar_corpus.cpp
+ * @brief Genera, regenera o verifica un corpus sintético determinista (ver F25_corpus.h).
+ *
+ * Con la misma semilla y las mismas opciones se obtienen los mismos archivos (los tamaños
+ * lognormales y de Pareto dependen de la biblioteca matemática, ver F25_corpus.h), así que un
+ * resultado de rendimiento se puede reproducir pasando solo el manifiesto: --regenerar vuelve a
+ * crear el corpus con la configuración de su cabecera y los tamaños y tipos anotados en cada
+ * línea, byte a byte igual en cualquier máquina, y --verificar comprueba tamaños y hashes.
+ *
+ * El manifiesto sirve como entrada de los drivers:
+ *   crypto --lote-lista corpus/corpus.manifiesto
+ *   bench_robo_trabajo --manifiesto corpus/corpus.manifiesto
+ *
+ * Uso: generar_corpus [--salida DIR] [--semilla N] [--bytes N] [--archivos N]
+ *                     [--distribucion fija|uniforme|lognormal|pareto] [--forma X]
+ *                     [--letras X] [--digitos X] [--noascii X] [--binarios X] [--dispersos X]
+ *      generar_corpus --regenerar MANIFIESTO [--salida DIR]
+ *      generar_corpus --verificar MANIFIESTO
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F25_corpus.h: Contiene el generador y el manifiesto.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F25_corpus.h"
+
+int main(int argc, char *argv[])
+{
+    ConfiguracionCorpus config;
+    string salida = "corpus/", regenerar, verificar;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        if (opcion.compare(0, 2, "--") != 0 || a + 1 >= argc)
+        {
+            cerr << "Opcion desconocida: " << opcion << endl;
+            return 1;
+        }
+        string valor = argv[++a];
+        if (opcion == "--salida")
+            salida = valor;
+        else if (opcion == "--regenerar")
+            regenerar = valor;
+        else if (opcion == "--verificar")
+            verificar = valor;
+        else if (!asignarOpcionCorpus(config, opcion.substr(2), valor))
+        {
+            cerr << "Opcion o valor invalido: " << opcion << " " << valor << endl;
+            return 1;
+        }
+    }
+
+    if (!verificar.empty())
+    {
+        vector<EntradaCorpus> entradas;
+        if (!leerManifiestoCorpus(verificar, config, entradas))
+            return 1;
+        int distintos = verificarCorpus(entradas);
+        cout << entradas.size() - distintos << " de " << entradas.size() << " archivos coinciden con el manifiesto" << endl;
+        return distintos == 0 ? 0 : 1;
+    }
+
+    vector<EntradaCorpus> anteriores;
+    if (!regenerar.empty())
+    {
+        if (!leerManifiestoCorpus(regenerar, config, anteriores))
+            return 1;
+        if (static_cast<int>(anteriores.size()) != config.archivos)
+        {
+            cerr << "El manifiesto tiene " << anteriores.size() << " archivos y su cabecera dice " << config.archivos << endl;
+            return 1;
+        }
+    }
+
+    if (config.archivos < 1 || config.bytes < 0 || config.letras + config.digitos + config.noAscii > 1.0 ||
+        config.binarios + config.dispersos > 1.0)
+    {
+        cerr << "Configuracion invalida: " << describirConfiguracionCorpus(config) << endl;
+        return 1;
+    }
+
+    auto inicio = chrono::steady_clock::now();
+    vector<EntradaCorpus> entradas = generarCorpus(config, salida, "", regenerar.empty() ? nullptr : &anteriores);
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    if (entradas.empty())
+        return 1;
+
+    long long tipos[NUM_TIPOS_CORPUS] = {0, 0, 0}, minimo = entradas[0].bytes, maximo = 0;
+    for (const auto &e : entradas)
+    {
+        for (int t = 0; t < NUM_TIPOS_CORPUS; t++)
+            tipos[t] += e.tipo == nombresTiposCorpus[t];
+        minimo = min(minimo, e.bytes);
+        maximo = max(maximo, e.bytes);
+    }
+    cout << "Corpus: " << describirConfiguracionCorpus(config) << endl;
+    cout << entradas.size() << " archivos (" << tipos[CORPUS_TEXTO] << " texto, " << tipos[CORPUS_BINARIO] << " binarios, "
+         << tipos[CORPUS_DISPERSO] << " dispersos), de " << minimo << " a " << maximo << " B" << endl;
+    cout << "Manifiesto: " << salida << (salida.back() == '/' ? "" : "/") << "corpus.manifiesto  (" << fixed << setprecision(3)
+         << segundos << " s)" << endl;
+    return 0;
+}
@@ -12,6 +12,9 @@
  * - F02_encriptacion.h: Proporciona funciones de encriptación y desencriptación de caracteres.
  * - F04_comparar.h: Proporciona la función para comparar cadenas.
  * - F03_sha256.h: Proporciona la clase para generar hashes SHA-256.
+ * - F17_afinidad.h: Proporciona los buffers por hilo, reservados en el nodo NUMA del hilo.
+ * - F22_traza.h: Registra un span por cada operación cuando la traza está activa.
+ * - F27_pool_buffers.h: Proporciona los buffers de los flujos y de trabajo, reutilizados entre procesos.
  *
  * @author badjavii
  * @date 06-23-2025
@@ -23,6 +26,57 @@
 #include "F02_encriptacion.h"
 #include "F04_comparar.h"
 #include "F03_sha256.h"
+#include "F17_afinidad.h"
+#include "F22_traza.h"
+#include "F27_pool_buffers.h"
+#include <sys/stat.h> // para mkdir y stat
+#ifdef _WIN32
+#include <direct.h> // para _mkdir en Windows
+#endif
+
+/**
+ * @def TAMANO_BLOQUE
+ * @brief Tamaño de los bloques en que se recorren los archivos (64 KiB, cabe en la caché L2).
+ */
+
+#define TAMANO_BLOQUE (64 * 1024)
+
+/**
+ * @brief Crea un directorio si todavía no existe.
+ *
+ * Solo crea el último nivel de la ruta; los directorios padres deben existir.
+ *
+ * @param ruta Ruta del directorio a crear.
+ * @return bool true si el directorio existe al terminar, false si no se pudo crear.
+ */
+bool crearDirectorio(const string &ruta)
+{
+    SpanTraza span("crearDirectorio");
+    struct stat info;
+    if (stat(ruta.c_str(), &info) == 0)
+        return (info.st_mode & S_IFDIR) != 0;
+
+#ifdef _WIN32
+    return _mkdir(ruta.c_str()) == 0;
+#else
+    return mkdir(ruta.c_str(), 0755) == 0;
+#endif
+}
+
+/**
+ * @brief Devuelve el tamaño de un archivo en bytes.
+ *
+ * @param ruta Ruta del archivo.
+ * @return long long Tamaño en bytes, o -1 si el archivo no existe.
+ */
+long long devolverTamanoArchivo(const string &ruta)
+{
+    SpanTraza span("devolverTamanoArchivo");
+    struct stat info;
+    if (stat(ruta.c_str(), &info) != 0)
+        return -1;
+    return static_cast<long long>(info.st_size);
+}
 
 /**
  * @brief Genera una copia exacta de un archivo.
@@ -34,8 +88,12 @@
  */
 void generarCopia(const string &archivoEntrada, const string &archivoDestino)
 {
-    ifstream origen(archivoEntrada, ios::binary);  //
-    ofstream destino(archivoDestino, ios::binary); //
+    SpanTraza span("generarCopia");
+    BufferPrestado bufferOrigen(TAMANO_BLOQUE), bufferDestino(TAMANO_BLOQUE); // Deben vivir más que los flujos
+    ifstream origen;
+    ofstream destino;
+    abrirConBuffer(origen, archivoEntrada, ios::binary, bufferOrigen);
+    abrirConBuffer(destino, archivoDestino, ios::binary, bufferDestino);
 
     if (!origen.is_open() || !destino.is_open())
     {
@@ -56,16 +114,20 @@ void generarCopia(const string &archivoEntrada, const string &archivoDestino)
 /**
  * @brief Encripta un archivo y guarda el resultado.
  *
- * Lee el archivo fuente byte por byte, encripta cada carácter usando encriptarCaracter
- * y escribe el resultado en el archivo de salida.
+ * Lee el archivo fuente en bloques de TAMANO_BLOQUE, encripta cada bloque en el lugar con
+ * encriptarBloque (sobre un buffer prestado del pool) y lo escribe en el archivo de salida.
  *
  * @param archivoEntrada Ruta del archivo a encriptar.
  * @param archivoSalida Ruta del archivo encriptado (se sobreescribe si existe).
  */
 void encriptarArchivo(const string &archivoEntrada, const string &archivoSalida)
 {
-    ifstream entrada(archivoEntrada, ios::binary); // Abre el archivo de entrada en modo binario
-    ofstream salida(archivoSalida, ios::binary);   // Abre el archivo de salida en modo binario
+    SpanTraza span("encriptarArchivo");
+    BufferPrestado bufferEntrada(TAMANO_BLOQUE), bufferSalida(TAMANO_BLOQUE);
+    ifstream entrada;
+    ofstream salida;
+    abrirConBuffer(entrada, archivoEntrada, ios::binary, bufferEntrada); // Abre el archivo de entrada en modo binario
+    abrirConBuffer(salida, archivoSalida, ios::binary, bufferSalida);    // Abre el archivo de salida en modo binario
 
     if (!entrada.is_open() || !salida.is_open())
     {
@@ -73,10 +135,12 @@ void encriptarArchivo(const string &archivoEntrada, const string &archivoSalida)
         return;
     }
 
-    char byte;
-    while (entrada.get(byte))
+    BufferPrestado bloque(TAMANO_BLOQUE);
+    while (entrada.read(bloque.datos(), TAMANO_BLOQUE) || entrada.gcount() > 0)
     {
-        salida.put(encriptarCaracter(byte)); // Encripta cada carácter y lo escribe en el archivo de salida
+        size_t leidos = static_cast<size_t>(entrada.gcount());
+        encriptarBloque(bloque.datos(), bloque.datos(), leidos); // Encripta el bloque en el lugar y lo escribe en el archivo de salida
+        salida.write(bloque.datos(), leidos);
     }
 
     entrada.close();
@@ -86,16 +150,20 @@ void encriptarArchivo(const string &archivoEntrada, const string &archivoSalida)
 /**
  * @brief Desencripta un archivo y guarda el resultado.
  *
- * Lee el archivo encriptado byte por byte, desencripta cada carácter usando
- * desencriptarCaracter y escribe el resultado en el archivo de salida.
+ * Lee el archivo encriptado en bloques de TAMANO_BLOQUE, desencripta cada bloque en el lugar
+ * con desencriptarBloque (sobre un buffer prestado del pool) y lo escribe en el archivo de salida.
  *
  * @param archivoEntrada Ruta del archivo encriptado.
  * @param archivoSalida Ruta del archivo desencriptado.
  */
 void desencriptarArchivo(const string &archivoEntrada, const string &archivoSalida)
 {
-    ifstream entrada(archivoEntrada, ios::binary); // Abre el archivo de entrada en modo binario
-    ofstream salida(archivoSalida, ios::binary);   // Abre el archivo de salida en modo binario
+    SpanTraza span("desencriptarArchivo");
+    BufferPrestado bufferEntrada(TAMANO_BLOQUE), bufferSalida(TAMANO_BLOQUE);
+    ifstream entrada;
+    ofstream salida;
+    abrirConBuffer(entrada, archivoEntrada, ios::binary, bufferEntrada); // Abre el archivo de entrada en modo binario
+    abrirConBuffer(salida, archivoSalida, ios::binary, bufferSalida);    // Abre el archivo de salida en modo binario
 
     if (!entrada.is_open() || !salida.is_open())
     {
@@ -103,10 +171,55 @@ void desencriptarArchivo(const string &archivoEntrada, const string &archivoSali
         return;
     }
 
-    char byte;
-    while (entrada.get(byte))
+    BufferPrestado bloque(TAMANO_BLOQUE);
+    while (entrada.read(bloque.datos(), TAMANO_BLOQUE) || entrada.gcount() > 0)
+    {
+        size_t leidos = static_cast<size_t>(entrada.gcount());
+        desencriptarBloque(bloque.datos(), bloque.datos(), leidos); // Desencripta el bloque en el lugar y lo escribe en el archivo de salida
+        salida.write(bloque.datos(), leidos);
+    }
+}
+
+/**
+ * @brief Verifica que desencriptar un archivo reproduce el original, sin escribir el resultado.
+ *
+ * Lee el archivo encriptado y el original en bloques de TAMANO_BLOQUE, desencripta cada bloque
+ * en memoria y lo compara con el bloque correspondiente del original. Termina en cuanto
+ * encuentra la primera diferencia. Equivale a desencriptarArchivo seguido de compararArchivos,
+ * pero sin generar el archivo desencriptado.
+ *
+ * @param archivoEncriptado Ruta del archivo encriptado.
+ * @param archivoOriginal Ruta del archivo original.
+ * @return bool true si el desencriptado es idéntico al original, false en caso contrario.
+ */
+bool verificarDesencriptado(const string &archivoEncriptado, const string &archivoOriginal)
+{
+    SpanTraza span("verificarDesencriptado");
+    BufferPrestado bufferEncriptado(TAMANO_BLOQUE), bufferOriginal(TAMANO_BLOQUE);
+    ifstream encriptado, original;
+    abrirConBuffer(encriptado, archivoEncriptado, ios::binary, bufferEncriptado);
+    abrirConBuffer(original, archivoOriginal, ios::binary, bufferOriginal);
+
+    if (!encriptado.is_open() || !original.is_open())
+        return false; // Si alguno de los archivos no se abre, no se puede verificar
+
+    char *bloqueEncriptado = bufferLocal(0, TAMANO_BLOQUE), *bloqueOriginal = bufferLocal(1, TAMANO_BLOQUE);
+    while (true)
     {
-        salida.put(desencriptarCaracter(byte)); // Desencripta cada carácter y lo escribe en el archivo de salida
+        encriptado.read(bloqueEncriptado, TAMANO_BLOQUE);
+        original.read(bloqueOriginal, TAMANO_BLOQUE);
+        streamsize leidos = encriptado.gcount();
+
+        if (leidos != original.gcount())
+            return false; // Los archivos tienen distinto tamaño
+        if (leidos == 0)
+            return true; // Ambos terminaron a la vez sin diferencias
+
+        for (streamsize j = 0; j < leidos; j++)
+        {
+            if (desencriptarCaracter(bloqueEncriptado[j]) != bloqueOriginal[j])
+                return false; // Primera diferencia: no hace falta seguir leyendo
+        }
     }
 }
 
@@ -121,40 +234,59 @@ void desencriptarArchivo(const string &archivoEntrada, const string &archivoSali
  */
 bool compararArchivos(const string &archivo1, const string &archivo2)
 {
-    ifstream archi1(archivo1);
-    ifstream archi2(archivo2);
+    SpanTraza span("compararArchivos");
+    BufferPrestado buffer1(TAMANO_BLOQUE), buffer2(TAMANO_BLOQUE);
+    ifstream archi1, archi2;
+    abrirConBuffer(archi1, archivo1, ios::in, buffer1);
+    abrirConBuffer(archi2, archivo2, ios::in, buffer2);
 
     if (!archi1.is_open() || !archi2.is_open())
         return false; // Si alguno de los archivos no se abre, no son iguales
 
-    string linea1, linea2;
-    while (getline(archi1, linea1) && getline(archi2, linea2))
+    // getline descarta el salto de línea final; el tamaño distingue "a" de "a\n"
+    if (devolverTamanoArchivo(archivo1) != devolverTamanoArchivo(archivo2))
+        return false;
+
+    thread_local string linea1, linea2; // Conservan su capacidad entre llamadas del mismo hilo
+    while (true)
     {
+        // Se leen siempre las dos líneas, para que ambos archivos avancen a la par
+        bool leida1 = static_cast<bool>(getline(archi1, linea1));
+        bool leida2 = static_cast<bool>(getline(archi2, linea2));
+
+        if (leida1 != leida2)
+            return false; // Un archivo tiene más líneas que el otro
+        if (!leida1)
+            break; // Ambos archivos llegaron al final al mismo tiempo
         if (!compararString(linea1, linea2))
             return false; // Si alguna línea es diferente, los archivos no son iguales
     }
 
-    bool resultado = archi1.eof() && archi2.eof(); // Ambos archivos deben llegar al final al mismo tiempo
     archi1.close();
     archi2.close();
-    return resultado; // Retorna true si ambos archivos son iguales, false en caso contrario
+    return true; // Todas las líneas coinciden
 }
 
 /**
  * @brief Lee el contenido completo de un archivo.
  *
- * Lee el archivo byte por byte y retorna su contenido como una cadena.
+ * Lee el archivo byte por byte y retorna su contenido como una cadena, reservada de una vez
+ * con el tamaño del archivo.
  *
  * @param ruta Ruta del archivo a leer.
  * @return string Contenido del archivo, o cadena vacía si no se puede abrir.
  */
 string devolverContenidoArchivo(const string &ruta)
 {
-    ifstream entrada(ruta, ios::binary); // Abre el archivo de lectura en modo binario para evitar problemas con caracteres especiales
+    SpanTraza span("devolverContenidoArchivo");
+    BufferPrestado buffer(TAMANO_BLOQUE);
+    ifstream entrada;
+    abrirConBuffer(entrada, ruta, ios::binary, buffer); // Abre el archivo de lectura en modo binario para evitar problemas con caracteres especiales
     if (!entrada.is_open())
         return "";
 
     string contenido;
+    contenido.reserve(static_cast<size_t>(max(0LL, devolverTamanoArchivo(ruta))));
     char c;
     while (entrada.get(c))
     {
@@ -168,21 +300,28 @@ string devolverContenidoArchivo(const string &ruta)
 /**
  * @brief Genera el hash SHA-256 de un archivo.
  *
- * Lee el contenido del archivo con devolverContenidoArchivo y genera su hash SHA-256
- * usando sha_return de la clase sha256.
+ * Lee el archivo en bloques de TAMANO_BLOQUE con un buffer prestado y los va sumando al hash
+ * con sha_append, sin cargar el archivo entero en memoria. El resultado es el mismo que
+ * sha_return sobre el contenido completo; un archivo vacío da el hash de la entrada vacía.
  *
  * @param archivo Ruta del archivo a procesar.
- * @return string Hash SHA-256 en formato hexadecimal, o cadena vacía si no se puede leer.
+ * @return string Hash SHA-256 en formato hexadecimal, o cadena vacía si no se puede abrir.
  */
 
 string generarHashArchivo(const string &archivo)
 {
-    string contenido = devolverContenidoArchivo(archivo);
-    if (contenido.empty())
+    SpanTraza span("generarHashArchivo");
+    BufferPrestado bloque(TAMANO_BLOQUE);
+    ifstream entrada;
+    entrada.rdbuf()->pubsetbuf(nullptr, 0); // Lecturas de bloque completo: el flujo no necesita buffer propio
+    entrada.open(archivo, ios::binary);
+    if (!entrada.is_open())
         return "";
 
     sha256 contexto;
-    return contexto.sha_return(contenido);
+    while (entrada.read(bloque.datos(), TAMANO_BLOQUE) || entrada.gcount() > 0)
+        contexto.sha_append(reinterpret_cast<const BYTE *>(bloque.datos()), entrada.gcount());
+    return contexto.sha_digest();
 }
 
 #endif // F01_ARCHIVO_H
\ No newline at end of file
@@ -75,11 +75,30 @@ char encriptarCaracter(char p)
         return encriptarLetra(p);
 }
 
+/**
+ * @brief Encripta un bloque de bytes carácter por carácter.
+ *
+ * Escribe en destino la encriptación de los n bytes de origen. Ambos pueden ser el mismo
+ * buffer, así que sirve para encriptar en el lugar un bloque prestado del pool (F27) sin
+ * reservar memoria.
+ *
+ * @param origen Bytes a encriptar.
+ * @param destino Buffer de al menos n bytes para el resultado (puede ser origen).
+ * @param n Cantidad de bytes.
+ */
+
+void encriptarBloque(const char *origen, char *destino, size_t n)
+{
+    for (size_t j = 0; j < n; j++)
+        destino[j] = encriptarCaracter(origen[j]);
+}
+
 /**
  * @brief Encripta una línea de texto carácter por carácter.
  *
  * Esta función toma una cadena de texto y aplica la función encriptarCaracter
- * a cada uno de sus caracteres, construyendo y devolviendo la línea encriptada.
+ * a cada uno de sus caracteres. Trabaja sobre la propia copia recibida, así que si se le pasa
+ * una cadena temporal (o con move) no reserva memoria.
  *
  * @param linea La línea de texto original que se desea encriptar.
  * @return string La línea encriptada resultante.
@@ -87,12 +106,8 @@ char encriptarCaracter(char p)
 
 string encriptarLinea(string linea)
 {
-    string linea_encriptada = "";
-    for (char letra : linea)
-    {
-        linea_encriptada += encriptarCaracter(letra);
-    }
-    return linea_encriptada;
+    encriptarBloque(linea.data(), &linea[0], linea.size());
+    return linea;
 }
 
 /************************* DESENCRIPTACION ********************************/
@@ -154,11 +169,27 @@ char desencriptarCaracter(char p)
         return desencriptarLetra(p);
 }
 
+/**
+ * @brief Descifra un bloque de bytes carácter por carácter.
+ *
+ * Igual que encriptarBloque: origen y destino pueden ser el mismo buffer.
+ *
+ * @param origen Bytes encriptados.
+ * @param destino Buffer de al menos n bytes para el resultado (puede ser origen).
+ * @param n Cantidad de bytes.
+ */
+
+void desencriptarBloque(const char *origen, char *destino, size_t n)
+{
+    for (size_t j = 0; j < n; j++)
+        destino[j] = desencriptarCaracter(origen[j]);
+}
+
 /**
  * @brief Descifra una línea de texto encriptada carácter por carácter.
  *
  * Esta función toma una cadena de texto encriptada y aplica la función desencriptarCaracter
- * a cada uno de sus caracteres, construyendo y devolviendo la línea descifrada.
+ * a cada uno de sus caracteres, sobre la propia copia recibida (ver encriptarLinea).
  *
  * @param linea La línea de texto encriptada que se desea descifrar.
  * @return string La línea descifrada resultante.
@@ -166,12 +197,8 @@ char desencriptarCaracter(char p)
 
 string desencriptarLinea(string linea)
 {
-    string linea_desencriptada = "";
-    for (char letra : linea)
-    {
-        linea_desencriptada += desencriptarCaracter(letra);
-    }
-    return linea_desencriptada;
+    desencriptarBloque(linea.data(), &linea[0], linea.size());
+    return linea;
 }
 
 #endif // F02_ENCRIPTACION_H
\ No newline at end of file
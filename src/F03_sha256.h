@@ -218,6 +218,22 @@ struct sha256_message
 	WORD state[8];			   // Arreglo para almacenar los ocho registros de estado intermedio (32 bits cada uno).
 };
 
+/**
+ * @brief Convierte bytes en su representación hexadecimal, dos dígitos en minúscula por byte.
+ *
+ * @param[in] datos[] Arreglo de bytes a convertir.
+ * @param[in] len Cantidad de bytes.
+ * @return string Cadena hexadecimal de 2 * len caracteres.
+ */
+
+string bytesAHexadecimal(const BYTE datos[], size_t len)
+{
+	ostringstream oss;
+	for (size_t i = 0; i < len; i++)
+		oss << hex << setw(2) << setfill('0') << (int)datos[i];
+	return oss.str();
+}
+
 /**
  * @class SHA256
  * @brief Clase que implementa el algoritmo de hash SHA-256.
@@ -467,10 +483,47 @@ public:
 		sha_update(reinterpret_cast<const BYTE *>(mensaje.c_str()), mensaje.size());
 		sha_final(hash);
 
-		ostringstream oss;
-		for (int i = 0; i < SHA256_SIZE; i++)
-			oss << hex << setw(2) << setfill('0') << (int)hash[i];
-		return oss.str();
+		return bytesAHexadecimal(hash, SHA256_SIZE);
+	}
+
+	/**
+	 * @brief Reinicia el contexto para calcular un hash por partes.
+	 *
+	 * Junto con sha_append() y sha_digest() permite procesar un mensaje en bloques sin
+	 * tenerlo completo en memoria.
+	 */
+
+	void sha_reset()
+	{
+		sha_init();
+	}
+
+	/**
+	 * @brief Agrega un bloque de datos al hash que se está calculando.
+	 *
+	 * @param[in] data[] Arreglo de bytes con los datos a procesar.
+	 * @param[in] len Tamaño de los datos en bytes.
+	 */
+
+	void sha_append(const BYTE data[], size_t len)
+	{
+		sha_update(data, len);
+	}
+
+	/**
+	 * @brief Finaliza el hash calculado por partes y lo devuelve en hexadecimal.
+	 *
+	 * El resultado es el mismo que daría sha_return() con el mensaje completo.
+	 *
+	 * @return string La representación hexadecimal del hash SHA-256.
+	 */
+
+	string sha_digest()
+	{
+		BYTE hash[SHA256_SIZE];
+		sha_final(hash);
+
+		return bytesAHexadecimal(hash, SHA256_SIZE);
 	}
 };
 
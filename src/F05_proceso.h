@@ -2,37 +2,105 @@
 #define F05_PROCESO_H
 #include "../resources.h"
 #include "F01_archivo.h"
+#include "F10_almacen.h"
+#include "F11_pipeline_fusionado.h"
 
-void proceso(const string rutaTrabajo, int i)
+// Opciones que modifican cómo se ejecuta cada proceso
+struct OpcionesProceso
 {
-    const string archivoOriginal = rutaTrabajo + "original.txt", extensionCopia = ".txt", extensionEncriptado = ".sha", extensionDesencriptado = ".des";
-    string archivoCopia, archivoEncriptado, archivoDesencriptado;
+    AlmacenContenido *almacen = nullptr; // Si no es nulo, reutiliza los .sha/.des de entradas con el mismo contenido
+    bool fusionado = false;              // Recorre el original una sola vez en bloques (F11_pipeline_fusionado.h)
+    TiemposEtapas *tiempos = nullptr;    // Si no es nulo, acumula el tiempo de cada etapa
+    bool soloVerificar = false;          // Pasos 6 y 7 en memoria, sin escribir i.des
+};
+
+// Ejecuta los 7 pasos sobre un archivo cualquiera. Si archivoCopia está vacía no se hace copia
+// y los pasos 2 a 7 trabajan directamente sobre archivoOriginal (así lo usa el modo por lotes).
+// Las salidas se escriben en prefijoSalida + ".sha" y prefijoSalida + ".des".
+ResultadoProceso procesarArchivo(const string &archivoOriginal, const string &archivoCopia, const string &prefijoSalida, const OpcionesProceso &opciones = OpcionesProceso())
+{
+    const string extensionEncriptado = ".sha", extensionDesencriptado = ".des";
+    const string archivoEntrada = archivoCopia.empty() ? archivoOriginal : archivoCopia;
+    const string archivoEncriptado = prefijoSalida + extensionEncriptado, archivoDesencriptado = prefijoSalida + extensionDesencriptado;
     string hash1, hash2;
-    bool resultadoComparacion;
+    ResultadoProceso resultado;
+    AlmacenContenido *almacen = opciones.almacen;
+    TiemposEtapas *tiempos = opciones.tiempos;
+    CronometroProceso medicion(tiempos);
 
-    // 1- Copiar el archivo original.txt en i.txt
-    archivoCopia = rutaTrabajo + to_string(i) + extensionCopia;
-    generarCopia(archivoOriginal, archivoCopia);
+    // Pasos 1 a 7 en un solo recorrido del original
+    if (opciones.fusionado)
+        return procesoFusionado(archivoOriginal, archivoCopia, archivoEncriptado, opciones.soloVerificar ? "" : archivoDesencriptado, tiempos);
 
-    // 2- Encriptar i.txt y guardar el resultado en i.sha
-    archivoEncriptado = rutaTrabajo + to_string(i) + extensionEncriptado;
-    encriptarArchivo(archivoCopia, archivoEncriptado);
+    // 1- Copiar el archivo original en la copia
+    if (!archivoCopia.empty())
+    {
+        CronometroEtapa c(tiempos, ETAPA_COPIA);
+        generarCopia(archivoOriginal, archivoCopia);
+    }
 
-    // 3- Generar el hash SHA-256 de i.txt
-    hash1 = generarHashArchivo(archivoCopia);
+    // 3- Generar el hash SHA-256 de la copia (antes de encriptar: es la clave del almacén)
+    {
+        CronometroEtapa c(tiempos, ETAPA_HASH);
+        hash1 = generarHashArchivo(archivoEntrada);
+    }
+    resultado.hash = hash1;
 
-    // 4- Generar otro hash SHA-256 de i.txt
-    hash2 = generarHashArchivo(archivoCopia);
+    // 2- Encriptar la copia y guardar el resultado en el .sha
+    if (almacen == nullptr || !almacen->materializar(hash1, TRANSFORMACION_ENCRIPTAR, archivoEncriptado))
+    {
+        CronometroEtapa c(tiempos, ETAPA_ENCRIPTAR);
+        encriptarArchivo(archivoEntrada, archivoEncriptado);
+        if (almacen != nullptr)
+            almacen->publicar(hash1, TRANSFORMACION_ENCRIPTAR, archivoEncriptado);
+    }
+
+    // 4- Generar otro hash SHA-256 de la copia
+    {
+        CronometroEtapa c(tiempos, ETAPA_HASH);
+        hash2 = generarHashArchivo(archivoEntrada);
+    }
 
     // 5- Comparar los hashes
-    resultadoComparacion = compararString(hash1, hash2);
+    resultado.hashesIguales = compararString(hash1, hash2);
+
+    // 6 y 7- Desencriptar el .sha en memoria y compararlo con el original, sin generar el .des
+    if (opciones.soloVerificar)
+    {
+        CronometroEtapa c(tiempos, ETAPA_COMPARAR);
+        resultado.contenidoIgual = verificarDesencriptado(archivoEncriptado, archivoOriginal);
+        if (tiempos != nullptr)
+            tiempos->bytes += devolverTamanoArchivo(archivoOriginal);
+        return resultado;
+    }
 
-    // 6- Desencriptar i.sha en otro archivo i.des
-    archivoDesencriptado = rutaTrabajo + to_string(i) + extensionDesencriptado;
-    desencriptarArchivo(archivoEncriptado, archivoDesencriptado);
+    // 6- Desencriptar el .sha en el .des
+    if (almacen == nullptr || !almacen->materializar(hash1, TRANSFORMACION_DESENCRIPTAR, archivoDesencriptado))
+    {
+        CronometroEtapa c(tiempos, ETAPA_DESENCRIPTAR);
+        desencriptarArchivo(archivoEncriptado, archivoDesencriptado);
+        if (almacen != nullptr)
+            almacen->publicar(hash1, TRANSFORMACION_DESENCRIPTAR, archivoDesencriptado);
+    }
 
-    // 7- Comparar el contenido de i.des con original.txt
-    resultadoComparacion = compararArchivos(archivoDesencriptado, archivoOriginal);
+    // 7- Comparar el contenido del .des con el original
+    {
+        CronometroEtapa c(tiempos, ETAPA_COMPARAR);
+        resultado.contenidoIgual = compararArchivos(archivoDesencriptado, archivoOriginal);
+    }
+
+    if (tiempos != nullptr)
+        tiempos->bytes += devolverTamanoArchivo(archivoOriginal);
+    return resultado;
+}
+
+// Proceso i de los modos secuencial y paralelo: original.txt -> i.txt -> i.sha -> i.des
+ResultadoProceso proceso(const string rutaTrabajo, int i, const OpcionesProceso &opciones = OpcionesProceso())
+{
+    const string archivoOriginal = rutaTrabajo + "original.txt", extensionCopia = ".txt";
+    string archivoCopia = rutaTrabajo + to_string(i) + extensionCopia;
+    SpanTraza span("proceso", i);
+    return procesarArchivo(archivoOriginal, archivoCopia, rutaTrabajo + to_string(i), opciones);
 }
 
-#endif // F05_PROCESO_H
\ No newline at end of file
+#endif // F05_PROCESO_H
@@ -7,7 +7,7 @@
 #include "F05_proceso.h"
 #include "F08_temporizador.h"
 
-Temporizador mainSecuencial(int copias)
+Temporizador mainSecuencial(int copias, const OpcionesProceso &opciones = OpcionesProceso())
 {
     cout << endl;
 
@@ -23,7 +23,7 @@ Temporizador mainSecuencial(int copias)
 
     for (int i = 1; i <= copias; i++)
     {
-        proceso(rutaTrabajo, i);
+        proceso(rutaTrabajo, i, opciones);
         temporizador_principal.registrar();
         string duracion = temporizador_principal.duracionEntre(i - 1, i);
         if (i < 10)
@@ -46,6 +46,10 @@ Temporizador mainSecuencial(int copias)
     cout << "Tiempo Total:       " << temporizador_principal.tiempoTranscurrido() << endl;
     cout << "Tiempo promedio:    " << temporizador_principal.promedioPorProceso() << endl;
     cout << "================================" << endl;
+    if (opciones.almacen != nullptr)
+        cout << opciones.almacen->resumen() << endl;
+    if (opciones.tiempos != nullptr)
+        cout << opciones.tiempos->resumen(temporizador_principal.duracionSegundos()) << endl;
     return temporizador_principal;
 }
 
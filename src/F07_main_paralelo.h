@@ -6,51 +6,87 @@
 #include "F04_comparar.h"
 #include "F05_proceso.h"
 #include "F08_temporizador.h"
+#include "F14_pool_hilos.h"
+#include "F16_registro_hilos.h"
+#include "F19_control_concurrencia.h"
 
 const string rutaTrabajo = "file_workspace_parallel/";
 
-// Función que crea y devuelve un hilo para ejecutar un proceso
-thread crearHiloDeProceso(int id, Temporizador &temporizador, mutex &mutex_temporizador, vector<pair<int, string>> &tiempos_terminados)
+// Ejecuta el proceso id y guarda su inicio y fin en el buffer del hilo (sin bloqueos)
+ResultadoProceso ejecutarYRegistrar(int id, int hilo, RegistroPorHilo &registro, const OpcionesProceso &opciones)
 {
-    return thread([id, &temporizador, &mutex_temporizador, &tiempos_terminados]()
-                  {
-        // Ejecutar el proceso correspondiente
-        proceso(rutaTrabajo, id);
-
-        // Proteger acceso compartido
-        lock_guard<mutex> lock(mutex_temporizador);
-
-        // Registrar el tiempo de finalización del proceso
-        temporizador.registrar();
-
-        // Calcular la duración entre la última marca y la anterior
-        int n = static_cast<int>(temporizador.getRegistro().size());
-        if (n >= 2) {
-            string duracion = temporizador.duracionEntre(n - 2, n - 1);
-            tiempos_terminados.push_back({id, duracion});
-        } });
+    auto inicio = chrono::steady_clock::now();
+    ResultadoProceso resultado = proceso(rutaTrabajo, id, opciones);
+    registro.registrar(hilo, id, inicio, chrono::steady_clock::now(), resultado.hashesIguales && resultado.contenidoIgual);
+    return resultado;
 }
 
-Temporizador mainParalelo(int copias)
+void mostrarInicioParalelo(const Temporizador &temporizador_principal)
 {
+    cout << "================================" << endl;
+    cout << "    INICIO PROCESO PARALELO     " << endl;
+    cout << "================================" << endl;
+    cout << "Tiempo Inicial:     " << temporizador_principal.formatoTextoInicio() << endl;
+    cout << "================================" << endl;
     cout << endl;
+}
 
-    Temporizador temporizador_principal;
-    mutex mutex_temporizador;
+void mostrarFinParalelo(const Temporizador &temporizador_principal, const RegistroPorHilo &registro, const OpcionesProceso &opciones)
+{
+    vector<RegistroProceso> registros = registro.combinar();
+    double total = 0.0;
+    size_t correctos = 0;
+
+    // Mostrar la duración real de cada proceso, en el orden en que terminaron
+    for (const auto &r : registros)
+    {
+        cout << "TIEMPO PROCESO " << r.id << ": ";
+        if (r.id < 10)
+            cout << " ";
+        cout << temporizador_principal.formatoSegundos(r.segundos()) << endl;
+        cout << "--------------------------------" << endl;
+        total += r.segundos();
+        correctos += r.correcto;
+    }
+    double promedio = registros.empty() ? 0.0 : total / registros.size();
 
     cout << "================================" << endl;
-    cout << "    INICIO PROCESO PARALELO     " << endl;
+    cout << "      FIN PROCESO PARALELO      " << endl;
     cout << "================================" << endl;
-    cout << "Tiempo Inicial:     " << temporizador_principal.formatoTextoInicio() << endl;
+    cout << "Tiempo Final:       " << temporizador_principal.formatoTextoFin() << endl;
+    cout << "Tiempo Total:       " << temporizador_principal.tiempoTranscurrido() << endl;
+    cout << "Tiempo promedio:    " << temporizador_principal.formatoSegundos(promedio) << endl;
+    cout << "Procesos correctos: " << correctos << "/" << registros.size() << endl;
     cout << "================================" << endl;
+    if (opciones.almacen != nullptr)
+        cout << opciones.almacen->resumen() << endl;
+    if (opciones.tiempos != nullptr)
+        cout << opciones.tiempos->resumen(temporizador_principal.duracionSegundos()) << endl;
+}
+
+// Función que crea y devuelve un hilo para ejecutar un proceso (el hilo id usa el buffer id - 1)
+thread crearHiloDeProceso(int id, RegistroPorHilo &registro, const OpcionesProceso &opciones)
+{
+    return thread([id, &registro, &opciones]()
+                  { ejecutarYRegistrar(id, id - 1, registro, opciones); });
+}
+
+// Modelo original: un hilo por copia (se conserva para comparar el escalado con el pool)
+Temporizador mainParaleloHiloPorCopia(int copias, const OpcionesProceso &opciones = OpcionesProceso())
+{
     cout << endl;
 
+    Temporizador temporizador_principal;
+    RegistroPorHilo registro(copias);
+    registro.reservar(1);
+
+    mostrarInicioParalelo(temporizador_principal);
+
     vector<thread> hilos;
-    vector<pair<int, string>> tiempos_terminados;
 
     for (int i = 1; i <= copias; ++i)
     {
-        thread hilo = crearHiloDeProceso(i, temporizador_principal, mutex_temporizador, tiempos_terminados);
+        thread hilo = crearHiloDeProceso(i, registro, opciones);
         hilos.push_back(move(hilo));
     }
 
@@ -61,27 +97,62 @@ Temporizador mainParalelo(int copias)
     }
 
     temporizador_principal.detener();
+    mostrarFinParalelo(temporizador_principal, registro, opciones);
+    return temporizador_principal;
+}
 
-    // Mostrar los tiempos en el orden en que terminaron los procesos
-    for (const auto &par : tiempos_terminados)
-    {
-        int id = par.first;
-        const string &duracion = par.second;
+// Ejecuta las copias en un pool de numHilos hilos (0 = núcleos disponibles) con cola acotada.
+// Con colocacion, cada hilo se fija a su CPU al arrancar y sus buffers quedan en su nodo NUMA.
+// Con control, el pool se crea con control->maximo hilos y un controlador decide cuántos trabajan,
+// empezando por numHilos.
+Temporizador mainParalelo(int copias, const OpcionesProceso &opciones = OpcionesProceso(), int numHilos = 0, const ColocacionHilos *colocacion = nullptr,
+                          const ConfiguracionControl *control = nullptr)
+{
+    cout << endl;
 
-        cout << "TIEMPO PROCESO " << id << ": ";
-        if (id < 10)
-            cout << " ";
-        cout << duracion << endl;
-        cout << "--------------------------------" << endl;
+    Temporizador temporizador_principal;
+
+    mostrarInicioParalelo(temporizador_principal);
+
+    function<void(int)> alIniciar;
+    if (colocacion != nullptr)
+        alIniciar = [colocacion](int indice)
+        { colocacion->aplicar(indice); };
+
+    int hilosIniciales = numHilos > 0 ? numHilos : max(1u, thread::hardware_concurrency());
+    int hilosPool = numHilos;
+    if (control != nullptr)
+        hilosPool = control->maximo > 0 ? control->maximo : 2 * max(1u, thread::hardware_concurrency());
+
+    PoolHilos pool(hilosPool, 0, alIniciar);
+    RegistroPorHilo registro(pool.numeroHilos());
+    registro.reservar(copias / pool.numeroHilos() + 1);
+    cout << "Hilos del pool:     " << pool.numeroHilos() << endl;
+    if (colocacion != nullptr)
+        cout << colocacion->describir(pool.numeroHilos());
+    cout << "--------------------------------" << endl;
+
+    unique_ptr<ControladorConcurrencia> controlador;
+    if (control != nullptr)
+        controlador.reset(new ControladorConcurrencia(pool, *control, hilosIniciales));
+
+    for (int i = 1; i <= copias; ++i)
+    {
+        // enviar() bloquea mientras la cola está llena: nunca hay más de unos pocos procesos en espera
+        pool.enviar([i, &registro, &opciones]
+                    { return ejecutarYRegistrar(i, PoolHilos::hiloActual(), registro, opciones); },
+                    [](const ResultadoProceso &) {});
     }
 
-    cout << "================================" << endl;
-    cout << "      FIN PROCESO PARALELO      " << endl;
-    cout << "================================" << endl;
-    cout << "Tiempo Final:       " << temporizador_principal.formatoTextoFin() << endl;
-    cout << "Tiempo Total:       " << temporizador_principal.tiempoTranscurrido() << endl;
-    cout << "Tiempo promedio:    " << temporizador_principal.promedioPorProceso() << endl;
-    cout << "================================" << endl;
+    pool.esperarTodo();
+
+    temporizador_principal.detener();
+    mostrarFinParalelo(temporizador_principal, registro, opciones);
+    if (controlador)
+    {
+        controlador->detener();
+        cout << controlador->resumen();
+    }
     return temporizador_principal;
 }
 
@@ -15,10 +15,9 @@ private:
     bool detenido;
     vector<Hora> registro;
 
+    // Las duraciones salen de steady_clock: nunca son negativas ni dependen de la medianoche
     string formatearDuracion(double t) const
     {
-        if (t < 0)
-            t += 86400.0;
         int h = static_cast<int>(t / 3600);
         t -= h * 3600;
         int m = static_cast<int>(t / 60);
@@ -67,8 +66,7 @@ public:
     {
         if (i >= 0 && j < static_cast<int>(registro.size()) && i < j)
         {
-            double t = registro[j].tiempoEnSegundos() - registro[i].tiempoEnSegundos();
-            return formatearDuracion(t);
+            return formatearDuracion(registro[j].nanosegundosDesde(registro[i]) / 1e9);
         }
         return "00:00:00:000";
     }
@@ -111,26 +109,40 @@ public:
         double total = 0.0;
         for (int i = 1; i < n - 1; ++i)
         {
-            double t = registro[i].tiempoEnSegundos() - registro[i - 1].tiempoEnSegundos();
-            total += t;
+            total += registro[i].nanosegundosDesde(registro[i - 1]) / 1e9;
         }
 
         double promedio = total / (n - 2);
         return formatearDuracion(promedio);
     }
 
-    double duracionSegundos() const
+    string formatoSegundos(double t) const
+    {
+        return formatearDuracion(t);
+    }
+
+    string formatoTextoDuracion() const
+    {
+        return formatearDuracion(duracionSegundos());
+    }
+
+    long long duracionNanosegundos() const
     {
         if (detenido)
         {
-            return fin.tiempoEnSegundos() - inicio.tiempoEnSegundos();
+            return fin.nanosegundosDesde(inicio);
         }
         else
         {
             Hora ahora = Hora();
-            return ahora.tiempoEnSegundos() - inicio.tiempoEnSegundos();
+            return ahora.nanosegundosDesde(inicio);
         }
     }
+
+    double duracionSegundos() const
+    {
+        return duracionNanosegundos() / 1e9;
+    }
 };
 
 #endif
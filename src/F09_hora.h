@@ -6,9 +6,11 @@ class Hora
 {
 private:
     int horas, minutos, segundos, milisegundos;
+    chrono::steady_clock::time_point instante; // Reloj monotónico: el único que se usa para medir
 
     void capturarTiempoActual()
     {
+        instante = chrono::steady_clock::now();
         auto ahora = chrono::system_clock::now();
         auto time_t_ahora = chrono::system_clock::to_time_t(ahora);
         auto tm = *localtime(&time_t_ahora);
@@ -36,10 +38,22 @@ public:
         return oss.str();
     }
 
+    // Hora del día en segundos (reloj de pared): solo para mostrar, no sirve para medir duraciones
     double tiempoEnSegundos() const
     {
         return horas * 3600.0 + minutos * 60.0 + segundos + milisegundos / 1000.0;
     }
+
+    chrono::steady_clock::time_point getInstante() const
+    {
+        return instante;
+    }
+
+    // Nanosegundos transcurridos desde otra Hora, según el reloj monotónico
+    long long nanosegundosDesde(const Hora &anterior) const
+    {
+        return chrono::duration_cast<chrono::nanoseconds>(instante - anterior.instante).count();
+    }
 };
 
 #endif
@@ -0,0 +1,303 @@
+/**
+ * @file F10_almacen.h
+ * @brief Almacén de resultados direccionado por contenido.
+ *
+ * Guarda una sola vez cada archivo generado por el pipeline (.sha y .des), indexado por el
+ * hash SHA-256 del archivo de entrada y el tipo de transformación aplicada. Si otro proceso
+ * recibe una entrada con el mismo contenido, el archivo de salida se materializa desde el
+ * almacén (reflink, enlace duro o copy_file_range) en lugar de volver a calcularse.
+ *
+ * Como la clave es el contenido y no el nombre del archivo, funciona tanto para las N copias
+ * de original.txt como para archivos duplicados cualesquiera dentro de un lote.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F01_archivo.h: Proporciona generarCopia (respaldo portátil) y crearDirectorio.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F10_ALMACEN_H
+#define F10_ALMACEN_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F01_archivo.h"
+#include <atomic>
+#include <condition_variable>
+#include <set>
+#include <cstdio> // para rename y remove
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h> // para FICLONE
+#endif
+
+/**
+ * @enum Transformacion
+ * @brief Tipo de archivo derivado que se guarda en el almacén.
+ *
+ * Ambas transformaciones se indexan con el hash de la copia de entrada: el .des es la
+ * desencriptación del .sha de esa misma entrada, por lo que también depende solo de ella.
+ */
+
+enum Transformacion
+{
+    TRANSFORMACION_ENCRIPTAR,   // Resultado de encriptarArchivo (archivo .sha).
+    TRANSFORMACION_DESENCRIPTAR // Resultado de desencriptar el .sha (archivo .des).
+};
+
+/**
+ * @enum Materializacion
+ * @brief Mecanismo con el que se obtuvo un archivo de salida desde el almacén.
+ */
+
+enum Materializacion
+{
+    MATERIALIZACION_NINGUNA, // No se pudo materializar.
+    MATERIALIZACION_REFLINK, // Clonado copy-on-write (ioctl FICLONE).
+    MATERIALIZACION_ENLACE,  // Enlace duro al archivo del almacén.
+    MATERIALIZACION_KERNEL,  // Copia dentro del kernel con copy_file_range.
+    MATERIALIZACION_COPIA    // Copia convencional con flujos de C++.
+};
+
+/**
+ * @enum ConsultaAlmacen
+ * @brief Resultado de buscar una salida en el almacén sin esperar.
+ */
+
+enum ConsultaAlmacen
+{
+    CONSULTA_ACIERTO,  // La salida se materializó desde el almacén.
+    CONSULTA_CALCULAR, // No está: el llamador debe calcularla y llamar a publicar().
+    CONSULTA_OCUPADA   // Otro proceso la está calculando; hay que volver a consultar más tarde.
+};
+
+/**
+ * @brief Copia un archivo usando el mecanismo más barato disponible.
+ *
+ * El destino se elimina antes de crearse de nuevo, de forma que nunca se escribe sobre un
+ * inodo compartido con el almacén. El orden de preferencia es: enlace duro (si se permite),
+ * reflink, copy_file_range y, como último recurso, generarCopia.
+ *
+ * @param origen Ruta del archivo a clonar.
+ * @param destino Ruta del archivo a crear.
+ * @param permitirEnlace Si es true se intenta primero un enlace duro.
+ * @return Materializacion Mecanismo utilizado, o MATERIALIZACION_NINGUNA si falló.
+ */
+
+Materializacion clonarArchivo(const string &origen, const string &destino, bool permitirEnlace)
+{
+#ifdef __linux__
+    unlink(destino.c_str());
+
+    if (permitirEnlace && link(origen.c_str(), destino.c_str()) == 0)
+        return MATERIALIZACION_ENLACE;
+
+    int fdOrigen = open(origen.c_str(), O_RDONLY);
+    if (fdOrigen < 0)
+        return MATERIALIZACION_NINGUNA;
+
+    int fdDestino = open(destino.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fdDestino < 0)
+    {
+        close(fdOrigen);
+        return MATERIALIZACION_NINGUNA;
+    }
+
+    Materializacion resultado = MATERIALIZACION_NINGUNA;
+
+#ifdef FICLONE
+    if (ioctl(fdDestino, FICLONE, fdOrigen) == 0)
+        resultado = MATERIALIZACION_REFLINK;
+#endif
+
+    if (resultado == MATERIALIZACION_NINGUNA)
+    {
+        struct stat info;
+        if (fstat(fdOrigen, &info) == 0)
+        {
+            off_t restante = info.st_size;
+            while (restante > 0)
+            {
+                ssize_t copiados = copy_file_range(fdOrigen, nullptr, fdDestino, nullptr, restante, 0);
+                if (copiados <= 0)
+                    break;
+                restante -= copiados;
+            }
+            if (restante == 0)
+                resultado = MATERIALIZACION_KERNEL;
+        }
+    }
+
+    close(fdOrigen);
+    close(fdDestino);
+
+    if (resultado != MATERIALIZACION_NINGUNA)
+        return resultado;
+#else
+    (void)permitirEnlace;
+#endif
+
+    // Respaldo portátil (sistemas sin copy_file_range, o sistemas de archivos distintos).
+    // generarCopia no informa de errores: se da por buena solo si el destino quedó completo.
+    generarCopia(origen, destino);
+    struct stat infoOrigen, infoDestino;
+    if (stat(origen.c_str(), &infoOrigen) != 0 || stat(destino.c_str(), &infoDestino) != 0 || infoOrigen.st_size != infoDestino.st_size)
+        return MATERIALIZACION_NINGUNA;
+    return MATERIALIZACION_COPIA;
+}
+
+/**
+ * @class AlmacenContenido
+ * @brief Almacén de archivos derivados direccionado por el contenido de la entrada.
+ *
+ * Cada entrada vive en rutaAlmacen con el nombre "<hash>.<sha|des>". Las publicaciones se
+ * escriben primero en un archivo temporal y luego se renombran, así que varios hilos pueden
+ * publicar y materializar a la vez sin ver entradas a medio escribir.
+ *
+ * Si varios hilos piden la misma clave a la vez, solo el primero la calcula; el resto espera
+ * a que se publique y la materializa (así el modo paralelo también se beneficia).
+ */
+
+class AlmacenContenido
+{
+private:
+    string rutaAlmacen;
+    bool permitirEnlaces;
+    atomic<int> aciertos;
+    atomic<int> fallos;
+    atomic<int> porMecanismo[5];
+    atomic<int> temporales;
+    mutex mutex_almacen;
+    condition_variable publicada;
+    set<string> enCurso; // Claves que algún hilo está calculando en este momento
+
+    string nombreEntrada(const string &hash, Transformacion t) const
+    {
+        return rutaAlmacen + hash + (t == TRANSFORMACION_ENCRIPTAR ? ".sha" : ".des");
+    }
+
+    ConsultaAlmacen consultar(const string &hash, Transformacion t, const string &destino, bool esperar)
+    {
+        if (hash.empty())
+            return CONSULTA_CALCULAR;
+
+        string entrada = nombreEntrada(hash, t);
+        struct stat info;
+        {
+            unique_lock<mutex> lock(mutex_almacen);
+            if (!esperar && enCurso.count(entrada) != 0)
+                return CONSULTA_OCUPADA;
+            publicada.wait(lock, [&]
+                           { return enCurso.count(entrada) == 0; });
+
+            if (stat(entrada.c_str(), &info) != 0)
+            {
+                enCurso.insert(entrada);
+                fallos++;
+                return CONSULTA_CALCULAR;
+            }
+        }
+
+        Materializacion m = clonarArchivo(entrada, destino, permitirEnlaces);
+        if (m == MATERIALIZACION_NINGUNA)
+        {
+            fallos++;
+            return CONSULTA_CALCULAR;
+        }
+
+        aciertos++;
+        porMecanismo[m]++;
+        return CONSULTA_ACIERTO;
+    }
+
+public:
+    /**
+     * @brief Crea (si hace falta) el directorio del almacén.
+     *
+     * @param ruta Directorio donde se guardan las entradas; debe terminar en '/'.
+     * @param enlaces Si es true, las salidas se materializan como enlaces duros. Solo es seguro
+     *                cuando nadie reescribe los archivos de salida en el lugar.
+     */
+    AlmacenContenido(const string &ruta, bool enlaces = false)
+        : rutaAlmacen(ruta), permitirEnlaces(enlaces), aciertos(0), fallos(0), temporales(0)
+    {
+        for (auto &contador : porMecanismo)
+            contador = 0;
+        crearDirectorio(rutaAlmacen);
+    }
+
+    /**
+     * @brief Materializa en destino la salida guardada para (hash, t), si existe.
+     *
+     * Si devuelve false con un hash no vacío, el llamador queda a cargo de calcular la salida
+     * y debe llamar a publicar() con la misma clave (aunque el cálculo falle).
+     *
+     * @param hash Hash SHA-256 (hexadecimal) de la entrada.
+     * @param t Transformación buscada.
+     * @param destino Ruta del archivo de salida a crear.
+     * @return bool true si la salida se obtuvo del almacén, false si hay que calcularla.
+     */
+    bool materializar(const string &hash, Transformacion t, const string &destino)
+    {
+        return consultar(hash, t, destino, true) == CONSULTA_ACIERTO;
+    }
+
+    /**
+     * @brief Igual que materializar(), pero sin bloquear si otro proceso calcula la misma clave.
+     *
+     * Pensada para llamadores que no pueden esperar en una variable de condición (corrutinas):
+     * con CONSULTA_OCUPADA no se reserva nada y basta con volver a consultar más tarde.
+     */
+    ConsultaAlmacen intentarMaterializar(const string &hash, Transformacion t, const string &destino)
+    {
+        return consultar(hash, t, destino, false);
+    }
+
+    /**
+     * @brief Guarda en el almacén un archivo recién calculado.
+     *
+     * @param hash Hash SHA-256 (hexadecimal) de la entrada que lo produjo.
+     * @param t Transformación que produjo el archivo.
+     * @param archivoGenerado Ruta del archivo de salida calculado.
+     */
+    void publicar(const string &hash, Transformacion t, const string &archivoGenerado)
+    {
+        if (hash.empty())
+            return;
+
+        string entrada = nombreEntrada(hash, t);
+        string temporal = entrada + ".tmp" + to_string(temporales++);
+
+        // Nunca se enlaza el archivo generado: el pipeline podría reescribirlo más tarde
+        if (clonarArchivo(archivoGenerado, temporal, false) == MATERIALIZACION_NINGUNA ||
+            rename(temporal.c_str(), entrada.c_str()) != 0)
+        {
+            remove(temporal.c_str());
+        }
+
+        lock_guard<mutex> lock(mutex_almacen);
+        enCurso.erase(entrada);
+        publicada.notify_all();
+    }
+
+    int getAciertos() const { return aciertos; }
+    int getFallos() const { return fallos; }
+
+    /**
+     * @brief Texto con el resumen de uso del almacén.
+     */
+    string resumen() const
+    {
+        ostringstream oss;
+        oss << "Almacen: " << aciertos << " aciertos, " << fallos << " fallos"
+            << " (reflink " << porMecanismo[MATERIALIZACION_REFLINK]
+            << ", enlace " << porMecanismo[MATERIALIZACION_ENLACE]
+            << ", kernel " << porMecanismo[MATERIALIZACION_KERNEL]
+            << ", copia " << porMecanismo[MATERIALIZACION_COPIA] << ")";
+        return oss.str();
+    }
+};
+
+#endif // F10_ALMACEN_H
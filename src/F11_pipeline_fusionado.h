@@ -0,0 +1,616 @@
+/**
+ * @file F11_pipeline_fusionado.h
+ * @brief Pipeline de un solo recorrido para el proceso de cada copia.
+ *
+ * El proceso normal (F05_proceso.h) encadena siete pasos de archivo a archivo y vuelve a leer
+ * del disco lo que el paso anterior acaba de escribir. Esta versión lee original.txt una sola
+ * vez en bloques y, mientras cada bloque sigue en caché, escribe la copia, lo encripta, calcula
+ * los hashes, lo desencripta en memoria y lo compara con el bloque original.
+ *
+ * Los archivos generados (N.txt, N.sha y N.des) y los resultados de las comparaciones son los
+ * mismos que en el proceso normal. El tiempo de cada etapa se acumula en TiemposEtapas.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F01_archivo.h: Proporciona TAMANO_BLOQUE y, a través de F02/F03, el cifrado y el hash por partes.
+ * - F20_ciclos.h: Proporciona el contador de ciclos para medir ciclos por byte de cada etapa.
+ * - F21_histograma.h: Proporciona los histogramas de latencia de cada etapa y de cada proceso.
+ * - F23_contadores.h: Proporciona los contadores de rendimiento del procesador por hilo.
+ * - F26_memoria.h: Proporciona la contabilidad de reservas de memoria por hilo.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F11_PIPELINE_FUSIONADO_H
+#define F11_PIPELINE_FUSIONADO_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F01_archivo.h"
+#include "F20_ciclos.h"
+#include "F21_histograma.h"
+#include "F23_contadores.h"
+#include "F26_memoria.h"
+#include <atomic>
+
+/**
+ * @enum Etapa
+ * @brief Etapas del pipeline cuyo tiempo se mide por separado.
+ */
+
+enum Etapa
+{
+    ETAPA_LECTURA,      // Lectura de original.txt.
+    ETAPA_COPIA,        // Escritura de N.txt.
+    ETAPA_ENCRIPTAR,    // Cifrado del bloque.
+    ETAPA_HASH,         // Cálculo de los hashes SHA-256.
+    ETAPA_DESENCRIPTAR, // Descifrado del bloque cifrado.
+    ETAPA_COMPARAR,     // Comparación con el bloque original.
+    ETAPA_ESCRITURA,    // Escritura de N.sha y N.des.
+    NUM_ETAPAS
+};
+
+const char *nombresEtapas[NUM_ETAPAS] = {"Lectura", "Copia", "Encriptar", "Hash", "Desencriptar", "Comparar", "Escritura"};
+
+/**
+ * @struct TiemposEtapas
+ * @brief Tiempo acumulado por etapa, compartido por todos los procesos de una ejecución.
+ *
+ * Los contadores son atómicos para que varios hilos puedan sumar sin un mutex. Con medirCiclos
+ * también se acumulan ciclos del contador de F20_ciclos.h (hay que llamar antes a calibrarCiclos).
+ * Además de los totales, cada medida de una etapa y la duración de cada proceso completo se
+ * registran en histogramas de latencia para poder dar percentiles. Con medirContadores se
+ * acumulan también los contadores de rendimiento de F23_contadores.h de cada etapa, y con
+ * medirMemoria (requiere activarRastreoMemoria) los bytes reservados, las reservas y el pico de
+ * memoria de cada etapa y de cada proceso.
+ */
+
+struct TiemposEtapas
+{
+    atomic<long long> nanosegundos[NUM_ETAPAS];
+    atomic<long long> ciclos[NUM_ETAPAS];
+    atomic<long long> contadores[NUM_ETAPAS][NUM_CONTADORES];
+    atomic<long long> bytes;
+    atomic<long long> memoriaBytes[NUM_ETAPAS];        // Bytes reservados con new
+    atomic<long long> memoriaAsignaciones[NUM_ETAPAS]; // Llamadas a new
+    atomic<long long> memoriaPico[NUM_ETAPAS];         // Mayor pico de bytes vivos en una medida
+    atomic<long long> memoriaProcesos, bytesProcesos, asignacionesProcesos, picoProceso;
+    atomic<long long> residenteMaximaKiB; // Mayor VmRSS leído al terminar un proceso
+    atomic<int> contadoresDisponibles;    // Máscara de los contadores que abrieron los hilos que midieron
+    bool medirCiclos;
+    bool medirContadores;
+    bool medirMemoria;
+    HistogramaLatencia latencias[NUM_ETAPAS]; // Una muestra por cada medida de la etapa
+    HistogramaLatencia procesos;              // Una muestra por proceso completo
+
+    TiemposEtapas()
+    {
+        medirCiclos = medirContadores = medirMemoria = false;
+        reiniciar();
+    }
+
+    /**
+     * @brief Pone a cero todas las medidas (no cambia qué se mide).
+     *
+     * El banco de pruebas la llama al terminar el calentamiento. No se debe llamar mientras
+     * algún proceso está midiendo.
+     */
+    void reiniciar()
+    {
+        for (int e = 0; e < NUM_ETAPAS; e++)
+        {
+            nanosegundos[e] = ciclos[e] = 0;
+            for (auto &c : contadores[e])
+                c = 0;
+            memoriaBytes[e] = memoriaAsignaciones[e] = memoriaPico[e] = 0;
+        }
+        bytes = 0;
+        memoriaProcesos = bytesProcesos = asignacionesProcesos = picoProceso = residenteMaximaKiB = 0;
+        contadoresDisponibles = 0;
+        for (auto &l : latencias)
+            l.reiniciar();
+        procesos.reiniciar();
+    }
+
+    /**
+     * @brief Texto con el tiempo total de cada etapa, su porcentaje y los percentiles de latencia.
+     *
+     * @param segundos Duración de la ejecución, para el rendimiento (0 = no mostrarlo).
+     */
+    string resumen(double segundos = 0.0) const
+    {
+        long long total = 0;
+        for (const auto &t : nanosegundos)
+            total += t;
+
+        ostringstream oss;
+        oss << fixed << setprecision(3);
+        for (int e = 0; e < NUM_ETAPAS; e++)
+        {
+            double ms = nanosegundos[e] / 1e6;
+            double porcentaje = total > 0 ? 100.0 * nanosegundos[e] / total : 0.0;
+            oss << "Etapa " << left << setw(13) << nombresEtapas[e] << right
+                << setw(10) << ms << " ms  (" << setprecision(1) << setw(5) << porcentaje << " %)";
+            if (medirCiclos && bytes > 0)
+                oss << setprecision(2) << setw(10) << static_cast<double>(ciclos[e]) / bytes << " ciclos/byte";
+            oss << setprecision(3) << endl;
+        }
+        oss << "Bytes procesados:   " << bytes;
+        if (segundos > 0)
+            oss << "  (" << setprecision(1) << bytes / segundos / 1e6 << " MB/s)" << setprecision(3);
+        if (medirCiclos)
+            oss << endl
+                << describirContadorCiclos();
+
+        if (medirContadores)
+            oss << endl
+                << resumenContadores();
+
+        if (medirMemoria)
+            oss << endl
+                << resumenMemoria();
+
+        oss << endl
+            << "Latencias:" << endl;
+        for (int e = 0; e < NUM_ETAPAS; e++)
+            if (latencias[e].getCantidad() > 0)
+                oss << "  " << left << setw(13) << nombresEtapas[e] << right << latencias[e].resumen() << endl;
+        oss << "  " << left << setw(13) << "Proceso" << right << procesos.resumen(segundos);
+        return oss.str();
+    }
+
+    /**
+     * @brief Tabla con IPC y fallos por KiB procesado de cada etapa ("-" si el contador falta).
+     */
+    string resumenContadores() const
+    {
+        ostringstream oss;
+        oss << fixed << setprecision(2) << "Contadores por etapa (fallos por KiB procesado):";
+        double kib = bytes / 1024.0;
+        for (int e = 0; e < NUM_ETAPAS; e++)
+        {
+            if (nanosegundos[e] == 0)
+                continue;
+            const atomic<long long> *c = contadores[e];
+            oss << endl
+                << "  " << left << setw(13) << nombresEtapas[e] << right << "IPC ";
+            if (c[CONTADOR_CICLOS] > 0 && c[CONTADOR_INSTRUCCIONES] > 0)
+                oss << setw(5) << static_cast<double>(c[CONTADOR_INSTRUCCIONES]) / c[CONTADOR_CICLOS];
+            else
+                oss << "    -";
+            for (int k = CONTADOR_FALLOS_CACHE; k <= CONTADOR_FALLOS_PAGINA; k++)
+            {
+                oss << "  " << nombresContadores[k] << " ";
+                if ((contadoresDisponibles & (1 << k)) && kib > 0)
+                    oss << c[k] / kib;
+                else
+                    oss << "-";
+            }
+            oss << "  " << nombresContadores[CONTADOR_CAMBIOS_CONTEXTO] << " ";
+            if (contadoresDisponibles & (1 << CONTADOR_CAMBIOS_CONTEXTO))
+                oss << c[CONTADOR_CAMBIOS_CONTEXTO];
+            else
+                oss << "-";
+        }
+        oss << endl
+            << describirContadores(contadoresDisponibles);
+        return oss.str();
+    }
+
+    /**
+     * @brief Tabla con la memoria reservada y el pico de cada etapa, por proceso y del programa,
+     * y los contadores del pool de buffers (de todo el programa hasta ese momento).
+     */
+    string resumenMemoria() const
+    {
+        ostringstream oss;
+        oss << "Memoria por etapa:";
+        for (int e = 0; e < NUM_ETAPAS; e++)
+        {
+            if (memoriaAsignaciones[e] == 0)
+                continue;
+            oss << endl
+                << "  " << left << setw(13) << nombresEtapas[e] << right << setw(12) << formatearBytes(memoriaBytes[e]) << " reservados en "
+                << setw(9) << memoriaAsignaciones[e] << " new  pico " << formatearBytes(memoriaPico[e]);
+        }
+        if (memoriaProcesos > 0)
+            oss << endl
+                << "  " << left << setw(13) << "Proceso" << right << setw(12) << formatearBytes(static_cast<double>(bytesProcesos) / memoriaProcesos)
+                << " reservados en " << setw(9) << asignacionesProcesos / memoriaProcesos << " new  pico " << formatearBytes(picoProceso)
+                << "  (media por proceso, pico maximo)";
+        long long residente = leerMemoriaProceso("VmRSS"), maxima = leerMemoriaProceso("VmHWM");
+        oss << endl
+            << "Memoria residente: ";
+        if (maxima >= 0)
+            oss << formatearBytes(residente * 1024.0) << " actual, " << formatearBytes(maxima * 1024.0) << " maxima del programa";
+        else
+            oss << "no disponible (/proc/self/status)";
+        if (residenteMaximaKiB > 0)
+            oss << ", " << formatearBytes(residenteMaximaKiB * 1024.0) << " maxima al terminar un proceso";
+        oss << endl
+            << describirPoolBuffers();
+        return oss.str();
+    }
+
+    /**
+     * @brief Escribe los histogramas con nombres "<prefijo>/<etapa>" y "<prefijo>/Proceso".
+     */
+    void volcarHistogramas(ostream &salida, const string &prefijo) const
+    {
+        for (int e = 0; e < NUM_ETAPAS; e++)
+            if (latencias[e].getCantidad() > 0)
+                latencias[e].volcar(salida, prefijo + "/" + nombresEtapas[e]);
+        procesos.volcar(salida, prefijo + "/Proceso");
+    }
+};
+
+/**
+ * @brief Vuelca a un archivo los histogramas de varias ejecuciones, cada una con su prefijo.
+ *
+ * El archivo se puede comparar con otros con benchmarks/comparar_histogramas.cpp.
+ *
+ * @return bool false si no se pudo escribir el archivo.
+ */
+bool guardarHistogramas(const string &ruta, const vector<pair<string, const TiemposEtapas *>> &ejecuciones)
+{
+    ofstream salida(ruta);
+    if (!salida.is_open())
+    {
+        cerr << "No se pudo crear " << ruta << endl;
+        return false;
+    }
+    for (const auto &e : ejecuciones)
+        e.second->volcarHistogramas(salida, e.first);
+    return true;
+}
+
+/**
+ * @struct SumaEtapa
+ * @brief Lo medido en una etapa por uno o varios tramos, antes de sumarlo a TiemposEtapas.
+ */
+
+struct SumaEtapa
+{
+    long long nanosegundos = 0, ciclos = 0;
+    long long contadores[NUM_CONTADORES] = {};
+    long long memoriaBytes = 0, memoriaAsignaciones = 0, memoriaPico = 0;
+};
+
+/**
+ * @brief Suma a tiempos una medida de la etapa y la registra como una muestra de su histograma.
+ */
+void registrarEtapa(TiemposEtapas *tiempos, Etapa etapa, const SumaEtapa &suma)
+{
+    if (tiempos->medirCiclos)
+        tiempos->ciclos[etapa] += suma.ciclos;
+    for (int c = 0; c < NUM_CONTADORES; c++)
+        tiempos->contadores[etapa][c] += suma.contadores[c];
+    tiempos->memoriaBytes[etapa] += suma.memoriaBytes;
+    tiempos->memoriaAsignaciones[etapa] += suma.memoriaAsignaciones;
+    actualizarMaximo(tiempos->memoriaPico[etapa], suma.memoriaPico);
+    tiempos->nanosegundos[etapa] += suma.nanosegundos;
+    tiempos->latencias[etapa].registrar(suma.nanosegundos);
+}
+
+/**
+ * @class MedidaEtapa
+ * @brief Suma a una SumaEtapa lo transcurrido entre su construcción y terminar() (o su destrucción).
+ *
+ * Si tiempos es nulo no mide nada.
+ */
+
+class MedidaEtapa
+{
+private:
+    TiemposEtapas *tiempos;
+    SumaEtapa *suma; // Nulo cuando ya terminó
+    chrono::steady_clock::time_point inicio;
+    unsigned long long ciclosInicio;
+    ContadoresHilo *grupo; // Grupo de contadores del hilo donde empezó la etapa
+    LecturaContadores contadoresInicio;
+    MedicionMemoria memoria;
+
+public:
+    MedidaEtapa(TiemposEtapas *t, SumaEtapa &s) : tiempos(t), suma(t != nullptr ? &s : nullptr), ciclosInicio(0), grupo(nullptr)
+    {
+        if (tiempos == nullptr)
+            return;
+        if (tiempos->medirContadores && contadoresHilo().leer(contadoresInicio))
+        {
+            grupo = &contadoresHilo();
+            tiempos->contadoresDisponibles.fetch_or(grupo->mascara());
+        }
+        if (tiempos->medirMemoria)
+            memoria.iniciar();
+        inicio = chrono::steady_clock::now();
+        if (tiempos->medirCiclos)
+            ciclosInicio = leerCiclos();
+    }
+
+    ~MedidaEtapa() { terminar(); }
+
+    void terminar()
+    {
+        if (suma == nullptr)
+            return;
+        if (tiempos->medirCiclos)
+            suma->ciclos += leerCiclos() - ciclosInicio;
+
+        // Los contadores son del hilo: si la etapa acabó en otro (corrutinas) la muestra se descarta
+        LecturaContadores contadoresFin;
+        if (grupo != nullptr && grupo == &contadoresHilo() && grupo->leer(contadoresFin))
+            for (int c = 0; c < NUM_CONTADORES; c++)
+                if (contadoresFin.valores[c] >= 0)
+                    suma->contadores[c] += contadoresFin.valores[c] - contadoresInicio.valores[c];
+        long long reservados, asignaciones, pico;
+        if (memoria.terminar(reservados, asignaciones, pico))
+        {
+            suma->memoriaBytes += reservados;
+            suma->memoriaAsignaciones += asignaciones;
+            suma->memoriaPico = max(suma->memoriaPico, pico);
+        }
+        suma->nanosegundos += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+        suma = nullptr;
+    }
+};
+
+/**
+ * @class CronometroEtapa
+ * @brief Suma a una etapa el tiempo transcurrido entre su construcción y su destrucción.
+ *
+ * Si tiempos es nulo no mide nada, pero sigue registrando el span de la etapa si hay traza.
+ * Las etapas no se anidan: si un cronómetro se abre dentro de otro, el tiempo y los contadores
+ * del interior se suman a las dos etapas.
+ */
+
+class CronometroEtapa
+{
+private:
+    TiemposEtapas *tiempos;
+    Etapa etapa;
+    SumaEtapa suma;
+    SpanTraza span; // Con la traza activa, la etapa aparece también en la línea de tiempo
+    MedidaEtapa medida;
+
+public:
+    CronometroEtapa(TiemposEtapas *t, Etapa e) : tiempos(t), etapa(e), span(nombresEtapas[e]), medida(t, suma) {}
+
+    ~CronometroEtapa()
+    {
+        medida.terminar();
+        if (tiempos != nullptr)
+            registrarEtapa(tiempos, etapa, suma);
+    }
+};
+
+/**
+ * @class EtapasPorBloques
+ * @brief Acumula las etapas de un proceso que pasa por todas ellas en cada bloque.
+ *
+ * El pipeline fusionado recorre las siete etapas una vez por bloque de 64 KiB. Cada tramo se
+ * suma en local y, al destruirse, cada etapa usada se registra como una sola muestra del
+ * histograma y un solo span de la traza, igual que en los modos que miden la etapa una vez por
+ * archivo. El span va desde el primer tramo hasta el último y, como los de las distintas etapas
+ * se solapan, se exporta como asíncrono.
+ */
+
+class EtapasPorBloques
+{
+private:
+    TiemposEtapas *tiempos;
+    SumaEtapa sumas[NUM_ETAPAS];
+    int tramos[NUM_ETAPAS] = {};
+    long long trazaInicio[NUM_ETAPAS], trazaFin[NUM_ETAPAS]; // Instantes del primer y último tramo
+    int archivoTraza;
+
+public:
+    /**
+     * @class Tramo
+     * @brief Un paso por la etapa, medido entre su construcción y su destrucción.
+     */
+    class Tramo
+    {
+    private:
+        EtapasPorBloques &etapas;
+        Etapa etapa;
+        MedidaEtapa medida;
+
+    public:
+        Tramo(EtapasPorBloques &etapas, Etapa e) : etapas(etapas), etapa(e), medida(etapas.tiempos, etapas.sumas[e])
+        {
+            if (trazaActiva() && etapas.tramos[e] == 0)
+                etapas.trazaInicio[e] = RegistroTraza::global().ahoraNs();
+        }
+
+        ~Tramo()
+        {
+            medida.terminar();
+            if (trazaActiva())
+                etapas.trazaFin[etapa] = RegistroTraza::global().ahoraNs();
+            etapas.tramos[etapa]++;
+        }
+    };
+
+    EtapasPorBloques(TiemposEtapas *t) : tiempos(t), archivoTraza(archivoTrazaActual())
+    {
+        for (int e = 0; e < NUM_ETAPAS; e++)
+            trazaInicio[e] = trazaFin[e] = -1;
+    }
+
+    ~EtapasPorBloques()
+    {
+        for (int e = 0; e < NUM_ETAPAS; e++)
+        {
+            if (tramos[e] == 0)
+                continue;
+            if (tiempos != nullptr)
+                registrarEtapa(tiempos, static_cast<Etapa>(e), sumas[e]);
+            if (trazaActiva() && trazaInicio[e] >= 0 && trazaFin[e] >= 0)
+            {
+                RegistroTraza &registro = RegistroTraza::global();
+                registro.registrar({nombresEtapas[e], archivoTraza, registro.nuevoIdAsincrono(), trazaInicio[e], trazaFin[e]});
+            }
+        }
+    }
+};
+
+/**
+ * @class CronometroProceso
+ * @brief Registra en el histograma de procesos la duración de un proceso completo.
+ *
+ * Con medirMemoria suma también lo que reservó el proceso y muestrea la memoria residente.
+ * Si tiempos es nulo no mide nada.
+ */
+
+class CronometroProceso
+{
+private:
+    TiemposEtapas *tiempos;
+    chrono::steady_clock::time_point inicio;
+    MedicionMemoria memoria;
+
+public:
+    CronometroProceso(TiemposEtapas *t) : tiempos(t)
+    {
+        if (tiempos == nullptr)
+            return;
+        if (tiempos->medirMemoria)
+            memoria.iniciar();
+        inicio = chrono::steady_clock::now();
+    }
+
+    ~CronometroProceso()
+    {
+        if (tiempos == nullptr)
+            return;
+        tiempos->procesos.registrar(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count());
+        long long reservados, asignaciones, pico;
+        if (memoria.terminar(reservados, asignaciones, pico))
+        {
+            tiempos->memoriaProcesos++;
+            tiempos->bytesProcesos += reservados;
+            tiempos->asignacionesProcesos += asignaciones;
+            actualizarMaximo(tiempos->picoProceso, pico);
+            actualizarMaximo(tiempos->residenteMaximaKiB, leerMemoriaProceso("VmRSS"));
+        }
+    }
+};
+
+/**
+ * @struct ResultadoProceso
+ * @brief Resultados de las dos comparaciones que hace cada proceso.
+ */
+
+struct ResultadoProceso
+{
+    bool hashesIguales = false;  // Paso 5: los dos hashes de la copia coinciden.
+    bool contenidoIgual = false; // Paso 7: el desencriptado es igual al original.
+    string hash;                 // Hash SHA-256 de la entrada ("" si no se pudo leer).
+};
+
+/**
+ * @brief Ejecuta los siete pasos del proceso recorriendo el archivo original una sola vez.
+ *
+ * Por cada bloque leído: se escribe en la copia, se suma a los dos hashes, se encripta y se
+ * escribe en el .sha, se desencripta en memoria, se escribe en el .des y se compara con el
+ * bloque leído. Los dos hashes se calculan con contextos independientes, igual que los pasos
+ * 3 y 4 del proceso normal.
+ *
+ * Cada etapa se mide en todos los bloques pero se registra una sola vez por archivo (ver
+ * EtapasPorBloques), así que sus latencias se pueden comparar con las de los demás modos.
+ *
+ * @param archivoOriginal Ruta del archivo fuente.
+ * @param archivoCopia Ruta de la copia (N.txt); si está vacía, no se escribe ninguna copia.
+ * @param archivoEncriptado Ruta del archivo encriptado (N.sha).
+ * @param archivoDesencriptado Ruta del archivo desencriptado (N.des); si está vacía, el .des no se
+ *                             escribe y solo se verifica en memoria (modo solo verificación).
+ * @param tiempos Acumulador de tiempos por etapa (puede ser nulo).
+ * @return ResultadoProceso Resultado de las comparaciones.
+ */
+
+ResultadoProceso procesoFusionado(const string &archivoOriginal, const string &archivoCopia, const string &archivoEncriptado,
+                                  const string &archivoDesencriptado, TiemposEtapas *tiempos = nullptr)
+{
+    ResultadoProceso resultado;
+
+    ifstream origen(archivoOriginal, ios::binary);
+    bool escribirCopia = !archivoCopia.empty();
+    ofstream copia;
+    if (escribirCopia)
+        copia.open(archivoCopia, ios::binary);
+    ofstream encriptado(archivoEncriptado, ios::binary);
+    bool escribirDesencriptado = !archivoDesencriptado.empty();
+    ofstream desencriptado;
+    if (escribirDesencriptado)
+        desencriptado.open(archivoDesencriptado, ios::binary);
+
+    if (!origen.is_open() || (escribirCopia && !copia.is_open()) || !encriptado.is_open() || (escribirDesencriptado && !desencriptado.is_open()))
+    {
+        cerr << "Error al abrir los archivos\n";
+        return resultado;
+    }
+
+    // Buffers del pool propios del hilo (en su nodo NUMA si fue colocado), reutilizados entre procesos
+    char *bloque = bufferLocal(0, TAMANO_BLOQUE), *cifrado = bufferLocal(1, TAMANO_BLOQUE), *descifrado = bufferLocal(2, TAMANO_BLOQUE);
+    sha256 contexto1, contexto2;
+    bool contenidoIgual = true;
+    long long total = 0;
+    EtapasPorBloques etapas(tiempos); // Una muestra y un span por etapa para todo el archivo
+
+    while (true)
+    {
+        streamsize leidos;
+        {
+            EtapasPorBloques::Tramo t(etapas, ETAPA_LECTURA);
+            origen.read(bloque, TAMANO_BLOQUE);
+            leidos = origen.gcount();
+        }
+        if (leidos <= 0)
+            break;
+        total += leidos;
+
+        if (escribirCopia)
+        {
+            EtapasPorBloques::Tramo t(etapas, ETAPA_COPIA);
+            copia.write(bloque, leidos);
+        }
+        {
+            EtapasPorBloques::Tramo t(etapas, ETAPA_HASH);
+            contexto1.sha_append(reinterpret_cast<const BYTE *>(bloque), leidos);
+            contexto2.sha_append(reinterpret_cast<const BYTE *>(bloque), leidos);
+        }
+        {
+            EtapasPorBloques::Tramo t(etapas, ETAPA_ENCRIPTAR);
+            encriptarBloque(bloque, cifrado, leidos);
+        }
+        {
+            EtapasPorBloques::Tramo t(etapas, ETAPA_DESENCRIPTAR);
+            desencriptarBloque(cifrado, descifrado, leidos);
+        }
+        {
+            EtapasPorBloques::Tramo t(etapas, ETAPA_ESCRITURA);
+            encriptado.write(cifrado, leidos);
+            if (escribirDesencriptado)
+                desencriptado.write(descifrado, leidos);
+        }
+        {
+            EtapasPorBloques::Tramo t(etapas, ETAPA_COMPARAR);
+            if (contenidoIgual && memcmp(bloque, descifrado, leidos) != 0)
+                contenidoIgual = false;
+        }
+    }
+
+    {
+        EtapasPorBloques::Tramo t(etapas, ETAPA_HASH);
+        string hash1 = contexto1.sha_digest();
+        string hash2 = contexto2.sha_digest();
+        resultado.hashesIguales = (hash1 == hash2);
+        resultado.hash = hash1;
+    }
+
+    resultado.contenidoIgual = contenidoIgual;
+    if (tiempos != nullptr)
+        tiempos->bytes += total;
+    return resultado;
+}
+
+#endif // F11_PIPELINE_FUSIONADO_H
@@ -0,0 +1,441 @@
+/**
+ * @file F12_planificador_dag.h
+ * @brief Planificador de tareas con dependencias (grafo acíclico dirigido) sobre un pool de hilos.
+ *
+ * Cada proceso se modela como un grafo de etapas con dependencias explícitas en lugar de una
+ * secuencia fija de siete pasos. Las etapas que no dependen entre sí (los dos hashes, la
+ * encriptación) pueden ejecutarse a la vez, y las etapas de distintos procesos se intercalan
+ * en el mismo pool de hilos.
+ *
+ * Al terminar cada trabajo se calcula la longitud de su ruta crítica (la cadena de etapas
+ * dependientes más larga) y el trabajo total, cuyo cociente indica cuánto paralelismo hay
+ * realmente disponible dentro de un proceso.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F05_proceso.h: Proporciona OpcionesProceso, ResultadoProceso y las operaciones de F01.
+ * - F08_temporizador.h: Proporciona Temporizador para medir la ejecución completa.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F12_PLANIFICADOR_DAG_H
+#define F12_PLANIFICADOR_DAG_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F05_proceso.h"
+#include "F08_temporizador.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+
+/**
+ * @struct TareaDAG
+ * @brief Etapa de un trabajo: una función y las etapas que dependen de ella.
+ */
+
+struct TareaDAG
+{
+    string nombre;
+    function<void()> funcion;
+    vector<int> dependencias;   // Índices de las tareas que deben terminar antes
+    vector<int> sucesores;      // Índices de las tareas que esperan a esta
+    atomic<int> pendientes;     // Dependencias que aún no han terminado
+    long long duracionNs = 0;   // Tiempo de ejecución medido
+};
+
+/**
+ * @class TrabajoDAG
+ * @brief Grafo de tareas de un trabajo (por ejemplo, un proceso del pipeline).
+ *
+ * Las tareas deben agregarse después de sus dependencias, de modo que el orden de inserción
+ * ya es un orden topológico.
+ */
+
+class TrabajoDAG
+{
+private:
+    vector<unique_ptr<TareaDAG>> tareas;
+    atomic<int> restantes;
+    mutex mutex_trabajo;
+    condition_variable terminado;
+    chrono::steady_clock::time_point inicio, fin;
+
+    friend class PlanificadorDAG;
+
+public:
+    int id;
+
+    TrabajoDAG(int identificador = 0) : restantes(0), id(identificador) {}
+
+    /**
+     * @brief Agrega una tarea al grafo.
+     *
+     * @param nombre Nombre de la etapa (para los informes).
+     * @param funcion Trabajo a ejecutar.
+     * @param dependencias Índices de tareas ya agregadas que deben terminar antes.
+     * @return int Índice de la nueva tarea.
+     */
+    int agregarTarea(const string &nombre, function<void()> funcion, const vector<int> &dependencias = {})
+    {
+        int indice = static_cast<int>(tareas.size());
+        unique_ptr<TareaDAG> tarea(new TareaDAG());
+        tarea->nombre = nombre;
+        tarea->funcion = move(funcion);
+        tarea->dependencias = dependencias;
+        tarea->pendientes = static_cast<int>(dependencias.size());
+        for (int d : dependencias)
+            tareas[d]->sucesores.push_back(indice);
+        tareas.push_back(move(tarea));
+        restantes++;
+        return indice;
+    }
+
+    /**
+     * @brief Bloquea al llamador hasta que terminan todas las tareas del trabajo.
+     */
+    void esperar()
+    {
+        unique_lock<mutex> lock(mutex_trabajo);
+        terminado.wait(lock, [this]
+                       { return restantes == 0; });
+    }
+
+    /**
+     * @brief Longitud de la ruta crítica: la cadena de dependencias con mayor duración total.
+     */
+    double rutaCriticaMs() const
+    {
+        vector<long long> finMasTardio(tareas.size(), 0);
+        long long maximo = 0;
+        for (size_t t = 0; t < tareas.size(); t++)
+        {
+            long long inicioMasTardio = 0;
+            for (int d : tareas[t]->dependencias)
+                inicioMasTardio = max(inicioMasTardio, finMasTardio[d]);
+            finMasTardio[t] = inicioMasTardio + tareas[t]->duracionNs;
+            maximo = max(maximo, finMasTardio[t]);
+        }
+        return maximo / 1e6;
+    }
+
+    /**
+     * @brief Suma de la duración de todas las tareas (el tiempo que tardaría con un solo hilo).
+     */
+    double trabajoTotalMs() const
+    {
+        long long total = 0;
+        for (const auto &tarea : tareas)
+            total += tarea->duracionNs;
+        return total / 1e6;
+    }
+
+    /**
+     * @brief Tiempo real entre el inicio de la primera tarea y el fin de la última.
+     */
+    double duracionMs() const
+    {
+        return chrono::duration_cast<chrono::nanoseconds>(fin - inicio).count() / 1e6;
+    }
+};
+
+/**
+ * @class PlanificadorDAG
+ * @brief Pool de hilos compartido que ejecuta las tareas listas de cualquier trabajo.
+ *
+ * Una tarea pasa a la cola de listas cuando terminan todas sus dependencias. Los hilos toman
+ * tareas de la cola sin importar a qué trabajo pertenecen, así que las etapas de distintos
+ * procesos se solapan.
+ */
+
+class PlanificadorDAG
+{
+private:
+    vector<thread> hilos;
+    deque<pair<TrabajoDAG *, int>> listas;
+    mutex mutex_cola;
+    condition_variable hayTareas;
+    bool detener;
+
+    void encolar(TrabajoDAG *trabajo, int tarea)
+    {
+        {
+            lock_guard<mutex> lock(mutex_cola);
+            listas.push_back({trabajo, tarea});
+        }
+        hayTareas.notify_one();
+    }
+
+    void ejecutar(TrabajoDAG *trabajo, int indice)
+    {
+        TareaDAG &tarea = *trabajo->tareas[indice];
+
+        auto inicio = chrono::steady_clock::now();
+        {
+            SpanTraza span("tarea DAG", trabajo->id);
+            tarea.funcion();
+        }
+        auto fin = chrono::steady_clock::now();
+        tarea.duracionNs = chrono::duration_cast<chrono::nanoseconds>(fin - inicio).count();
+
+        // Libera a los sucesores cuya última dependencia era esta tarea
+        for (int s : tarea.sucesores)
+        {
+            if (--trabajo->tareas[s]->pendientes == 0)
+                encolar(trabajo, s);
+        }
+
+        lock_guard<mutex> lock(trabajo->mutex_trabajo);
+        if (fin > trabajo->fin)
+            trabajo->fin = fin;
+        if (--trabajo->restantes == 0)
+            trabajo->terminado.notify_all();
+    }
+
+    void bucleTrabajador()
+    {
+        while (true)
+        {
+            pair<TrabajoDAG *, int> siguiente;
+            {
+                unique_lock<mutex> lock(mutex_cola);
+                hayTareas.wait(lock, [this]
+                               { return detener || !listas.empty(); });
+                if (listas.empty())
+                    return;
+                siguiente = listas.front();
+                listas.pop_front();
+            }
+            ejecutar(siguiente.first, siguiente.second);
+        }
+    }
+
+public:
+    /**
+     * @brief Lanza el pool de hilos.
+     *
+     * @param numHilos Cantidad de hilos; 0 usa hardware_concurrency().
+     */
+    PlanificadorDAG(int numHilos = 0) : detener(false)
+    {
+        if (numHilos <= 0)
+            numHilos = max(1u, thread::hardware_concurrency());
+        for (int h = 0; h < numHilos; h++)
+            hilos.emplace_back([this]
+                               { bucleTrabajador(); });
+    }
+
+    ~PlanificadorDAG()
+    {
+        {
+            lock_guard<mutex> lock(mutex_cola);
+            detener = true;
+        }
+        hayTareas.notify_all();
+        for (auto &hilo : hilos)
+            hilo.join();
+    }
+
+    int numeroHilos() const { return static_cast<int>(hilos.size()); }
+
+    /**
+     * @brief Envía un trabajo al pool: encola las tareas que no tienen dependencias.
+     *
+     * El trabajo debe seguir vivo hasta que termine (ver TrabajoDAG::esperar).
+     */
+    void enviar(TrabajoDAG &trabajo)
+    {
+        trabajo.inicio = trabajo.fin = chrono::steady_clock::now();
+        for (size_t t = 0; t < trabajo.tareas.size(); t++)
+        {
+            if (trabajo.tareas[t]->dependencias.empty())
+                encolar(&trabajo, static_cast<int>(t));
+        }
+    }
+};
+
+/**
+ * @struct EstadoProcesoDAG
+ * @brief Datos que comparten las etapas de un mismo proceso.
+ */
+
+struct EstadoProcesoDAG
+{
+    string archivoOriginal, archivoCopia, archivoEncriptado, archivoDesencriptado;
+    string hash1, hash2;
+    ResultadoProceso resultado;
+};
+
+/**
+ * @brief Construye el grafo de etapas de un proceso.
+ *
+ *   copia ──┬── hash1 ──┬── comparar hashes
+ *           ├── hash2 ──┘
+ *           └── encriptar ── desencriptar ── comparar archivos
+ *
+ * Con almacén, encriptar depende además de hash1 (es la clave); en modo solo verificación,
+ * desencriptar y comparar archivos se reducen a una sola etapa en memoria. El modo fusionado
+ * ya recorre el archivo una sola vez y se ejecuta como una única etapa.
+ *
+ * @param trabajo Trabajo vacío donde se agregan las etapas.
+ * @param estado Datos del proceso; debe seguir vivo hasta que termine el trabajo.
+ * @param rutaTrabajo Directorio de trabajo (contiene original.txt).
+ * @param i Número del proceso.
+ * @param opciones Opciones del proceso.
+ */
+
+void construirProcesoDAG(TrabajoDAG &trabajo, EstadoProcesoDAG &estado, const string &rutaTrabajo, int i, const OpcionesProceso &opciones)
+{
+    EstadoProcesoDAG *e = &estado;
+    const OpcionesProceso *o = &opciones;
+
+    if (opciones.fusionado)
+    {
+        trabajo.agregarTarea("fusionado", [e, o, rutaTrabajo, i]
+                             { e->resultado = proceso(rutaTrabajo, i, *o); });
+        return;
+    }
+
+    estado.archivoOriginal = rutaTrabajo + "original.txt";
+    estado.archivoCopia = rutaTrabajo + to_string(i) + ".txt";
+    estado.archivoEncriptado = rutaTrabajo + to_string(i) + ".sha";
+    estado.archivoDesencriptado = rutaTrabajo + to_string(i) + ".des";
+    AlmacenContenido *almacen = opciones.almacen;
+    TiemposEtapas *tiempos = opciones.tiempos;
+
+    int copia = trabajo.agregarTarea("copia", [e, tiempos]
+                                     {
+        CronometroEtapa c(tiempos, ETAPA_COPIA);
+        generarCopia(e->archivoOriginal, e->archivoCopia); });
+
+    int hash1 = trabajo.agregarTarea("hash1", [e, tiempos]
+                                     {
+        CronometroEtapa c(tiempos, ETAPA_HASH);
+        e->hash1 = generarHashArchivo(e->archivoCopia); }, {copia});
+
+    int hash2 = trabajo.agregarTarea("hash2", [e, tiempos]
+                                     {
+        CronometroEtapa c(tiempos, ETAPA_HASH);
+        e->hash2 = generarHashArchivo(e->archivoCopia); }, {copia});
+
+    trabajo.agregarTarea("comparar hashes", [e]
+                         { e->resultado.hashesIguales = compararString(e->hash1, e->hash2); }, {hash1, hash2});
+
+    vector<int> dependenciasEncriptar = {copia};
+    if (almacen != nullptr)
+        dependenciasEncriptar.push_back(hash1);
+
+    int encriptar = trabajo.agregarTarea("encriptar", [e, almacen, tiempos]
+                                         {
+        if (almacen == nullptr || !almacen->materializar(e->hash1, TRANSFORMACION_ENCRIPTAR, e->archivoEncriptado))
+        {
+            CronometroEtapa c(tiempos, ETAPA_ENCRIPTAR);
+            encriptarArchivo(e->archivoCopia, e->archivoEncriptado);
+            if (almacen != nullptr)
+                almacen->publicar(e->hash1, TRANSFORMACION_ENCRIPTAR, e->archivoEncriptado);
+        } }, dependenciasEncriptar);
+
+    if (opciones.soloVerificar)
+    {
+        trabajo.agregarTarea("verificar", [e, tiempos]
+                             {
+            {
+                CronometroEtapa c(tiempos, ETAPA_COMPARAR);
+                e->resultado.contenidoIgual = verificarDesencriptado(e->archivoEncriptado, e->archivoOriginal);
+            }
+            if (tiempos != nullptr)
+                tiempos->bytes += devolverTamanoArchivo(e->archivoOriginal); }, {encriptar});
+        return;
+    }
+
+    int desencriptar = trabajo.agregarTarea("desencriptar", [e, almacen, tiempos]
+                                            {
+        if (almacen == nullptr || !almacen->materializar(e->hash1, TRANSFORMACION_DESENCRIPTAR, e->archivoDesencriptado))
+        {
+            CronometroEtapa c(tiempos, ETAPA_DESENCRIPTAR);
+            desencriptarArchivo(e->archivoEncriptado, e->archivoDesencriptado);
+            if (almacen != nullptr)
+                almacen->publicar(e->hash1, TRANSFORMACION_DESENCRIPTAR, e->archivoDesencriptado);
+        } }, {encriptar});
+
+    trabajo.agregarTarea("comparar archivos", [e, tiempos]
+                         {
+        {
+            CronometroEtapa c(tiempos, ETAPA_COMPARAR);
+            e->resultado.contenidoIgual = compararArchivos(e->archivoDesencriptado, e->archivoOriginal);
+        }
+        // Igual que procesarArchivo: los bytes del proceso se suman al terminar su última etapa
+        if (tiempos != nullptr)
+            tiempos->bytes += devolverTamanoArchivo(e->archivoOriginal); }, {desencriptar});
+}
+
+Temporizador mainDAG(int copias, const OpcionesProceso &opciones = OpcionesProceso(), int numHilos = 0)
+{
+    cout << endl;
+
+    Temporizador temporizador_principal;
+    const string rutaTrabajo = "file_workspace_parallel/";
+
+    cout << "================================" << endl;
+    cout << "      INICIO PROCESO DAG        " << endl;
+    cout << "================================" << endl;
+    cout << "Tiempo Inicial:     " << temporizador_principal.formatoTextoInicio() << endl;
+    cout << "================================" << endl;
+    cout << endl;
+
+    vector<unique_ptr<TrabajoDAG>> trabajos;
+    vector<unique_ptr<EstadoProcesoDAG>> estados;
+    {
+        PlanificadorDAG planificador(numHilos);
+
+        for (int i = 1; i <= copias; i++)
+        {
+            trabajos.emplace_back(new TrabajoDAG(i));
+            estados.emplace_back(new EstadoProcesoDAG());
+            construirProcesoDAG(*trabajos.back(), *estados.back(), rutaTrabajo, i, opciones);
+            planificador.enviar(*trabajos.back());
+        }
+
+        for (auto &trabajo : trabajos)
+            trabajo->esperar();
+
+        cout << "Hilos del pool:     " << planificador.numeroHilos() << endl;
+        cout << "--------------------------------" << endl;
+    }
+
+    temporizador_principal.detener();
+
+    cout << fixed << setprecision(3);
+    for (const auto &trabajo : trabajos)
+    {
+        double rutaCritica = trabajo->rutaCriticaMs();
+        double total = trabajo->trabajoTotalMs();
+
+        cout << "TIEMPO PROCESO " << trabajo->id << ": ";
+        if (trabajo->id < 10)
+            cout << " ";
+        cout << trabajo->duracionMs() << " ms" << endl;
+        cout << "  Ruta critica:     " << rutaCritica << " ms" << endl;
+        cout << "  Trabajo total:    " << total << " ms" << endl;
+        cout << "  Paralelismo:      " << (rutaCritica > 0 ? total / rutaCritica : 1.0) << endl;
+        cout << "--------------------------------" << endl;
+        if (opciones.tiempos != nullptr)
+            opciones.tiempos->procesos.registrar(static_cast<long long>(trabajo->duracionMs() * 1e6));
+    }
+
+    cout << "================================" << endl;
+    cout << "        FIN PROCESO DAG         " << endl;
+    cout << "================================" << endl;
+    cout << "Tiempo Final:       " << temporizador_principal.formatoTextoFin() << endl;
+    cout << "Tiempo Total:       " << temporizador_principal.tiempoTranscurrido() << endl;
+    cout << "================================" << endl;
+    if (opciones.almacen != nullptr)
+        cout << opciones.almacen->resumen() << endl;
+    if (opciones.tiempos != nullptr)
+        cout << opciones.tiempos->resumen(temporizador_principal.duracionSegundos()) << endl;
+    return temporizador_principal;
+}
+
+#endif // F12_PLANIFICADOR_DAG_H
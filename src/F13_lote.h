@@ -0,0 +1,494 @@
+/**
+ * @file F13_lote.h
+ * @brief Procesamiento por lotes de archivos reales (un directorio o una lista de archivos).
+ *
+ * Los modos secuencial y paralelo trabajan siempre sobre N copias de original.txt. Este modo
+ * recibe un árbol de directorios o una lista de rutas y pasa cada archivo por el pipeline de
+ * encriptación, hash y verificación (procesarArchivo, sin el paso de copia).
+ *
+ * El árbol se recorre en paralelo con openat y getdents64 (en Linux; en otros sistemas se usa
+ * opendir/readdir). Al terminar se informa el rendimiento agregado, los archivos más lentos y
+ * se escribe un manifiesto CSV con el hash y el resultado de cada archivo.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F05_proceso.h: Proporciona procesarArchivo y OpcionesProceso.
+ * - F08_temporizador.h: Proporciona Temporizador para medir la ejecución completa.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F13_LOTE_H
+#define F13_LOTE_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F05_proceso.h"
+#include "F08_temporizador.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <numeric>
+#include <cstring>
+#include <dirent.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+/**
+ * @def TAMANO_BUFFER_DIRECTORIO
+ * @brief Tamaño del buffer con el que se leen las entradas de cada directorio.
+ */
+
+#define TAMANO_BUFFER_DIRECTORIO (32 * 1024)
+
+/**
+ * @def ARCHIVOS_MAS_LENTOS
+ * @brief Cantidad de archivos más lentos que se muestran en el resumen.
+ */
+
+#define ARCHIVOS_MAS_LENTOS 10
+
+/**
+ * @brief Agrega '/' al final de una ruta de directorio si no lo tiene.
+ */
+string normalizarDirectorio(const string &ruta)
+{
+    if (ruta.empty() || ruta.back() == '/')
+        return ruta;
+    return ruta + "/";
+}
+
+/**
+ * @struct IdentidadDirectorio
+ * @brief Dispositivo e inodo de un directorio, para reconocerlo se escriba como se escriba su ruta.
+ *
+ * "./salida/", "salida" y la ruta absoluta nombran el mismo directorio, así que comparar cadenas
+ * no sirve para excluir el directorio de salida de un recorrido. Si la ruta no existe la
+ * identidad no es válida y no coincide con nada.
+ */
+
+struct IdentidadDirectorio
+{
+    dev_t dispositivo = 0;
+    ino_t inodo = 0;
+    bool valida = false;
+
+    IdentidadDirectorio() {}
+
+    IdentidadDirectorio(const string &ruta)
+    {
+        struct stat info;
+        if (!ruta.empty() && stat(ruta.c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+        {
+            dispositivo = info.st_dev;
+            inodo = info.st_ino;
+            valida = true;
+        }
+    }
+
+    bool es(const struct stat &info) const { return valida && info.st_dev == dispositivo && info.st_ino == inodo; }
+
+    bool es(const string &ruta) const
+    {
+        struct stat info;
+        return valida && stat(ruta.c_str(), &info) == 0 && es(info);
+    }
+};
+
+/**
+ * @class RecorridoParalelo
+ * @brief Recorre un árbol de directorios con varios hilos y devuelve sus archivos regulares.
+ *
+ * Los directorios pendientes se guardan en una cola compartida; cada hilo toma uno, lee sus
+ * entradas y encola los subdirectorios que encuentra. El recorrido termina cuando la cola está
+ * vacía y ningún hilo está leyendo un directorio. Los enlaces simbólicos se ignoran para no
+ * entrar en ciclos. El directorio excluido se reconoce por su identidad (ver IdentidadDirectorio),
+ * así que se salta aunque el árbol se recorra desde "." o con una ruta absoluta.
+ */
+
+class RecorridoParalelo
+{
+private:
+    deque<string> pendientes;
+    int enProceso;
+    mutex mutex_cola;
+    condition_variable cambio;
+    string rutaExcluida;         // Directorio que no se recorre (por ejemplo, el de salida)
+    IdentidadDirectorio excluir; // Se obtiene al empezar el recorrido, por si aún no existía
+
+    void encolar(const string &directorio)
+    {
+        lock_guard<mutex> lock(mutex_cola);
+        pendientes.push_back(directorio);
+        cambio.notify_one();
+    }
+
+    // Lee un directorio, devuelve sus archivos regulares y encola sus subdirectorios
+    void leerDirectorio(const string &directorio, vector<string> &archivos)
+    {
+#ifdef __linux__
+        int fd = openat(AT_FDCWD, directorio.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            cerr << "No se pudo abrir el directorio " << directorio << endl;
+            return;
+        }
+
+        vector<char> buffer(TAMANO_BUFFER_DIRECTORIO);
+        while (true)
+        {
+            long leidos = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+            if (leidos <= 0)
+                break;
+
+            for (long pos = 0; pos < leidos;)
+            {
+                // Formato de struct linux_dirent64: d_ino, d_off, d_reclen, d_type, d_name
+                const char *entrada = buffer.data() + pos;
+                unsigned short largo;
+                memcpy(&largo, entrada + 16, sizeof(largo));
+                unsigned char tipo = static_cast<unsigned char>(entrada[18]);
+                const char *nombre = entrada + 19;
+                pos += largo;
+
+                if (strcmp(nombre, ".") == 0 || strcmp(nombre, "..") == 0)
+                    continue;
+
+                if (tipo == DT_UNKNOWN)
+                {
+                    // Algunos sistemas de archivos no informan el tipo: se consulta con fstatat
+                    struct stat info;
+                    if (fstatat(fd, nombre, &info, AT_SYMLINK_NOFOLLOW) != 0)
+                        continue;
+                    tipo = S_ISDIR(info.st_mode) ? DT_DIR : (S_ISREG(info.st_mode) ? DT_REG : DT_LNK);
+                }
+
+                string ruta = directorio + nombre;
+                if (tipo == DT_DIR)
+                {
+                    struct stat info;
+                    if (!excluir.valida || fstatat(fd, nombre, &info, AT_SYMLINK_NOFOLLOW) != 0 || !excluir.es(info))
+                        encolar(normalizarDirectorio(ruta));
+                }
+                else if (tipo == DT_REG)
+                    archivos.push_back(ruta);
+            }
+        }
+        close(fd);
+#else
+        DIR *dir = opendir(directorio.c_str());
+        if (dir == nullptr)
+        {
+            cerr << "No se pudo abrir el directorio " << directorio << endl;
+            return;
+        }
+
+        while (struct dirent *entrada = readdir(dir))
+        {
+            string nombre = entrada->d_name;
+            if (nombre == "." || nombre == "..")
+                continue;
+
+            string ruta = directorio + nombre;
+            struct stat info;
+            if (stat(ruta.c_str(), &info) != 0)
+                continue;
+            if (S_ISDIR(info.st_mode))
+            {
+                if (!excluir.es(info))
+                    encolar(normalizarDirectorio(ruta));
+            }
+            else if (S_ISREG(info.st_mode))
+                archivos.push_back(ruta);
+        }
+        closedir(dir);
+#endif
+    }
+
+    void bucleTrabajador(vector<string> &archivos)
+    {
+        while (true)
+        {
+            string directorio;
+            {
+                unique_lock<mutex> lock(mutex_cola);
+                cambio.wait(lock, [this]
+                            { return !pendientes.empty() || enProceso == 0; });
+                if (pendientes.empty())
+                    return; // Nadie está leyendo y no quedan directorios: terminó el recorrido
+                directorio = pendientes.front();
+                pendientes.pop_front();
+                enProceso++;
+            }
+
+            leerDirectorio(directorio, archivos);
+
+            lock_guard<mutex> lock(mutex_cola);
+            enProceso--;
+            cambio.notify_all();
+        }
+    }
+
+public:
+    RecorridoParalelo(const string &directorioExcluido = "") : enProceso(0), rutaExcluida(directorioExcluido) {}
+
+    /**
+     * @brief Devuelve todos los archivos regulares bajo raiz, en orden alfabético.
+     *
+     * @param raiz Directorio raíz del recorrido.
+     * @param numHilos Hilos que leen directorios a la vez; 0 usa hardware_concurrency().
+     */
+    vector<string> recorrer(const string &raiz, int numHilos = 0)
+    {
+        if (numHilos <= 0)
+            numHilos = max(1u, thread::hardware_concurrency());
+
+        excluir = IdentidadDirectorio(rutaExcluida);
+        pendientes.push_back(normalizarDirectorio(raiz));
+
+        vector<vector<string>> porHilo(numHilos);
+        vector<thread> hilos;
+        for (int h = 0; h < numHilos; h++)
+            hilos.emplace_back([this, &porHilo, h]
+                               { bucleTrabajador(porHilo[h]); });
+        for (auto &hilo : hilos)
+            hilo.join();
+
+        vector<string> archivos;
+        for (auto &lista : porHilo)
+            archivos.insert(archivos.end(), lista.begin(), lista.end());
+        sort(archivos.begin(), archivos.end()); // Orden estable entre ejecuciones
+        return archivos;
+    }
+};
+
+/**
+ * @brief Lee una lista de archivos (una ruta por línea). Con "-" se lee la entrada estándar.
+ *
+ * También acepta el manifiesto de un corpus sintético (ver F25_corpus.h): si la primera línea es
+ * su cabecera ("# corpus ..."), se ignoran las líneas que empiezan por '#' y lo que sigue al
+ * primer tabulador. En una lista normal cada línea no vacía es una ruta tal cual.
+ */
+vector<string> leerListaArchivos(const string &rutaLista)
+{
+    vector<string> archivos;
+    ifstream lista;
+    if (rutaLista != "-")
+    {
+        lista.open(rutaLista);
+        if (!lista.is_open())
+        {
+            cerr << "No se pudo abrir la lista " << rutaLista << endl;
+            return archivos;
+        }
+    }
+    istream &entrada = rutaLista == "-" ? cin : lista;
+
+    string linea;
+    bool manifiesto = false, primera = true;
+    while (getline(entrada, linea))
+    {
+        if (!linea.empty() && linea.back() == '\r')
+            linea.pop_back();
+        if (primera)
+            manifiesto = linea.compare(0, 9, "# corpus ") == 0;
+        primera = false;
+        if (linea.empty() || (manifiesto && linea[0] == '#'))
+            continue;
+        archivos.push_back(manifiesto ? linea.substr(0, linea.find('\t')) : linea);
+    }
+    return archivos;
+}
+
+/**
+ * @brief Escapa un campo para el manifiesto CSV.
+ */
+string campoCSV(const string &campo)
+{
+    string escapado = "\"";
+    for (char c : campo)
+    {
+        if (c == '"')
+            escapado += '"';
+        escapado += c;
+    }
+    return escapado + "\"";
+}
+
+/**
+ * @struct ResumenLote
+ * @brief Totales de una ejecución por lotes.
+ */
+
+struct ResumenLote
+{
+    int archivos = 0;
+    int fallidos = 0;
+    long long bytes = 0;
+    double segundos = 0.0;
+};
+
+/**
+ * @struct ResultadosLote
+ * @brief Resultado de cada archivo de un lote, indexado por su posición en la lista.
+ *
+ * Cada hilo escribe solo en las posiciones de los archivos que procesa, así que no hace falta
+ * un mutex para llenarlo.
+ */
+
+struct ResultadosLote
+{
+    vector<double> milisegundos;
+    vector<long long> tamanos;
+    vector<string> hashes;
+    vector<char> correctos;
+
+    ResultadosLote(size_t n) : milisegundos(n, 0.0), tamanos(n, 0), hashes(n), correctos(n, 0) {}
+};
+
+void mostrarInicioLote(const string &titulo, const Temporizador &temporizador_principal, size_t archivos, int numHilos)
+{
+    cout << "================================" << endl;
+    cout << titulo << endl;
+    cout << "================================" << endl;
+    cout << "Tiempo Inicial:     " << temporizador_principal.formatoTextoInicio() << endl;
+    cout << "Archivos:           " << archivos << endl;
+    cout << "Hilos:              " << numHilos << endl;
+    cout << "================================" << endl;
+    cout << endl;
+}
+
+/**
+ * @brief Escribe el manifiesto y muestra el resumen de un lote ya procesado.
+ *
+ * @param titulo Encabezado del bloque final.
+ * @param archivos Rutas procesadas.
+ * @param resultados Resultado de cada archivo.
+ * @param salida Directorio de salida (termina en '/').
+ * @param temporizador_principal Temporizador ya detenido.
+ * @param opciones Opciones del proceso (para los resúmenes del almacén y de etapas).
+ * @param columnaHash Nombre de la columna del hash en el manifiesto.
+ * @return ResumenLote Totales de la ejecución.
+ */
+
+ResumenLote cerrarLote(const string &titulo, const vector<string> &archivos, const ResultadosLote &resultados, const string &salida,
+                       const Temporizador &temporizador_principal, const OpcionesProceso &opciones, const string &columnaHash = "sha256")
+{
+    size_t n = archivos.size();
+    const vector<double> &milisegundos = resultados.milisegundos;
+    const vector<long long> &tamanos = resultados.tamanos;
+
+    ResumenLote resumen;
+    resumen.archivos = static_cast<int>(n);
+    resumen.segundos = temporizador_principal.duracionSegundos();
+    for (size_t k = 0; k < n; k++)
+    {
+        resumen.bytes += max(0LL, tamanos[k]);
+        if (!resultados.correctos[k])
+            resumen.fallidos++;
+    }
+
+    ofstream manifiesto(salida + "manifiesto.csv");
+    manifiesto << "id,ruta,bytes,ms," << columnaHash << ",correcto\n";
+    for (size_t k = 0; k < n; k++)
+    {
+        manifiesto << (k + 1) << "," << campoCSV(archivos[k]) << "," << tamanos[k] << ","
+                   << fixed << setprecision(3) << milisegundos[k] << "," << resultados.hashes[k] << "," << (resultados.correctos[k] ? 1 : 0) << "\n";
+    }
+    manifiesto.close();
+
+    vector<size_t> orden(n);
+    iota(orden.begin(), orden.end(), 0);
+    size_t mostrar = min<size_t>(ARCHIVOS_MAS_LENTOS, n);
+    partial_sort(orden.begin(), orden.begin() + mostrar, orden.end(), [&](size_t a, size_t b)
+                 { return milisegundos[a] > milisegundos[b]; });
+
+    cout << fixed << setprecision(3);
+    cout << "ARCHIVOS MAS LENTOS:" << endl;
+    for (size_t j = 0; j < mostrar; j++)
+    {
+        size_t k = orden[j];
+        cout << setw(12) << milisegundos[k] << " ms  " << setw(12) << tamanos[k] << " B  " << archivos[k] << endl;
+    }
+    cout << "--------------------------------" << endl;
+
+    double segundos = resumen.segundos > 0 ? resumen.segundos : 1e-9;
+    cout << "================================" << endl;
+    cout << titulo << endl;
+    cout << "================================" << endl;
+    cout << "Tiempo Final:       " << temporizador_principal.formatoTextoFin() << endl;
+    cout << "Tiempo Total:       " << temporizador_principal.tiempoTranscurrido() << endl;
+    cout << "Archivos:           " << resumen.archivos << " (" << resumen.fallidos << " fallidos)" << endl;
+    cout << "Bytes:              " << resumen.bytes << endl;
+    cout << "Archivos/s:         " << resumen.archivos / segundos << endl;
+    cout << "MB/s:               " << resumen.bytes / 1e6 / segundos << endl;
+    cout << "Manifiesto:         " << salida << "manifiesto.csv" << endl;
+    cout << "================================" << endl;
+    if (opciones.almacen != nullptr)
+        cout << opciones.almacen->resumen() << endl;
+    if (opciones.tiempos != nullptr)
+        cout << opciones.tiempos->resumen(resumen.segundos) << endl;
+    return resumen;
+}
+
+/**
+ * @brief Procesa un lote de archivos con un grupo fijo de hilos.
+ *
+ * Cada hilo toma el siguiente archivo pendiente de un índice atómico, así que los archivos
+ * grandes no bloquean a los pequeños y la memoria usada no depende del tamaño del lote. Las
+ * salidas del archivo k se escriben en rutaSalida + k + ".sha"/".des", y el manifiesto en
+ * rutaSalida + "manifiesto.csv".
+ *
+ * @param archivos Rutas de los archivos a procesar.
+ * @param rutaSalida Directorio de salida (se crea si no existe).
+ * @param opciones Opciones del proceso.
+ * @param numHilos Cantidad de hilos; 0 usa hardware_concurrency().
+ * @return ResumenLote Totales de la ejecución.
+ */
+
+ResumenLote mainLote(const vector<string> &archivos, const string &rutaSalida, const OpcionesProceso &opciones = OpcionesProceso(), int numHilos = 0)
+{
+    cout << endl;
+
+    Temporizador temporizador_principal;
+    const string salida = normalizarDirectorio(rutaSalida);
+    crearDirectorio(salida);
+
+    if (numHilos <= 0)
+        numHilos = max(1u, thread::hardware_concurrency());
+
+    mostrarInicioLote("      INICIO PROCESO LOTE       ", temporizador_principal, archivos.size(), numHilos);
+
+    size_t n = archivos.size();
+    ResultadosLote resultados(n);
+    atomic<size_t> siguiente(0);
+
+    vector<thread> hilos;
+    for (int h = 0; h < numHilos; h++)
+    {
+        hilos.emplace_back([&]
+                           {
+            for (size_t k = siguiente++; k < n; k = siguiente++)
+            {
+                auto inicio = chrono::steady_clock::now();
+                SpanTraza span("archivo", static_cast<int>(k + 1));
+                ResultadoProceso r = procesarArchivo(archivos[k], "", salida + to_string(k + 1), opciones);
+                auto fin = chrono::steady_clock::now();
+
+                resultados.milisegundos[k] = chrono::duration_cast<chrono::nanoseconds>(fin - inicio).count() / 1e6;
+                resultados.tamanos[k] = devolverTamanoArchivo(archivos[k]);
+                resultados.hashes[k] = r.hash;
+                resultados.correctos[k] = r.hashesIguales && r.contenidoIgual;
+            } });
+    }
+    for (auto &hilo : hilos)
+        hilo.join();
+
+    temporizador_principal.detener();
+    return cerrarLote("       FIN PROCESO LOTE         ", archivos, resultados, salida, temporizador_principal, opciones);
+}
+
+#endif // F13_LOTE_H
@@ -0,0 +1,238 @@
+/**
+ * @file F14_pool_hilos.h
+ * @brief Pool de hilos de tamaño fijo con cola de trabajos acotada.
+ *
+ * Sustituye el modelo de un hilo por copia de mainParalelo. El pool lanza una cantidad fija de
+ * hilos (por defecto hardware_concurrency()) que toman trabajos de una cola con capacidad
+ * limitada: si la cola está llena, enviar() bloquea al productor hasta que haya espacio. Así
+ * la memoria usada no crece con la cantidad de trabajos, aunque sean cientos de miles.
+ *
+ * Los resultados se devuelven con un future o, si se prefiere no guardarlos, con una función
+ * de retorno (callback) que se ejecuta en el hilo trabajador.
+ *
+ * La cantidad de hilos que toman trabajos se puede reducir y ampliar en marcha (ajustarActivos),
+ * y el pool lleva la cuenta de trabajos terminados y del tiempo que esperaron en la cola, para
+ * que un controlador externo ajuste la concurrencia según el rendimiento observado.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F22_traza.h: Da nombre a la fila de cada hilo en la traza.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F14_POOL_HILOS_H
+#define F14_POOL_HILOS_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F22_traza.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+
+/**
+ * @class PoolHilos
+ * @brief Grupo fijo de hilos que ejecuta trabajos tomados de una cola acotada.
+ */
+
+class PoolHilos
+{
+private:
+    struct TrabajoEncolado
+    {
+        function<void()> funcion;
+        chrono::steady_clock::time_point encolado;
+    };
+
+    vector<thread> hilos;
+    deque<TrabajoEncolado> cola;
+    size_t capacidad;
+    int activos;         // Trabajos que se están ejecutando en este momento
+    int hilosPermitidos; // Solo los hilos con índice menor toman trabajos
+    atomic<long long> terminados;
+    atomic<long long> esperaColaNs; // Suma del tiempo que esperaron en la cola los trabajos tomados
+    bool detener;
+    mutex mutex_cola;
+    condition_variable hayTrabajo, hayEspacio, sinTrabajo;
+    function<void(int)> alIniciarHilo; // Se ejecuta en cada hilo antes de tomar trabajos
+
+    static int &indiceActual()
+    {
+        thread_local int indice = -1;
+        return indice;
+    }
+
+    void bucleTrabajador(int indice)
+    {
+        indiceActual() = indice;
+        nombrarHiloTraza("trabajador " + to_string(indice));
+        if (alIniciarHilo)
+            alIniciarHilo(indice);
+        while (true)
+        {
+            function<void()> trabajo;
+            {
+                unique_lock<mutex> lock(mutex_cola);
+                hayTrabajo.wait(lock, [this, indice]
+                                { return detener || (!cola.empty() && indice < hilosPermitidos); });
+                if (cola.empty())
+                    return;
+                trabajo = move(cola.front().funcion);
+                esperaColaNs += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - cola.front().encolado).count();
+                cola.pop_front();
+                activos++;
+            }
+            hayEspacio.notify_one();
+
+            trabajo();
+
+            terminados++;
+            lock_guard<mutex> lock(mutex_cola);
+            activos--;
+            if (activos == 0 && cola.empty())
+                sinTrabajo.notify_all();
+        }
+    }
+
+    void encolar(function<void()> trabajo)
+    {
+        bool limitado;
+        {
+            unique_lock<mutex> lock(mutex_cola);
+            hayEspacio.wait(lock, [this]
+                            { return cola.size() < capacidad; });
+            cola.push_back({move(trabajo), chrono::steady_clock::now()});
+            limitado = hilosPermitidos < numeroHilos();
+        }
+        // Con hilos limitados, notify_one podría despertar a uno sin permiso y dejar el trabajo
+        // en la cola con los permitidos dormidos: se despierta a todos y cada uno lo comprueba
+        if (limitado)
+            hayTrabajo.notify_all();
+        else
+            hayTrabajo.notify_one();
+    }
+
+public:
+    /**
+     * @brief Lanza los hilos del pool.
+     *
+     * @param numHilos Cantidad de hilos; 0 usa hardware_concurrency().
+     * @param capacidadCola Trabajos que pueden esperar en la cola; 0 usa 4 por hilo.
+     * @param alIniciar Función opcional que recibe el índice de cada hilo al arrancar (p. ej. para fijarlo a una CPU).
+     */
+    PoolHilos(int numHilos = 0, size_t capacidadCola = 0, function<void(int)> alIniciar = nullptr)
+        : activos(0), terminados(0), esperaColaNs(0), detener(false), alIniciarHilo(move(alIniciar))
+    {
+        if (numHilos <= 0)
+            numHilos = max(1u, thread::hardware_concurrency());
+        hilosPermitidos = numHilos;
+        capacidad = capacidadCola > 0 ? capacidadCola : 4 * static_cast<size_t>(numHilos);
+
+        for (int h = 0; h < numHilos; h++)
+            hilos.emplace_back([this, h]
+                               { bucleTrabajador(h); });
+    }
+
+    /**
+     * @brief Termina los trabajos pendientes y espera a los hilos.
+     */
+    ~PoolHilos()
+    {
+        {
+            lock_guard<mutex> lock(mutex_cola);
+            detener = true;
+        }
+        hayTrabajo.notify_all();
+        for (auto &hilo : hilos)
+            hilo.join();
+    }
+
+    int numeroHilos() const { return static_cast<int>(hilos.size()); }
+
+    /**
+     * @brief Limita cuántos hilos toman trabajos (entre 1 y numeroHilos()).
+     *
+     * Los hilos sobrantes terminan su trabajo actual y se quedan dormidos hasta que se amplíe
+     * el límite; no se crean ni destruyen hilos.
+     */
+    void ajustarActivos(int n)
+    {
+        {
+            lock_guard<mutex> lock(mutex_cola);
+            hilosPermitidos = max(1, min(n, numeroHilos()));
+        }
+        hayTrabajo.notify_all();
+    }
+
+    int hilosActivos()
+    {
+        lock_guard<mutex> lock(mutex_cola);
+        return hilosPermitidos;
+    }
+
+    size_t trabajosEnCola()
+    {
+        lock_guard<mutex> lock(mutex_cola);
+        return cola.size();
+    }
+
+    long long trabajosTerminados() const { return terminados; }
+    long long esperaEnColaNs() const { return esperaColaNs; }
+
+    /**
+     * @brief Despierta a todos los hilos para que vuelvan a mirar la cola.
+     *
+     * No hace falta en uso normal; el controlador lo llama en cada periodo como salvaguarda.
+     */
+    void despertarTrabajadores() { hayTrabajo.notify_all(); }
+
+    /**
+     * @brief Índice (0..numeroHilos()-1) del hilo del pool que llama, o -1 fuera del pool.
+     *
+     * Permite que cada trabajo escriba en estructuras propias de su hilo sin bloqueos.
+     */
+    static int hiloActual() { return indiceActual(); }
+
+    /**
+     * @brief Envía un trabajo y devuelve un future con su resultado.
+     *
+     * Bloquea si la cola está llena.
+     */
+    template <typename F>
+    auto enviar(F funcion) -> future<decltype(funcion())>
+    {
+        typedef decltype(funcion()) Resultado;
+        auto tarea = make_shared<packaged_task<Resultado()>>(move(funcion));
+        future<Resultado> resultado = tarea->get_future();
+        encolar([tarea]
+                { (*tarea)(); });
+        return resultado;
+    }
+
+    /**
+     * @brief Envía un trabajo cuyo resultado se entrega a una función de retorno.
+     *
+     * La función de retorno se ejecuta en el hilo trabajador. Bloquea si la cola está llena.
+     */
+    template <typename F, typename C>
+    void enviar(F funcion, C alTerminar)
+    {
+        encolar([funcion, alTerminar]() mutable
+                { alTerminar(funcion()); });
+    }
+
+    /**
+     * @brief Bloquea hasta que la cola está vacía y ningún hilo ejecuta un trabajo.
+     */
+    void esperarTodo()
+    {
+        unique_lock<mutex> lock(mutex_cola);
+        sinTrabajo.wait(lock, [this]
+                        { return activos == 0 && cola.empty(); });
+    }
+};
+
+#endif // F14_POOL_HILOS_H
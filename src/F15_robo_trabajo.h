@@ -0,0 +1,524 @@
+/**
+ * @file F15_robo_trabajo.h
+ * @brief Ejecutor con robo de trabajo (work stealing) y división de archivos en fragmentos.
+ *
+ * Cuando un archivo grande cae entre muchos pequeños, repartir los archivos de forma fija deja
+ * hilos ociosos mientras uno termina el rezagado. Aquí cada hilo tiene su propia deque de
+ * Chase–Lev: el dueño apila y desapila por el fondo sin bloqueos, y los hilos ociosos roban
+ * tareas por el tope. Cada archivo se divide además en fragmentos (cifrado y hash por
+ * fragmento) que cualquier hilo puede robar, así que un archivo grande se reparte entre todos.
+ *
+ * El hash de un archivo fragmentado es un hash en árbol: el SHA-256 de la concatenación de los
+ * SHA-256 (en hexadecimal) de cada fragmento. Si el archivo cabe en un solo fragmento, coincide
+ * con el SHA-256 normal. La salida .sha es idéntica a la de encriptarArchivo; el descifrado se
+ * verifica en memoria fragmento por fragmento, sin escribir el .des.
+ *
+ * Requiere E/S POSIX (pread/pwrite).
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F13_lote.h: Proporciona ResultadosLote, cerrarLote y las operaciones de F01.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F15_ROBO_TRABAJO_H
+#define F15_ROBO_TRABAJO_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F13_lote.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <random>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @def CAPACIDAD_DEQUE_ROBO
+ * @brief Tareas que caben en la deque de cada hilo (potencia de 2).
+ */
+
+#define CAPACIDAD_DEQUE_ROBO 4096
+
+/**
+ * @def TAMANO_FRAGMENTO_ROBO
+ * @brief Tamaño por defecto de los fragmentos en que se divide cada archivo (1 MiB).
+ */
+
+#define TAMANO_FRAGMENTO_ROBO (1024 * 1024)
+
+/**
+ * @class DequeChaseLev
+ * @brief Deque de trabajo de Chase–Lev de capacidad fija.
+ *
+ * Solo el hilo dueño llama a empujar() y sacar() (por el fondo); cualquier hilo puede llamar a
+ * robar() (por el tope). Sigue la formulación de Lê, Pop, Cohen y Zappa Nardelli (2013) para
+ * modelos de memoria débiles. Tope y fondo van en líneas de caché separadas.
+ */
+
+template <typename T>
+class DequeChaseLev
+{
+private:
+    unique_ptr<atomic<T *>[]> buffer;
+    long long mascara;
+    alignas(64) atomic<long long> tope;
+    alignas(64) atomic<long long> fondo;
+
+public:
+    DequeChaseLev(long long capacidad = CAPACIDAD_DEQUE_ROBO)
+        : buffer(new atomic<T *>[capacidad]), mascara(capacidad - 1), tope(0), fondo(0) {}
+
+    /**
+     * @brief Agrega una tarea por el fondo (solo el dueño).
+     * @return bool false si la deque está llena.
+     */
+    bool empujar(T *x)
+    {
+        long long b = fondo.load(memory_order_relaxed);
+        long long t = tope.load(memory_order_acquire);
+        if (b - t > mascara)
+            return false;
+        buffer[b & mascara].store(x, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        fondo.store(b + 1, memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Saca la última tarea agregada (solo el dueño).
+     * @return T* La tarea, o nullptr si la deque está vacía o un ladrón ganó la última.
+     */
+    T *sacar()
+    {
+        long long b = fondo.load(memory_order_relaxed) - 1;
+        fondo.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        long long t = tope.load(memory_order_relaxed);
+
+        if (t > b)
+        {
+            fondo.store(b + 1, memory_order_relaxed);
+            return nullptr;
+        }
+
+        T *x = buffer[b & mascara].load(memory_order_relaxed);
+        if (t == b)
+        {
+            // Queda una sola tarea: se compite con los ladrones por ella
+            if (!tope.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+                x = nullptr;
+            fondo.store(b + 1, memory_order_relaxed);
+        }
+        return x;
+    }
+
+    /**
+     * @brief Roba la tarea más antigua (cualquier hilo).
+     * @return T* La tarea, o nullptr si está vacía o se perdió la carrera.
+     */
+    T *robar()
+    {
+        long long t = tope.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        long long b = fondo.load(memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+
+        T *x = buffer[t & mascara].load(memory_order_relaxed);
+        if (!tope.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+            return nullptr;
+        return x;
+    }
+};
+
+/**
+ * @struct TareaRobo
+ * @brief Tarea del ejecutor con robo de trabajo.
+ */
+
+struct TareaRobo
+{
+    function<void()> funcion;
+};
+
+/**
+ * @class EjecutorRoboTrabajo
+ * @brief Pool de hilos en el que cada hilo tiene su deque y roba de las de los demás.
+ *
+ * Las tareas enviadas desde fuera del pool van a una cola global; las que genera una tarea en
+ * ejecución van a la deque del hilo que la ejecuta. Un hilo sin trabajo busca primero en su
+ * deque, luego roba de otro hilo elegido al azar y por último mira la cola global.
+ */
+
+class EjecutorRoboTrabajo
+{
+private:
+    struct Trabajador
+    {
+        DequeChaseLev<TareaRobo> deque;
+        atomic<long long> ejecutadas{0};
+        atomic<long long> robadas{0};
+    };
+
+    vector<unique_ptr<Trabajador>> trabajadores;
+    vector<thread> hilos;
+    deque<TareaRobo *> global;
+    mutex mutex_global;
+    condition_variable hayTareas, sinTareas;
+    atomic<long long> pendientes;
+    atomic<int> durmiendo;
+    bool detener;
+
+    // Ejecutor e índice del trabajador que corre en el hilo actual (-1 si no es un trabajador)
+    static EjecutorRoboTrabajo *&ejecutorActual()
+    {
+        thread_local EjecutorRoboTrabajo *ejecutor = nullptr;
+        return ejecutor;
+    }
+    static int &indiceActual()
+    {
+        thread_local int indice = -1;
+        return indice;
+    }
+
+    void despertar()
+    {
+        if (durmiendo > 0)
+        {
+            lock_guard<mutex> lock(mutex_global);
+            hayTareas.notify_one();
+        }
+    }
+
+    void ejecutar(TareaRobo *tarea, Trabajador &yo)
+    {
+        tarea->funcion();
+        delete tarea;
+        yo.ejecutadas++;
+        if (--pendientes == 0)
+        {
+            lock_guard<mutex> lock(mutex_global);
+            sinTareas.notify_all();
+        }
+    }
+
+    TareaRobo *buscarTarea(int indice, mt19937 &azar)
+    {
+        Trabajador &yo = *trabajadores[indice];
+        if (TareaRobo *tarea = yo.deque.sacar())
+            return tarea;
+
+        int n = static_cast<int>(trabajadores.size());
+        int inicio = static_cast<int>(azar() % n);
+        for (int k = 0; k < n; k++)
+        {
+            int victima = (inicio + k) % n;
+            if (victima == indice)
+                continue;
+            if (TareaRobo *tarea = trabajadores[victima]->deque.robar())
+            {
+                yo.robadas++;
+                return tarea;
+            }
+        }
+
+        lock_guard<mutex> lock(mutex_global);
+        if (!global.empty())
+        {
+            TareaRobo *tarea = global.front();
+            global.pop_front();
+            return tarea;
+        }
+        return nullptr;
+    }
+
+    void bucleTrabajador(int indice)
+    {
+        ejecutorActual() = this;
+        indiceActual() = indice;
+        mt19937 azar(indice + 1);
+
+        while (true)
+        {
+            TareaRobo *tarea = buscarTarea(indice, azar);
+            if (tarea != nullptr)
+            {
+                ejecutar(tarea, *trabajadores[indice]);
+                continue;
+            }
+
+            // Sin trabajo visible: se duerme un momento (una deque ajena puede llenarse sin aviso)
+            unique_lock<mutex> lock(mutex_global);
+            if (detener && pendientes == 0)
+                return;
+            durmiendo++;
+            hayTareas.wait_for(lock, chrono::microseconds(200));
+            durmiendo--;
+        }
+    }
+
+public:
+    /**
+     * @brief Lanza los hilos del ejecutor.
+     *
+     * @param numHilos Cantidad de hilos; 0 usa hardware_concurrency().
+     */
+    EjecutorRoboTrabajo(int numHilos = 0) : pendientes(0), durmiendo(0), detener(false)
+    {
+        if (numHilos <= 0)
+            numHilos = max(1u, thread::hardware_concurrency());
+        for (int h = 0; h < numHilos; h++)
+            trabajadores.emplace_back(new Trabajador());
+        for (int h = 0; h < numHilos; h++)
+            hilos.emplace_back([this, h]
+                               { bucleTrabajador(h); });
+    }
+
+    ~EjecutorRoboTrabajo()
+    {
+        esperarTodo();
+        {
+            lock_guard<mutex> lock(mutex_global);
+            detener = true;
+        }
+        hayTareas.notify_all();
+        for (auto &hilo : hilos)
+            hilo.join();
+    }
+
+    int numeroHilos() const { return static_cast<int>(hilos.size()); }
+
+    /**
+     * @brief Agrega una tarea. Desde un trabajador va a su deque; desde fuera, a la cola global.
+     */
+    void generar(function<void()> funcion)
+    {
+        TareaRobo *tarea = new TareaRobo{move(funcion)};
+        pendientes++;
+
+        if (ejecutorActual() == this && trabajadores[indiceActual()]->deque.empujar(tarea))
+        {
+            despertar();
+            return;
+        }
+
+        lock_guard<mutex> lock(mutex_global);
+        global.push_back(tarea);
+        hayTareas.notify_one();
+    }
+
+    /**
+     * @brief Bloquea hasta que no quedan tareas pendientes (no llamar desde un trabajador).
+     */
+    void esperarTodo()
+    {
+        unique_lock<mutex> lock(mutex_global);
+        sinTareas.wait(lock, [this]
+                       { return pendientes == 0; });
+    }
+
+    long long totalRobadas() const
+    {
+        long long total = 0;
+        for (const auto &t : trabajadores)
+            total += t->robadas;
+        return total;
+    }
+};
+
+/**
+ * @struct TrabajoArchivoFragmentado
+ * @brief Estado compartido por los fragmentos de un mismo archivo.
+ */
+
+struct TrabajoArchivoFragmentado
+{
+    string entrada, salida;
+    long long tamano = 0;
+    vector<string> digestos;      // SHA-256 de cada fragmento
+    atomic<int> restantes{0};     // Fragmentos que faltan por terminar
+    atomic<bool> correcto{true};  // Todos los fragmentos se verificaron
+    string hashArbol;             // Hash final (lo calcula el último fragmento)
+    chrono::steady_clock::time_point inicio, fin;
+};
+
+/**
+ * @brief Hash en árbol a partir de los SHA-256 (en hexadecimal) de los fragmentos, en orden.
+ *
+ * Con un solo fragmento es su propio hash; sin fragmentos (archivo vacío), el de la entrada vacía.
+ */
+
+string calcularHashArbol(const vector<string> &digestos)
+{
+    if (digestos.size() <= 1)
+        return digestos.empty() ? sha256().sha_digest() : digestos[0];
+    string concatenados;
+    for (const string &d : digestos)
+        concatenados += d;
+    sha256 contexto;
+    return contexto.sha_return(concatenados);
+}
+
+/**
+ * @brief Cifra, verifica y calcula el hash de un fragmento de un archivo.
+ *
+ * Lee [desplazamiento, desplazamiento + largo) de la entrada, escribe su cifrado en la misma
+ * posición de la salida, comprueba que descifrarlo reproduce el bloque leído y guarda el
+ * SHA-256 del bloque.
+ */
+
+bool procesarFragmento(TrabajoArchivoFragmentado &trabajo, int indice, long long desplazamiento, long long largo)
+{
+    SpanTraza span("fragmento");
+    int fdEntrada = open(trabajo.entrada.c_str(), O_RDONLY);
+    int fdSalida = open(trabajo.salida.c_str(), O_WRONLY);
+    bool correcto = fdEntrada >= 0 && fdSalida >= 0 && largo >= 0;
+
+    char *bloque = bufferLocal(0, largo), *cifrado = bufferLocal(1, largo);
+    if (correcto)
+        correcto = pread(fdEntrada, bloque, largo, desplazamiento) == largo;
+
+    if (correcto)
+    {
+        encriptarBloque(bloque, cifrado, largo);
+        correcto = pwrite(fdSalida, cifrado, largo, desplazamiento) == largo;
+    }
+
+    for (long long j = 0; correcto && j < largo; j++)
+    {
+        if (desencriptarCaracter(cifrado[j]) != bloque[j])
+            correcto = false;
+    }
+
+    if (correcto && largo > 0)
+    {
+        sha256 contexto;
+        contexto.sha_append(reinterpret_cast<const BYTE *>(bloque), largo);
+        trabajo.digestos[indice] = contexto.sha_digest();
+    }
+
+    if (fdEntrada >= 0)
+        close(fdEntrada);
+    if (fdSalida >= 0)
+        close(fdSalida);
+    return correcto;
+}
+
+/**
+ * @brief Envía un archivo al ejecutor dividido en fragmentos robables.
+ *
+ * Una primera tarea prepara la salida (con el tamaño final) y genera una tarea por fragmento;
+ * el último fragmento en terminar calcula el hash en árbol y marca el fin del archivo.
+ *
+ * @param ejecutor Ejecutor donde se generan las tareas.
+ * @param trabajo Estado del archivo; debe seguir vivo hasta que termine.
+ * @param tamanoFragmento Tamaño de cada fragmento en bytes.
+ */
+
+void enviarArchivoFragmentado(EjecutorRoboTrabajo &ejecutor, TrabajoArchivoFragmentado &trabajo, long long tamanoFragmento = TAMANO_FRAGMENTO_ROBO)
+{
+    TrabajoArchivoFragmentado *t = &trabajo;
+    EjecutorRoboTrabajo *e = &ejecutor;
+
+    ejecutor.generar([t, e, tamanoFragmento]
+                     {
+        t->inicio = chrono::steady_clock::now();
+        t->tamano = max(0LL, devolverTamanoArchivo(t->entrada));
+
+        int fd = open(t->salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, t->tamano) != 0)
+        {
+            t->correcto = false;
+            t->fin = chrono::steady_clock::now();
+            if (fd >= 0)
+                close(fd);
+            return;
+        }
+        close(fd);
+
+        int fragmentos = static_cast<int>((t->tamano + tamanoFragmento - 1) / tamanoFragmento);
+        if (fragmentos == 0)
+        {
+            t->hashArbol = calcularHashArbol(t->digestos); // Archivo vacío: el hash de la entrada vacía
+            t->fin = chrono::steady_clock::now();
+            return;
+        }
+
+        t->digestos.assign(fragmentos, "");
+        t->restantes = fragmentos;
+        for (int k = 0; k < fragmentos; k++)
+        {
+            long long desplazamiento = k * tamanoFragmento;
+            long long largo = min(tamanoFragmento, t->tamano - desplazamiento);
+            e->generar([t, k, desplazamiento, largo]
+                       {
+                if (!procesarFragmento(*t, k, desplazamiento, largo))
+                    t->correcto = false;
+
+                if (--t->restantes == 0)
+                {
+                    t->hashArbol = calcularHashArbol(t->digestos);
+                    t->fin = chrono::steady_clock::now();
+                } });
+        } });
+}
+
+/**
+ * @brief Procesa un lote de archivos con el ejecutor de robo de trabajo.
+ *
+ * Cada archivo k se cifra en rutaSalida + k + ".sha" y se verifica en memoria. El manifiesto
+ * registra el hash en árbol de cada archivo (columna sha256_arbol).
+ *
+ * @param archivos Rutas de los archivos a procesar.
+ * @param rutaSalida Directorio de salida (se crea si no existe).
+ * @param numHilos Cantidad de hilos; 0 usa hardware_concurrency().
+ * @param tamanoFragmento Tamaño de cada fragmento en bytes.
+ * @return ResumenLote Totales de la ejecución.
+ */
+
+ResumenLote mainRoboTrabajo(const vector<string> &archivos, const string &rutaSalida, int numHilos = 0, long long tamanoFragmento = TAMANO_FRAGMENTO_ROBO)
+{
+    cout << endl;
+
+    Temporizador temporizador_principal;
+    const string salida = normalizarDirectorio(rutaSalida);
+    crearDirectorio(salida);
+
+    size_t n = archivos.size();
+    vector<unique_ptr<TrabajoArchivoFragmentado>> trabajos;
+    long long robadas = 0;
+    {
+        EjecutorRoboTrabajo ejecutor(numHilos);
+        mostrarInicioLote("  INICIO PROCESO ROBO TRABAJO   ", temporizador_principal, n, ejecutor.numeroHilos());
+
+        for (size_t k = 0; k < n; k++)
+        {
+            trabajos.emplace_back(new TrabajoArchivoFragmentado());
+            trabajos.back()->entrada = archivos[k];
+            trabajos.back()->salida = salida + to_string(k + 1) + ".sha";
+            enviarArchivoFragmentado(ejecutor, *trabajos.back(), tamanoFragmento);
+        }
+        ejecutor.esperarTodo();
+        robadas = ejecutor.totalRobadas();
+    }
+
+    temporizador_principal.detener();
+
+    ResultadosLote resultados(n);
+    for (size_t k = 0; k < n; k++)
+    {
+        const TrabajoArchivoFragmentado &t = *trabajos[k];
+        resultados.milisegundos[k] = chrono::duration_cast<chrono::nanoseconds>(t.fin - t.inicio).count() / 1e6;
+        resultados.tamanos[k] = t.tamano;
+        resultados.hashes[k] = t.hashArbol;
+        resultados.correctos[k] = t.correcto;
+    }
+
+    cout << "Tareas robadas:     " << robadas << endl;
+    return cerrarLote("   FIN PROCESO ROBO TRABAJO     ", archivos, resultados, salida, temporizador_principal, OpcionesProceso(), "sha256_arbol");
+}
+
+#endif // F15_ROBO_TRABAJO_H
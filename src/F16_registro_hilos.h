@@ -0,0 +1,96 @@
+/**
+ * @file F16_registro_hilos.h
+ * @brief Registro de tiempos por hilo, sin bloqueos, para los modos paralelos.
+ *
+ * Antes cada hilo tomaba un mutex para agregar su marca al Temporizador compartido, y la
+ * "duración" de un proceso era la distancia entre dos finalizaciones cualesquiera. Aquí cada
+ * hilo escribe en su propio buffer (alineado a una línea de caché para no compartirla con los
+ * vecinos) el inicio y el fin reales de cada proceso que ejecuta. Los buffers se combinan al
+ * terminar, cuando ya no hay hilos escribiendo.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F16_REGISTRO_HILOS_H
+#define F16_REGISTRO_HILOS_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include <algorithm>
+
+/**
+ * @struct RegistroProceso
+ * @brief Inicio, fin y resultado de un proceso, tomados por el hilo que lo ejecutó.
+ */
+
+struct RegistroProceso
+{
+    int id;
+    int hilo;
+    chrono::steady_clock::time_point inicio;
+    chrono::steady_clock::time_point fin;
+    bool correcto; // Hashes y contenido coinciden
+
+    double segundos() const
+    {
+        return chrono::duration_cast<chrono::nanoseconds>(fin - inicio).count() / 1e9;
+    }
+};
+
+/**
+ * @struct BufferRegistros
+ * @brief Registros de un solo hilo. Ocupa líneas de caché propias.
+ */
+
+struct alignas(64) BufferRegistros
+{
+    vector<RegistroProceso> registros;
+};
+
+/**
+ * @class RegistroPorHilo
+ * @brief Un buffer de registros por hilo; cada hilo solo escribe en el suyo.
+ *
+ * registrar() no toma ningún bloqueo: es seguro siempre que dos hilos no usen el mismo índice
+ * a la vez. combinar() debe llamarse cuando ya terminaron todos los hilos.
+ */
+
+class RegistroPorHilo
+{
+private:
+    vector<BufferRegistros> buffers;
+
+public:
+    RegistroPorHilo(int numHilos) : buffers(max(1, numHilos)) {}
+
+    /**
+     * @brief Reserva espacio en cada buffer para no realocar durante la medición.
+     */
+    void reservar(size_t porHilo)
+    {
+        for (auto &buffer : buffers)
+            buffer.registros.reserve(porHilo);
+    }
+
+    void registrar(int hilo, int id, chrono::steady_clock::time_point inicio, chrono::steady_clock::time_point fin, bool correcto)
+    {
+        buffers[hilo].registros.push_back({id, hilo, inicio, fin, correcto});
+    }
+
+    /**
+     * @brief Une los registros de todos los hilos, ordenados por instante de fin.
+     */
+    vector<RegistroProceso> combinar() const
+    {
+        vector<RegistroProceso> todos;
+        for (const auto &buffer : buffers)
+            todos.insert(todos.end(), buffer.registros.begin(), buffer.registros.end());
+        sort(todos.begin(), todos.end(), [](const RegistroProceso &a, const RegistroProceso &b)
+             { return a.fin < b.fin; });
+        return todos;
+    }
+};
+
+#endif // F16_REGISTRO_HILOS_H
@@ -0,0 +1,365 @@
+/**
+ * @file F17_afinidad.h
+ * @brief Colocación de los hilos trabajadores en núcleos y nodos NUMA, y buffers locales a cada nodo.
+ *
+ * En máquinas con varios sockets el planificador mueve los hilos de un núcleo a otro y sus
+ * buffers terminan en la memoria de otro nodo. Este módulo:
+ * - Lee la topología (CPU, núcleo, paquete y nodo NUMA) de /sys/devices/system.
+ * - Reparte los hilos en CPUs según una política: round-robin, compacta o dispersa.
+ * - Fija cada hilo a su CPU (pthread_setaffinity_np) y recuerda su nodo.
+ * - Entrega a cada hilo buffers de E/S y de cifrado reservados en su nodo (mbind con
+ *   MPOL_PREFERRED y primer toque desde el propio hilo).
+ *
+ * Con nodos simulados las CPUs se dividen en grupos contiguos que se tratan como nodos; en ese
+ * caso no se llama a mbind y solo cuenta el primer toque. Fuera de Linux todo es una operación
+ * vacía. Los buffers salen del pool de buffers del hilo (F27_pool_buffers.h).
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F27_pool_buffers.h: Proporciona los buffers que se entregan a cada hilo.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F17_AFINIDAD_H
+#define F17_AFINIDAD_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F27_pool_buffers.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @def RANURAS_BUFFER_LOCAL
+ * @brief Cantidad de buffers independientes que cada hilo puede pedir a bufferLocal().
+ */
+#define RANURAS_BUFFER_LOCAL 3
+
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE (1 << 1)
+#endif
+
+enum PoliticaAfinidad
+{
+    AFINIDAD_NINGUNA,     // Sin fijar: el planificador del sistema decide
+    AFINIDAD_ROUND_ROBIN, // Hilo h en la CPU h mod nCPUs, en orden de numeración
+    AFINIDAD_COMPACTA,    // Llena un nodo (y sus hermanos de núcleo) antes de pasar al siguiente
+    AFINIDAD_DISPERSA     // Alterna entre nodos y luego entre núcleos físicos distintos
+};
+
+const char *nombresAfinidad[] = {"ninguna", "round-robin", "compacta", "dispersa"};
+
+// Convierte el nombre de la línea de comandos en una política; devuelve false si no lo reconoce
+bool leerPoliticaAfinidad(const string &nombre, PoliticaAfinidad &politica)
+{
+    for (int p = AFINIDAD_NINGUNA; p <= AFINIDAD_DISPERSA; p++)
+    {
+        if (nombre == nombresAfinidad[p])
+        {
+            politica = static_cast<PoliticaAfinidad>(p);
+            return true;
+        }
+    }
+    return false;
+}
+
+struct CPUInfo
+{
+    int cpu;
+    int nucleo;
+    int paquete;
+    int nodo;
+};
+
+// Lee un entero de un archivo de /sys; devuelve porDefecto si no existe
+int leerEnteroSys(const string &ruta, int porDefecto)
+{
+    ifstream archivo(ruta);
+    int valor;
+    if (archivo >> valor)
+        return valor;
+    return porDefecto;
+}
+
+// Interpreta una lista de CPUs del kernel ("0-3,8,10-11")
+vector<int> leerListaCPUs(const string &texto)
+{
+    vector<int> cpus;
+    stringstream flujo(texto);
+    string rango;
+    while (getline(flujo, rango, ','))
+    {
+        if (rango.empty() || rango == "\n")
+            continue;
+        size_t guion = rango.find('-');
+        int desde = atoi(rango.c_str());
+        int hasta = guion == string::npos ? desde : atoi(rango.c_str() + guion + 1);
+        for (int c = desde; c <= hasta; c++)
+            cpus.push_back(c);
+    }
+    return cpus;
+}
+
+/**
+ * @class TopologiaCPU
+ * @brief CPUs disponibles para el proceso con su núcleo, paquete y nodo NUMA.
+ */
+
+class TopologiaCPU
+{
+private:
+    vector<CPUInfo> cpus;
+    int numNodos;
+    bool simulada;
+
+public:
+    /**
+     * @brief Detecta la topología del sistema.
+     *
+     * @param nodosSimulados Si es mayor que 0, reparte las CPUs en esa cantidad de nodos ficticios.
+     */
+    TopologiaCPU(int nodosSimulados = 0) : numNodos(1), simulada(nodosSimulados > 0)
+    {
+#ifdef __linux__
+        cpu_set_t permitidas;
+        CPU_ZERO(&permitidas);
+        sched_getaffinity(0, sizeof(permitidas), &permitidas);
+
+        map<int, int> nodoDeCPU;
+        int nodosSistema = 0;
+        for (int n = 0;; n++)
+        {
+            ifstream lista("/sys/devices/system/node/node" + to_string(n) + "/cpulist");
+            if (!lista.is_open())
+                break;
+            string texto;
+            getline(lista, texto);
+            for (int c : leerListaCPUs(texto))
+                nodoDeCPU[c] = n;
+            nodosSistema = n + 1;
+        }
+
+        for (int c = 0; c < CPU_SETSIZE; c++)
+        {
+            if (!CPU_ISSET(c, &permitidas))
+                continue;
+            string base = "/sys/devices/system/cpu/cpu" + to_string(c) + "/topology/";
+            CPUInfo info;
+            info.cpu = c;
+            info.nucleo = leerEnteroSys(base + "core_id", c);
+            info.paquete = leerEnteroSys(base + "physical_package_id", 0);
+            info.nodo = nodoDeCPU.count(c) ? nodoDeCPU[c] : 0;
+            cpus.push_back(info);
+        }
+        numNodos = max(1, nodosSistema);
+#endif
+        if (cpus.empty())
+        {
+            int n = max(1u, thread::hardware_concurrency());
+            for (int c = 0; c < n; c++)
+                cpus.push_back({c, c, 0, 0});
+        }
+
+        if (simulada)
+        {
+            // Grupos contiguos de CPUs, como en una numeración típica por socket
+            numNodos = min<int>(nodosSimulados, cpus.size());
+            for (size_t k = 0; k < cpus.size(); k++)
+                cpus[k].nodo = k * numNodos / cpus.size();
+        }
+    }
+
+    const vector<CPUInfo> &getCPUs() const { return cpus; }
+    int getNumNodos() const { return numNodos; }
+    bool esSimulada() const { return simulada; }
+
+    /**
+     * @brief CPUs en el orden en que se asignan a los hilos según la política.
+     */
+    vector<CPUInfo> ordenar(PoliticaAfinidad politica) const
+    {
+        vector<CPUInfo> orden = cpus;
+        if (politica == AFINIDAD_COMPACTA)
+        {
+            // Nodo, paquete y núcleo: los hermanos de un mismo núcleo quedan juntos
+            sort(orden.begin(), orden.end(), [](const CPUInfo &a, const CPUInfo &b)
+                 { return make_tuple(a.nodo, a.paquete, a.nucleo, a.cpu) < make_tuple(b.nodo, b.paquete, b.nucleo, b.cpu); });
+        }
+        else if (politica == AFINIDAD_DISPERSA)
+        {
+            // Primero un hilo por núcleo físico alternando nodos; los hermanos SMT van al final
+            map<int, vector<CPUInfo>> porNodo;
+            map<tuple<int, int, int>, int> usosNucleo;
+            vector<CPUInfo> compacto = ordenar(AFINIDAD_COMPACTA);
+            vector<pair<int, CPUInfo>> conNivel;
+            for (const auto &c : compacto)
+                conNivel.push_back({usosNucleo[make_tuple(c.nodo, c.paquete, c.nucleo)]++, c});
+
+            orden.clear();
+            for (int nivel = 0; orden.size() < cpus.size(); nivel++)
+            {
+                porNodo.clear();
+                for (const auto &p : conNivel)
+                    if (p.first == nivel)
+                        porNodo[p.second.nodo].push_back(p.second);
+                for (size_t k = 0;; k++)
+                {
+                    bool alguno = false;
+                    for (auto &n : porNodo)
+                    {
+                        if (k < n.second.size())
+                        {
+                            orden.push_back(n.second[k]);
+                            alguno = true;
+                        }
+                    }
+                    if (!alguno)
+                        break;
+                }
+            }
+        }
+        return orden;
+    }
+};
+
+// Nodo NUMA del hilo actual (-1 si no se colocó) y si se puede usar mbind con él
+thread_local int nodoHiloActual = -1;
+thread_local bool nodoHiloReal = false;
+
+/**
+ * @class BuffersLocales
+ * @brief Ranuras de buffers de un hilo, prestados por su pool (F27) la primera vez que se piden.
+ */
+
+class BuffersLocales
+{
+private:
+    unique_ptr<BufferPrestado> ranuras[RANURAS_BUFFER_LOCAL];
+
+    // Lleva al nodo del hilo las páginas del buffer (los del pool están alineados a página)
+    static void colocarEnNodo(char *datos, size_t tamano)
+    {
+#if defined(__linux__) && defined(SYS_mbind)
+        bool alineado = reinterpret_cast<uintptr_t>(datos) % 4096 == 0;
+        if (alineado && nodoHiloActual >= 0 && nodoHiloReal && nodoHiloActual < 64)
+        {
+            unsigned long mascara = 1UL << nodoHiloActual;
+            // MPOL_MF_MOVE: un buffer reutilizado puede traer páginas ya creadas en otro nodo
+            syscall(SYS_mbind, datos, tamano, MPOL_PREFERRED, &mascara, 64, MPOL_MF_MOVE); // Si falla queda el primer toque
+        }
+#endif
+        // Primer toque desde el hilo dueño: las páginas nuevas se crean en su nodo
+        memset(datos, 0, tamano);
+    }
+
+public:
+    // El pool del hilo se crea antes que las ranuras para que se destruya después y pueda recibirlas
+    BuffersLocales() { poolBuffersHilo(); }
+
+    BuffersLocales(const BuffersLocales &) = delete;
+    BuffersLocales &operator=(const BuffersLocales &) = delete;
+
+    char *obtener(int ranura, size_t tamano)
+    {
+        if (!ranuras[ranura] || ranuras[ranura]->tamano() < tamano)
+        {
+            ranuras[ranura].reset(); // Se devuelve al pool antes de pedir el más grande
+            ranuras[ranura].reset(new BufferPrestado(tamano));
+            colocarEnNodo(ranuras[ranura]->datos(), ranuras[ranura]->tamano());
+        }
+        return ranuras[ranura]->datos();
+    }
+};
+
+/**
+ * @brief Buffer de al menos 'tamano' bytes propio del hilo que llama.
+ *
+ * Se reutiliza entre llamadas del mismo hilo; cada ranura es independiente, así que una función
+ * puede pedir hasta RANURAS_BUFFER_LOCAL buffers a la vez. La memoria sale del pool de buffers
+ * del hilo (F27_pool_buffers.h), así que cuenta en sus estadísticas y usa páginas grandes si se
+ * activaron. Si el hilo fue colocado con ColocacionHilos, la memoria queda en su nodo NUMA.
+ */
+char *bufferLocal(int ranura, size_t tamano)
+{
+    thread_local BuffersLocales buffers;
+    return buffers.obtener(ranura, tamano);
+}
+
+/**
+ * @class ColocacionHilos
+ * @brief Asignación de CPUs a los hilos de un pool según una política.
+ */
+
+class ColocacionHilos
+{
+private:
+    TopologiaCPU topologia;
+    PoliticaAfinidad politica;
+    vector<CPUInfo> orden;
+
+public:
+    ColocacionHilos(PoliticaAfinidad politica, int nodosSimulados = 0)
+        : topologia(nodosSimulados), politica(politica), orden(topologia.ordenar(politica)) {}
+
+    PoliticaAfinidad getPolitica() const { return politica; }
+    const TopologiaCPU &getTopologia() const { return topologia; }
+
+    // CPU asignada al hilo 'indice'
+    const CPUInfo &cpuDeHilo(int indice) const { return orden[indice % orden.size()]; }
+
+    /**
+     * @brief Fija el hilo que llama a la CPU del hilo 'indice' y recuerda su nodo.
+     *
+     * Debe llamarse desde el propio hilo antes de pedir buffers con bufferLocal().
+     */
+    void aplicar(int indice) const
+    {
+        if (politica == AFINIDAD_NINGUNA)
+            return;
+        const CPUInfo &cpu = cpuDeHilo(indice);
+#ifdef __linux__
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        CPU_SET(cpu.cpu, &conjunto);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) != 0)
+            cerr << "No se pudo fijar el hilo " << indice << " a la CPU " << cpu.cpu << endl;
+#endif
+        nodoHiloActual = cpu.nodo;
+        nodoHiloReal = !topologia.esSimulada();
+    }
+
+    /**
+     * @brief Describe la topología detectada y la CPU de cada uno de los primeros numHilos hilos.
+     */
+    string describir(int numHilos) const
+    {
+        stringstream texto;
+        texto << "Topologia: " << topologia.getCPUs().size() << " CPUs, " << topologia.getNumNodos() << " nodo(s)"
+              << (topologia.esSimulada() ? " simulados" : "") << endl;
+        texto << "Afinidad:  " << nombresAfinidad[politica] << endl;
+        if (politica != AFINIDAD_NINGUNA)
+        {
+            for (int h = 0; h < numHilos; h++)
+            {
+                const CPUInfo &c = cpuDeHilo(h);
+                texto << "  Hilo " << h << " -> CPU " << c.cpu << " (nucleo " << c.nucleo << ", paquete " << c.paquete << ", nodo " << c.nodo << ")" << endl;
+            }
+        }
+        return texto.str();
+    }
+};
+
+#endif // F17_AFINIDAD_H
@@ -0,0 +1,714 @@
+/**
+ * @file F18_corrutinas.h
+ * @brief Modelo asíncrono con corrutinas de C++20 para los pasos del proceso.
+ *
+ * Los modos secuencial y paralelo bloquean un hilo del sistema por cada proceso en curso. Aquí
+ * cada proceso es una corrutina (Tarea<T>) que se suspende en cada lectura, escritura o cálculo
+ * y se reanuda cuando termina, de forma que miles de procesos en vuelo comparten unos pocos hilos:
+ * - Un reactor con epoll reanuda las corrutinas listas. Las finalizaciones se le avisan con un
+ *   eventfd, así que los hilos del reactor duermen en epoll_wait mientras no hay nada que hacer.
+ * - Las lecturas y escrituras (pread/pwrite) se ejecutan en un pool de E/S. Los archivos regulares
+ *   siempre están "listos" para epoll, por lo que no se puede esperar su disponibilidad como con
+ *   un socket; el pool hace la llamada bloqueante y el reactor solo ve la finalización.
+ * - El cifrado, el descifrado y el hash se envían a un pool de CPU para no frenar al reactor.
+ *
+ * Solo se compila con C++20 (corrutinas) en Linux (epoll/eventfd); con C++17 el módulo queda vacío
+ * y CORRUTINAS_DISPONIBLES no se define.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F05_proceso.h: Proporciona OpcionesProceso y los pasos bloqueantes que se reutilizan.
+ * - F07_main_paralelo.h: Proporciona el directorio de trabajo y el informe final del modo paralelo.
+ * - F14_pool_hilos.h: Proporciona los pools de E/S y de CPU.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F18_CORRUTINAS_H
+#define F18_CORRUTINAS_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+
+#if defined(__cpp_impl_coroutine) && defined(__linux__) && __has_include(<coroutine>)
+#define CORRUTINAS_DISPONIBLES 1
+
+#include "F05_proceso.h"
+#include "F07_main_paralelo.h"
+#include "F14_pool_hilos.h"
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <optional>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/**
+ * @def MAX_EN_VUELO_CORRUTINAS
+ * @brief Procesos que pueden estar en curso a la vez en mainCorrutinas (limita la memoria de buffers).
+ */
+#define MAX_EN_VUELO_CORRUTINAS 1024
+
+template <typename T>
+class Tarea;
+
+/**
+ * @struct PromesaBase
+ * @brief Parte común de las promesas de Tarea: continuación y excepción.
+ *
+ * La tarea empieza suspendida y, al terminar, transfiere el control a quien la esperaba
+ * (transferencia simétrica, sin crecer la pila).
+ */
+
+struct PromesaBase
+{
+    coroutine_handle<> continuacion;
+    exception_ptr excepcion;
+
+    struct EsperaFinal
+    {
+        bool await_ready() noexcept { return false; }
+
+        template <typename P>
+        coroutine_handle<> await_suspend(coroutine_handle<P> mango) noexcept
+        {
+            coroutine_handle<> siguiente = mango.promise().continuacion;
+            return siguiente ? siguiente : noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    suspend_always initial_suspend() noexcept { return {}; }
+    EsperaFinal final_suspend() noexcept { return {}; }
+    void unhandled_exception() { excepcion = current_exception(); }
+};
+
+template <typename T>
+struct PromesaTarea : PromesaBase
+{
+    optional<T> valor;
+
+    Tarea<T> get_return_object();
+    void return_value(T v) { valor = move(v); }
+};
+
+template <>
+struct PromesaTarea<void> : PromesaBase
+{
+    Tarea<void> get_return_object();
+    void return_void() {}
+};
+
+/**
+ * @class Tarea
+ * @brief Corrutina perezosa que produce un T; se ejecuta al hacer co_await sobre ella.
+ */
+
+template <typename T>
+class Tarea
+{
+public:
+    typedef PromesaTarea<T> promise_type;
+
+private:
+    coroutine_handle<promise_type> mango;
+
+public:
+    explicit Tarea(coroutine_handle<promise_type> m) : mango(m) {}
+    Tarea(Tarea &&otra) noexcept : mango(exchange(otra.mango, nullptr)) {}
+    Tarea(const Tarea &) = delete;
+    Tarea &operator=(const Tarea &) = delete;
+
+    ~Tarea()
+    {
+        if (mango)
+            mango.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    coroutine_handle<> await_suspend(coroutine_handle<> quien) noexcept
+    {
+        mango.promise().continuacion = quien;
+        return mango;
+    }
+
+    T await_resume()
+    {
+        if (mango.promise().excepcion)
+            rethrow_exception(mango.promise().excepcion);
+        if constexpr (!is_void<T>::value)
+            return move(*mango.promise().valor);
+    }
+};
+
+template <typename T>
+Tarea<T> PromesaTarea<T>::get_return_object()
+{
+    return Tarea<T>(coroutine_handle<PromesaTarea<T>>::from_promise(*this));
+}
+
+inline Tarea<void> PromesaTarea<void>::get_return_object()
+{
+    return Tarea<void>(coroutine_handle<PromesaTarea<void>>::from_promise(*this));
+}
+
+/**
+ * @struct TareaSuelta
+ * @brief Corrutina que arranca en el acto y se destruye sola al terminar (para lanzar procesos).
+ */
+
+struct TareaSuelta
+{
+    struct promise_type
+    {
+        TareaSuelta get_return_object() { return {}; }
+        suspend_never initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+};
+
+/**
+ * @class ReactorCorrutinas
+ * @brief Hilos que reanudan corrutinas listas, más los pools de E/S y de CPU.
+ */
+
+class ReactorCorrutinas
+{
+private:
+    int epollFd;
+    int eventoFd;
+    mutex mutex_listas;
+    deque<coroutine_handle<>> listas; // Corrutinas que se pueden reanudar
+    atomic<bool> detener;
+    vector<thread> hilos;
+    PoolHilos poolES, poolCPU;
+
+    static int &indiceActual()
+    {
+        thread_local int indice = -1;
+        return indice;
+    }
+
+    void bucleReactor(int indice)
+    {
+        indiceActual() = indice;
+        hiloTrazaAsincrono() = true;
+        nombrarHiloTraza("reactor " + to_string(indice));
+        epoll_event eventos[8];
+        while (true)
+        {
+            int n = epoll_wait(epollFd, eventos, 8, -1);
+            if (detener)
+                return; // No se lee el eventfd: sigue listo y despierta al resto de hilos
+            for (int e = 0; e < n; e++)
+            {
+                uint64_t contador;
+                if (eventos[e].data.fd == eventoFd && read(eventoFd, &contador, sizeof(contador)) < 0)
+                    continue; // Otro hilo ya consumió el aviso
+            }
+
+            // Se vacía la lista después de leer el eventfd: un aviso posterior vuelve a despertar
+            while (true)
+            {
+                coroutine_handle<> mango;
+                {
+                    lock_guard<mutex> lock(mutex_listas);
+                    if (listas.empty())
+                        break;
+                    mango = listas.front();
+                    listas.pop_front();
+                }
+                mango.resume();
+            }
+        }
+    }
+
+    /**
+     * @brief Espera que ejecuta una función en un pool y reanuda la corrutina en el reactor.
+     */
+    template <typename F>
+    struct EsperaEnPool
+    {
+        typedef decltype(declval<F &>()()) Resultado;
+
+        ReactorCorrutinas &reactor;
+        PoolHilos &pool;
+        F funcion;
+        optional<Resultado> resultado;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(coroutine_handle<> mango)
+        {
+            // Tras programar() la corrutina puede reanudarse y destruir esta espera: es lo último
+            pool.enviar([this, mango]
+                        { resultado = funcion(); reactor.programar(mango); return true; });
+        }
+
+        Resultado await_resume() { return move(*resultado); }
+    };
+
+    struct EsperaCambio
+    {
+        ReactorCorrutinas &reactor;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(coroutine_handle<> mango) { reactor.programar(mango); }
+        void await_resume() const noexcept {}
+    };
+
+public:
+    /**
+     * @param hilosReactor Hilos que reanudan corrutinas (0 = 1).
+     * @param hilosES Hilos para pread/pwrite y llamadas bloqueantes (0 = 4 por núcleo).
+     * @param hilosCPU Hilos para cifrado y hash (0 = núcleos disponibles).
+     */
+    ReactorCorrutinas(int hilosReactor = 0, int hilosES = 0, int hilosCPU = 0)
+        : epollFd(epoll_create1(EPOLL_CLOEXEC)), eventoFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), detener(false),
+          poolES(hilosES > 0 ? hilosES : 4 * max(1u, thread::hardware_concurrency()), 1024),
+          poolCPU(hilosCPU, 1024)
+    {
+        epoll_event evento = {};
+        evento.events = EPOLLIN;
+        evento.data.fd = eventoFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, eventoFd, &evento);
+
+        for (int h = 0; h < max(1, hilosReactor); h++)
+            hilos.emplace_back([this, h]
+                               { bucleReactor(h); });
+    }
+
+    ~ReactorCorrutinas()
+    {
+        // Un trabajo de los pools avisa con write(eventoFd) después de encolar la corrutina, que
+        // puede terminar antes de ese aviso: hay que esperar a los pools antes de cerrar el eventfd
+        poolES.esperarTodo();
+        poolCPU.esperarTodo();
+        detener = true;
+        uint64_t uno = 1;
+        if (write(eventoFd, &uno, sizeof(uno)) < 0)
+            cerr << "No se pudo avisar al reactor" << endl;
+        for (auto &hilo : hilos)
+            hilo.join();
+        close(eventoFd);
+        close(epollFd);
+    }
+
+    int numeroHilos() const { return static_cast<int>(hilos.size()); }
+    int hilosES() const { return poolES.numeroHilos(); }
+    int hilosCPU() const { return poolCPU.numeroHilos(); }
+
+    // Índice del hilo del reactor que llama, o -1 fuera del reactor
+    static int hiloActual() { return indiceActual(); }
+
+    /**
+     * @brief Marca una corrutina como lista; un hilo del reactor la reanudará.
+     */
+    void programar(coroutine_handle<> mango)
+    {
+        {
+            lock_guard<mutex> lock(mutex_listas);
+            listas.push_back(mango);
+        }
+        uint64_t uno = 1;
+        if (write(eventoFd, &uno, sizeof(uno)) < 0)
+            cerr << "No se pudo avisar al reactor" << endl;
+    }
+
+    // co_await cambiar(): continúa la corrutina en un hilo del reactor (también sirve para ceder el turno)
+    EsperaCambio cambiar() { return EsperaCambio{*this}; }
+
+    // co_await enES(f): ejecuta f (bloqueante) en el pool de E/S y devuelve su resultado
+    template <typename F>
+    EsperaEnPool<F> enES(F funcion) { return EsperaEnPool<F>{*this, poolES, move(funcion), {}}; }
+
+    // co_await enCPU(f): ejecuta f (cálculo) en el pool de CPU y devuelve su resultado
+    template <typename F>
+    EsperaEnPool<F> enCPU(F funcion) { return EsperaEnPool<F>{*this, poolCPU, move(funcion), {}}; }
+
+    auto leer(int fd, char *buffer, size_t bytes, long long desplazamiento)
+    {
+        return enES([=]
+                    { return pread(fd, buffer, bytes, desplazamiento); });
+    }
+
+    auto escribir(int fd, const char *buffer, size_t bytes, long long desplazamiento)
+    {
+        return enES([=]
+                    { return pwrite(fd, buffer, bytes, desplazamiento); });
+    }
+
+    auto abrir(const string &ruta, int banderas)
+    {
+        return enES([ruta, banderas]
+                    { return open(ruta.c_str(), banderas, 0644); });
+    }
+};
+
+// Pasos bloqueantes que las corrutinas envían al pool de E/S. Las esperas se construyen fuera de
+// las corrutinas: GCC 12 destruye dos veces las lambdas con capturas no triviales (string) creadas
+// dentro de una expresión co_await.
+
+inline auto procesoFusionadoEnES(ReactorCorrutinas &reactor, string original, string copia, string encriptado, string desencriptado, TiemposEtapas *tiempos)
+{
+    return reactor.enES([=]
+                        { return procesoFusionado(original, copia, encriptado, desencriptado, tiempos); });
+}
+
+inline auto consultarAlmacenEnES(ReactorCorrutinas &reactor, AlmacenContenido *almacen, string hash, Transformacion t, string destino)
+{
+    return reactor.enES([=]
+                        { return almacen->intentarMaterializar(hash, t, destino); });
+}
+
+inline auto publicarEnES(ReactorCorrutinas &reactor, AlmacenContenido *almacen, string hash, Transformacion t, string archivo)
+{
+    return reactor.enES([=]
+                        { almacen->publicar(hash, t, archivo); return true; });
+}
+
+inline auto tamanoArchivoEnES(ReactorCorrutinas &reactor, string archivo)
+{
+    return reactor.enES([=]
+                        { return devolverTamanoArchivo(archivo); });
+}
+
+// Cierra un descriptor si es válido
+void cerrarDescriptor(int fd)
+{
+    if (fd >= 0)
+        close(fd);
+}
+
+/**
+ * @brief Recorre un archivo en bloques y escribe cada bloque, transformado carácter a carácter, en otro.
+ *
+ * Con transformar == nullptr es una copia. Equivale a generarCopia / encriptarArchivo /
+ * desencriptarArchivo, que también trabajan byte a byte.
+ *
+ * @return long long Bytes escritos, o -1 si no se pudieron abrir los archivos o falló la E/S.
+ */
+inline Tarea<long long> transformarArchivoAsync(ReactorCorrutinas &reactor, string entrada, string salida, char (*transformar)(char))
+{
+    int fdEntrada = co_await reactor.abrir(entrada, O_RDONLY);
+    int fdSalida = co_await reactor.abrir(salida, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fdEntrada < 0 || fdSalida < 0)
+    {
+        cerr << "Error al abrir los archivos\n";
+        cerrarDescriptor(fdEntrada);
+        cerrarDescriptor(fdSalida);
+        co_return -1;
+    }
+
+    vector<char> bloque(TAMANO_BLOQUE);
+    long long total = 0;
+    while (true)
+    {
+        ssize_t leidos = co_await reactor.leer(fdEntrada, bloque.data(), bloque.size(), total);
+        if (leidos <= 0)
+        {
+            if (leidos < 0)
+                total = -1;
+            break;
+        }
+        if (transformar != nullptr)
+        {
+            char *datos = bloque.data();
+            co_await reactor.enCPU([datos, leidos, transformar]
+                                   { for (ssize_t j = 0; j < leidos; j++)
+                                         datos[j] = transformar(datos[j]);
+                                     return true; });
+        }
+        if (co_await reactor.escribir(fdSalida, bloque.data(), leidos, total) != leidos)
+        {
+            total = -1;
+            break;
+        }
+        total += leidos;
+    }
+
+    cerrarDescriptor(fdEntrada);
+    cerrarDescriptor(fdSalida);
+    co_return total;
+}
+
+inline Tarea<long long> generarCopiaAsync(ReactorCorrutinas &reactor, string entrada, string destino)
+{
+    co_return co_await transformarArchivoAsync(reactor, entrada, destino, nullptr);
+}
+
+inline Tarea<long long> encriptarArchivoAsync(ReactorCorrutinas &reactor, string entrada, string salida)
+{
+    co_return co_await transformarArchivoAsync(reactor, entrada, salida, encriptarCaracter);
+}
+
+inline Tarea<long long> desencriptarArchivoAsync(ReactorCorrutinas &reactor, string entrada, string salida)
+{
+    co_return co_await transformarArchivoAsync(reactor, entrada, salida, desencriptarCaracter);
+}
+
+/**
+ * @brief SHA-256 de un archivo en hexadecimal; "" si no se puede abrir (igual que generarHashArchivo).
+ */
+inline Tarea<string> generarHashArchivoAsync(ReactorCorrutinas &reactor, string archivo)
+{
+    int fd = co_await reactor.abrir(archivo, O_RDONLY);
+    if (fd < 0)
+        co_return "";
+
+    vector<char> bloque(TAMANO_BLOQUE);
+    sha256 contexto;
+    long long total = 0;
+    while (true)
+    {
+        ssize_t leidos = co_await reactor.leer(fd, bloque.data(), bloque.size(), total);
+        if (leidos <= 0)
+            break;
+        const BYTE *datos = reinterpret_cast<const BYTE *>(bloque.data());
+        sha256 *ctx = &contexto;
+        co_await reactor.enCPU([ctx, datos, leidos]
+                               { ctx->sha_append(datos, leidos); return true; });
+        total += leidos;
+    }
+    cerrarDescriptor(fd);
+    co_return contexto.sha_digest();
+}
+
+/**
+ * @brief Compara dos archivos bloque a bloque. Si descifrarPrimero es true, descifra antes el
+ *        primero en memoria (equivale a verificarDesencriptado).
+ */
+inline Tarea<bool> compararArchivosAsync(ReactorCorrutinas &reactor, string archivo1, string archivo2, bool descifrarPrimero = false)
+{
+    int fd1 = co_await reactor.abrir(archivo1, O_RDONLY);
+    int fd2 = co_await reactor.abrir(archivo2, O_RDONLY);
+    bool iguales = fd1 >= 0 && fd2 >= 0;
+
+    vector<char> bloque1(TAMANO_BLOQUE), bloque2(TAMANO_BLOQUE);
+    long long desplazamiento = 0;
+    while (iguales)
+    {
+        ssize_t leidos1 = co_await reactor.leer(fd1, bloque1.data(), bloque1.size(), desplazamiento);
+        ssize_t leidos2 = co_await reactor.leer(fd2, bloque2.data(), bloque2.size(), desplazamiento);
+        if (leidos1 != leidos2 || leidos1 < 0)
+            iguales = false;
+        if (leidos1 <= 0)
+            break;
+
+        const char *a = bloque1.data(), *b = bloque2.data();
+        iguales = co_await reactor.enCPU([a, b, leidos1, descifrarPrimero]
+                                         {
+            if (!descifrarPrimero)
+                return memcmp(a, b, leidos1) == 0;
+            for (ssize_t j = 0; j < leidos1; j++)
+                if (desencriptarCaracter(a[j]) != b[j])
+                    return false;
+            return true; });
+        desplazamiento += leidos1;
+    }
+
+    cerrarDescriptor(fd1);
+    cerrarDescriptor(fd2);
+    co_return iguales;
+}
+
+/**
+ * @brief Busca una salida en el almacén sin bloquear hilos: si otro proceso la está calculando,
+ *        la corrutina cede el turno y vuelve a consultar.
+ *
+ * @return bool true si se materializó; false si hay que calcularla y publicarla.
+ */
+inline Tarea<bool> materializarAsync(ReactorCorrutinas &reactor, AlmacenContenido *almacen, string hash, Transformacion t, string destino)
+{
+    while (true)
+    {
+        ConsultaAlmacen consulta = co_await consultarAlmacenEnES(reactor, almacen, hash, t, destino);
+        if (consulta != CONSULTA_OCUPADA)
+            co_return consulta == CONSULTA_ACIERTO;
+        co_await reactor.cambiar();
+    }
+}
+
+/**
+ * @brief Versión asíncrona de procesarArchivo: mismos pasos, mismas salidas y mismas opciones.
+ *
+ * Con etapas, los tiempos de cada paso incluyen la espera en los pools (latencia, no solo CPU).
+ * Los contadores de rendimiento y la memoria de cada etapa no se miden: los leería el hilo del
+ * reactor mientras el trabajo corre en los pools (main.cpp los desactiva en este modo).
+ */
+inline Tarea<ResultadoProceso> procesarArchivoAsync(ReactorCorrutinas &reactor, string archivoOriginal, string archivoCopia, string prefijoSalida, const OpcionesProceso &opciones)
+{
+    const string archivoEntrada = archivoCopia.empty() ? archivoOriginal : archivoCopia;
+    const string archivoEncriptado = prefijoSalida + ".sha", archivoDesencriptado = prefijoSalida + ".des";
+    ResultadoProceso resultado;
+    AlmacenContenido *almacen = opciones.almacen;
+    TiemposEtapas *tiempos = opciones.tiempos;
+    CronometroProceso medicion(tiempos);
+
+    // Pasos 1 a 7 en un solo recorrido: ya trabaja por bloques, se ejecuta entero en el pool de E/S
+    if (opciones.fusionado)
+    {
+        string desencriptado = opciones.soloVerificar ? "" : archivoDesencriptado;
+        co_return co_await procesoFusionadoEnES(reactor, archivoOriginal, archivoCopia, archivoEncriptado, desencriptado, tiempos);
+    }
+
+    // 1- Copiar el archivo original en la copia
+    if (!archivoCopia.empty())
+    {
+        CronometroEtapa c(tiempos, ETAPA_COPIA);
+        co_await generarCopiaAsync(reactor, archivoOriginal, archivoCopia);
+    }
+
+    // 3- Hash de la copia (clave del almacén)
+    {
+        CronometroEtapa c(tiempos, ETAPA_HASH);
+        resultado.hash = co_await generarHashArchivoAsync(reactor, archivoEntrada);
+    }
+
+    // 2- Encriptar la copia en el .sha
+    if (almacen == nullptr || !co_await materializarAsync(reactor, almacen, resultado.hash, TRANSFORMACION_ENCRIPTAR, archivoEncriptado))
+    {
+        CronometroEtapa c(tiempos, ETAPA_ENCRIPTAR);
+        co_await encriptarArchivoAsync(reactor, archivoEntrada, archivoEncriptado);
+        if (almacen != nullptr)
+            co_await publicarEnES(reactor, almacen, resultado.hash, TRANSFORMACION_ENCRIPTAR, archivoEncriptado);
+    }
+
+    // 4 y 5- Otro hash de la copia y comparación
+    {
+        CronometroEtapa c(tiempos, ETAPA_HASH);
+        string hash2 = co_await generarHashArchivoAsync(reactor, archivoEntrada);
+        resultado.hashesIguales = compararString(resultado.hash, hash2);
+    }
+
+    if (opciones.soloVerificar)
+    {
+        // 6 y 7- Desencriptar en memoria y comparar con el original
+        CronometroEtapa c(tiempos, ETAPA_COMPARAR);
+        resultado.contenidoIgual = co_await compararArchivosAsync(reactor, archivoEncriptado, archivoOriginal, true);
+    }
+    else
+    {
+        // 6- Desencriptar el .sha en el .des
+        if (almacen == nullptr || !co_await materializarAsync(reactor, almacen, resultado.hash, TRANSFORMACION_DESENCRIPTAR, archivoDesencriptado))
+        {
+            CronometroEtapa c(tiempos, ETAPA_DESENCRIPTAR);
+            co_await desencriptarArchivoAsync(reactor, archivoEncriptado, archivoDesencriptado);
+            if (almacen != nullptr)
+                co_await publicarEnES(reactor, almacen, resultado.hash, TRANSFORMACION_DESENCRIPTAR, archivoDesencriptado);
+        }
+
+        // 7- Comparar el .des con el original
+        CronometroEtapa c(tiempos, ETAPA_COMPARAR);
+        resultado.contenidoIgual = co_await compararArchivosAsync(reactor, archivoDesencriptado, archivoOriginal);
+    }
+
+    if (tiempos != nullptr)
+        tiempos->bytes += co_await tamanoArchivoEnES(reactor, archivoOriginal);
+    co_return resultado;
+}
+
+// Proceso i: original.txt -> i.txt -> i.sha -> i.des, como proceso()
+inline Tarea<ResultadoProceso> procesoAsync(ReactorCorrutinas &reactor, string rutaTrabajo, int i, const OpcionesProceso &opciones)
+{
+    co_return co_await procesarArchivoAsync(reactor, rutaTrabajo + "original.txt", rutaTrabajo + to_string(i) + ".txt", rutaTrabajo + to_string(i), opciones);
+}
+
+/**
+ * @struct ControlEnVuelo
+ * @brief Cuenta los procesos en curso para limitar cuántos se lanzan y esperar a que terminen.
+ */
+
+struct ControlEnVuelo
+{
+    mutex mutex_control;
+    condition_variable cambio;
+    int enVuelo = 0;
+    int maximo = 0; // Máximo observado
+
+    void entrar(int limite)
+    {
+        unique_lock<mutex> lock(mutex_control);
+        cambio.wait(lock, [&]
+                    { return enVuelo < limite; });
+        maximo = max(maximo, ++enVuelo);
+    }
+
+    void salir()
+    {
+        lock_guard<mutex> lock(mutex_control);
+        enVuelo--;
+        cambio.notify_all();
+    }
+
+    void esperarTodo()
+    {
+        unique_lock<mutex> lock(mutex_control);
+        cambio.wait(lock, [&]
+                    { return enVuelo == 0; });
+    }
+};
+
+// Lanza el proceso id en el reactor y guarda su inicio y fin en el buffer del hilo del reactor que lo termina
+TareaSuelta lanzarProcesoAsync(ReactorCorrutinas &reactor, int id, RegistroPorHilo &registro, ControlEnVuelo &control, const OpcionesProceso &opciones)
+{
+    co_await reactor.cambiar(); // El resto de la corrutina ya no corre en el hilo que la lanzó
+    auto inicio = chrono::steady_clock::now();
+    ResultadoProceso resultado = co_await procesoAsync(reactor, rutaTrabajo, id, opciones);
+    registro.registrar(ReactorCorrutinas::hiloActual(), id, inicio, chrono::steady_clock::now(), resultado.hashesIguales && resultado.contenidoIgual);
+    control.salir();
+}
+
+/**
+ * @brief Tercer modo: las copias como corrutinas multiplexadas sobre el reactor.
+ *
+ * @param copias Cantidad de procesos.
+ * @param opciones Opciones de cada proceso.
+ * @param hilosReactor Hilos del reactor (0 = 1).
+ * @param hilosES Hilos del pool de E/S (0 = 4 por núcleo).
+ * @param maxEnVuelo Procesos en curso a la vez como máximo.
+ */
+Temporizador mainCorrutinas(int copias, const OpcionesProceso &opciones = OpcionesProceso(), int hilosReactor = 0, int hilosES = 0, int maxEnVuelo = MAX_EN_VUELO_CORRUTINAS)
+{
+    cout << endl;
+
+    Temporizador temporizador_principal;
+
+    cout << "================================" << endl;
+    cout << "   INICIO PROCESO CORRUTINAS    " << endl;
+    cout << "================================" << endl;
+    cout << "Tiempo Inicial:     " << temporizador_principal.formatoTextoInicio() << endl;
+    cout << "================================" << endl;
+    cout << endl;
+
+    ControlEnVuelo control;
+    ReactorCorrutinas reactor(hilosReactor, hilosES);
+    RegistroPorHilo registro(reactor.numeroHilos());
+    registro.reservar(copias / reactor.numeroHilos() + 1);
+
+    for (int i = 1; i <= copias; ++i)
+    {
+        control.entrar(maxEnVuelo);
+        lanzarProcesoAsync(reactor, i, registro, control, opciones);
+    }
+    control.esperarTodo();
+
+    cout << "Hilos del reactor:  " << reactor.numeroHilos() << endl;
+    cout << "Hilos de E/S:       " << reactor.hilosES() << endl;
+    cout << "Hilos de CPU:       " << reactor.hilosCPU() << endl;
+    cout << "Maximo en vuelo:    " << control.maximo << endl;
+    cout << "--------------------------------" << endl;
+
+    temporizador_principal.detener();
+    mostrarFinParalelo(temporizador_principal, registro, opciones);
+    return temporizador_principal;
+}
+
+#endif // corrutinas de C++20 en Linux
+#endif // F18_CORRUTINAS_H
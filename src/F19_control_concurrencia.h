@@ -0,0 +1,256 @@
+/**
+ * @file F19_control_concurrencia.h
+ * @brief Controlador que ajusta en marcha cuántos hilos del pool trabajan según el rendimiento.
+ *
+ * El mejor grado de paralelismo depende de si el lote está limitado por E/S (caché fría, disco
+ * lento) o por CPU (SHA-256 sobre archivos en caché). El controlador mide cada cierto periodo
+ * los procesos terminados por segundo y la espera media en la cola del pool, y sube o baja la
+ * cantidad de hilos activos dentro de unos límites con una de dos políticas:
+ * - Escalada (hill climbing): da un paso en una dirección; si el rendimiento mejora sigue, si
+ *   empeora da la vuelta y, si no cambia, solo crece cuando hay trabajos esperando en la cola.
+ * - AIMD: suma un hilo mientras el rendimiento no baja y hay trabajo en cola; si baja de forma
+ *   clara, multiplica los hilos por 3/4.
+ * Cada decisión queda registrada (instante, hilos antes y después, medidas y motivo).
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F14_pool_hilos.h: Proporciona el pool cuyos hilos activos se ajustan.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F19_CONTROL_CONCURRENCIA_H
+#define F19_CONTROL_CONCURRENCIA_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F14_pool_hilos.h"
+
+/**
+ * @def UMBRAL_CAMBIO_CONTROL
+ * @brief Variación relativa del rendimiento por debajo de la cual se considera ruido (5 %).
+ */
+#define UMBRAL_CAMBIO_CONTROL 0.05
+
+enum PoliticaControl
+{
+    CONTROL_ESCALADA, // Hill climbing
+    CONTROL_AIMD      // Aumento aditivo, disminución multiplicativa
+};
+
+const char *nombresControl[] = {"escalada", "aimd"};
+
+/**
+ * @struct ConfiguracionControl
+ * @brief Límites y política del controlador.
+ */
+
+struct ConfiguracionControl
+{
+    PoliticaControl politica = CONTROL_ESCALADA;
+    int minimo = 1;             // Hilos activos mínimos
+    int maximo = 0;             // Hilos activos máximos (0 = los hilos del pool)
+    int periodoMs = 250;        // Cada cuánto se mide y se decide
+    int minimoProcesos = 8;     // Procesos terminados necesarios para decidir (si no, se alarga la medida)
+    bool mostrarEnVivo = false; // Imprime cada decisión en cuanto se toma
+};
+
+/**
+ * @struct DecisionControl
+ * @brief Una medición del controlador y el ajuste que produjo.
+ */
+
+struct DecisionControl
+{
+    double segundos;           // Desde el inicio del controlador
+    int antes;                 // Hilos activos durante el periodo medido
+    int despues;               // Hilos activos para el siguiente periodo
+    double procesosPorSegundo; // Rendimiento del periodo
+    double esperaColaMs;       // Espera media en la cola de los trabajos tomados en el periodo
+    string motivo;
+};
+
+/**
+ * @class ControladorConcurrencia
+ * @brief Hilo que mide el pool periódicamente y ajusta sus hilos activos.
+ */
+
+class ControladorConcurrencia
+{
+private:
+    PoolHilos &pool;
+    ConfiguracionControl configuracion;
+    vector<DecisionControl> decisiones;
+    thread hiloControl;
+    mutex mutex_control;
+    condition_variable despertar;
+    bool detenerControl;
+
+    // Estado de la política
+    double rendimientoAnterior;
+    int direccion;
+
+    int limitar(int n) const { return max(configuracion.minimo, min(configuracion.maximo, n)); }
+
+    // Devuelve los hilos para el siguiente periodo y rellena el motivo
+    int decidir(int actual, double rendimiento, bool hayCola, string &motivo)
+    {
+        bool primera = rendimientoAnterior < 0;
+        bool mejora = !primera && rendimiento > rendimientoAnterior * (1 + UMBRAL_CAMBIO_CONTROL);
+        bool empeora = !primera && rendimiento < rendimientoAnterior * (1 - UMBRAL_CAMBIO_CONTROL);
+        int nuevo = actual;
+
+        if (configuracion.politica == CONTROL_ESCALADA)
+        {
+            if (primera)
+                motivo = "primera medida, se prueba un paso";
+            else if (mejora)
+                motivo = "mejora, se sigue en la misma direccion";
+            else if (empeora)
+            {
+                direccion = -direccion;
+                motivo = "empeora, se cambia de direccion";
+            }
+            else if (hayCola && direccion < 0)
+            {
+                direccion = 1;
+                motivo = "sin cambio y con cola, se prueba crecer";
+            }
+            else if (!hayCola)
+            {
+                direccion = -1;
+                motivo = "sin cambio y sin cola, se prueba reducir";
+            }
+            else
+                motivo = "sin cambio, se sigue probando";
+
+            nuevo = limitar(actual + direccion);
+            if (nuevo == actual)
+            {
+                direccion = -direccion; // En un límite: el siguiente paso va hacia el otro lado
+                motivo += " (en el limite)";
+            }
+        }
+        else
+        {
+            if (empeora)
+            {
+                nuevo = limitar(actual * 3 / 4);
+                motivo = "empeora, disminucion multiplicativa";
+            }
+            else if (hayCola)
+            {
+                nuevo = limitar(actual + 1);
+                motivo = "sin perdida y con cola, aumento aditivo";
+            }
+            else
+                motivo = "sin cola, se mantiene";
+        }
+
+        rendimientoAnterior = rendimiento;
+        return nuevo;
+    }
+
+    void bucleControl()
+    {
+        auto inicio = chrono::steady_clock::now(), ultimo = inicio;
+        long long terminadosAntes = pool.trabajosTerminados(), esperaAntes = pool.esperaEnColaNs();
+
+        unique_lock<mutex> lock(mutex_control);
+        while (!despertar.wait_for(lock, chrono::milliseconds(configuracion.periodoMs), [this]
+                                   { return detenerControl; }))
+        {
+            auto ahora = chrono::steady_clock::now();
+            long long terminados = pool.trabajosTerminados(), espera = pool.esperaEnColaNs();
+            long long hechos = terminados - terminadosAntes;
+            double segundos = chrono::duration_cast<chrono::nanoseconds>(ahora - ultimo).count() / 1e9;
+
+            DecisionControl d;
+            d.segundos = chrono::duration_cast<chrono::nanoseconds>(ahora - inicio).count() / 1e9;
+            d.antes = pool.hilosActivos();
+            d.procesosPorSegundo = hechos / segundos;
+            d.esperaColaMs = hechos > 0 ? (espera - esperaAntes) / 1e6 / hechos : 0.0;
+            bool hayCola = pool.trabajosEnCola() > 0;
+
+            // Pocos procesos terminados: la medida sería ruido, se alarga hasta el siguiente periodo.
+            // Un pool parado también cae aquí, así que se despierta a los hilos en cada periodo.
+            if (hechos < configuracion.minimoProcesos)
+            {
+                pool.despertarTrabajadores();
+                continue;
+            }
+
+            d.despues = decidir(d.antes, d.procesosPorSegundo, hayCola, d.motivo);
+            pool.ajustarActivos(d.despues);
+            terminadosAntes = terminados;
+            esperaAntes = espera;
+            ultimo = ahora;
+
+            decisiones.push_back(d);
+            if (configuracion.mostrarEnVivo)
+                cout << formatearDecision(d) << endl;
+        }
+    }
+
+public:
+    /**
+     * @brief Arranca el controlador sobre un pool ya creado con el máximo de hilos.
+     *
+     * @param pool Pool a controlar; debe vivir más que el controlador.
+     * @param config Política y límites; maximo se recorta a los hilos del pool.
+     * @param iniciales Hilos activos al empezar (se recorta a los límites).
+     */
+    ControladorConcurrencia(PoolHilos &pool, const ConfiguracionControl &config, int iniciales)
+        : pool(pool), configuracion(config), detenerControl(false), rendimientoAnterior(-1), direccion(1)
+    {
+        if (configuracion.maximo <= 0 || configuracion.maximo > pool.numeroHilos())
+            configuracion.maximo = pool.numeroHilos();
+        configuracion.minimo = max(1, min(configuracion.minimo, configuracion.maximo));
+        configuracion.periodoMs = max(1, configuracion.periodoMs);
+        pool.ajustarActivos(limitar(iniciales));
+        hiloControl = thread([this]
+                             { bucleControl(); });
+    }
+
+    ~ControladorConcurrencia() { detener(); }
+
+    /**
+     * @brief Detiene el muestreo (se puede llamar varias veces).
+     */
+    void detener()
+    {
+        {
+            lock_guard<mutex> lock(mutex_control);
+            detenerControl = true;
+        }
+        despertar.notify_all();
+        if (hiloControl.joinable())
+            hiloControl.join();
+    }
+
+    // Decisiones tomadas; solo es seguro leerlas después de detener()
+    const vector<DecisionControl> &getDecisiones() const { return decisiones; }
+
+    static string formatearDecision(const DecisionControl &d)
+    {
+        ostringstream oss;
+        oss << fixed << setprecision(2) << "[control " << d.segundos << " s] hilos " << d.antes << " -> " << d.despues
+            << " | " << setprecision(1) << d.procesosPorSegundo << " procesos/s, espera cola " << setprecision(3) << d.esperaColaMs
+            << " ms | " << d.motivo;
+        return oss.str();
+    }
+
+    /**
+     * @brief Texto con la política, los límites y todas las decisiones.
+     */
+    string resumen() const
+    {
+        ostringstream oss;
+        oss << "Control de concurrencia: " << nombresControl[configuracion.politica] << ", hilos entre " << configuracion.minimo
+            << " y " << configuracion.maximo << ", periodo " << configuracion.periodoMs << " ms, " << decisiones.size() << " decisiones" << endl;
+        for (const auto &d : decisiones)
+            oss << formatearDecision(d) << endl;
+        return oss.str();
+    }
+};
+
+#endif // F19_CONTROL_CONCURRENCIA_H
@@ -0,0 +1,99 @@
+/**
+ * @file F20_ciclos.h
+ * @brief Contador de ciclos (TSC) calibrado al arrancar, para medir ciclos por byte de cada etapa.
+ *
+ * En x86 se lee el contador de marcas de tiempo con __rdtsc(), mucho más barato que consultar
+ * un reloj. En los procesadores actuales el TSC avanza a frecuencia constante (constant_tsc),
+ * así que mide ciclos de referencia, no ciclos reales del núcleo si este sube o baja de
+ * frecuencia. La calibración compara el TSC con steady_clock durante unos milisegundos.
+ *
+ * En otras arquitecturas leerCiclos() devuelve nanosegundos de steady_clock y la calibración
+ * da 1 ciclo por nanosegundo, para que el código que lo usa funcione igual.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F20_CICLOS_H
+#define F20_CICLOS_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CICLOS_TSC_DISPONIBLE 1
+#endif
+
+/**
+ * @def MS_CALIBRACION_CICLOS
+ * @brief Duración de la calibración del contador de ciclos.
+ */
+#define MS_CALIBRACION_CICLOS 20
+
+// Lee el contador de ciclos (o nanosegundos de steady_clock si no hay TSC)
+inline unsigned long long leerCiclos()
+{
+#ifdef CICLOS_TSC_DISPONIBLE
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Ciclos por nanosegundo medidos en la calibración (0 mientras no se calibre)
+double &ciclosPorNanosegundo()
+{
+    static double valor = 0.0;
+    return valor;
+}
+
+/**
+ * @brief Mide la frecuencia del contador comparándolo con steady_clock.
+ *
+ * Se llama una vez al arrancar, antes de lanzar hilos.
+ *
+ * @return double Ciclos por nanosegundo (GHz).
+ */
+double calibrarCiclos()
+{
+    auto inicio = chrono::steady_clock::now();
+    unsigned long long ciclosInicio = leerCiclos();
+    while (chrono::steady_clock::now() - inicio < chrono::milliseconds(MS_CALIBRACION_CICLOS))
+    {
+    }
+    unsigned long long ciclosFin = leerCiclos();
+    long long nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+
+    ciclosPorNanosegundo() = nanos > 0 ? static_cast<double>(ciclosFin - ciclosInicio) / nanos : 0.0;
+    return ciclosPorNanosegundo();
+}
+
+/**
+ * @brief Texto con el origen del contador y su frecuencia calibrada.
+ */
+string describirContadorCiclos()
+{
+    ostringstream oss;
+    oss << fixed << setprecision(3);
+#ifdef CICLOS_TSC_DISPONIBLE
+    bool constante = false;
+    ifstream cpuinfo("/proc/cpuinfo");
+    string linea;
+    while (getline(cpuinfo, linea))
+    {
+        if (linea.compare(0, 5, "flags") == 0)
+        {
+            constante = linea.find(" constant_tsc") != string::npos;
+            break;
+        }
+    }
+    oss << "Contador de ciclos: TSC a " << ciclosPorNanosegundo() << " GHz" << (constante ? " (constant_tsc)" : " (frecuencia no garantizada)");
+#else
+    oss << "Contador de ciclos: sin TSC, se usan nanosegundos de steady_clock";
+#endif
+    return oss.str();
+}
+
+#endif // F20_CICLOS_H
@@ -0,0 +1,267 @@
+/**
+ * @file F21_histograma.h
+ * @brief Histograma de latencias con cubetas logarítmicas (estilo HDR) y sin bloqueos.
+ *
+ * Cada potencia de dos se divide en 32 cubetas iguales, así que el error relativo de cualquier
+ * valor es como mucho del 3 % y el histograma cubre de 1 ns a varios siglos con 1920 contadores.
+ * Registrar es un fetch_add atómico (más un CAS para mínimo y máximo): varios hilos pueden
+ * registrar a la vez sin mutex. Los histogramas se combinan sumando contadores, de modo que se
+ * pueden unir los de distintos hilos o de distintas ejecuciones, y se pueden volcar a un archivo
+ * de texto y volver a cargar para compararlos.
+ *
+ * Formato del archivo (un bloque por histograma, los valores en nanosegundos):
+ *   histograma <nombre> <cantidad> <suma> <minimo> <maximo>
+ *   <cubeta> <cuenta>      (solo cubetas no vacías)
+ *   fin
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F21_HISTOGRAMA_H
+#define F21_HISTOGRAMA_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <map>
+
+/**
+ * @def BITS_SUBCUBETAS
+ * @brief Cada potencia de dos se divide en 2^BITS_SUBCUBETAS cubetas (32: error máximo del 3 %).
+ */
+#define BITS_SUBCUBETAS 5
+#define SUBCUBETAS (1 << BITS_SUBCUBETAS)
+#define NUM_CUBETAS (SUBCUBETAS + (64 - BITS_SUBCUBETAS) * SUBCUBETAS)
+
+// Percentiles que se muestran en los resúmenes
+#define NUM_PERCENTILES_RESUMEN 4
+const double percentilesResumen[] = {50.0, 90.0, 99.0, 99.9};
+const char *nombresPercentiles[] = {"p50", "p90", "p99", "p99.9"};
+
+/**
+ * @class HistogramaLatencia
+ * @brief Cuenta latencias en nanosegundos en cubetas logarítmicas.
+ */
+
+class HistogramaLatencia
+{
+private:
+    atomic<long long> cuentas[NUM_CUBETAS];
+    atomic<long long> cantidad;
+    atomic<long long> suma;
+    atomic<long long> minimo;
+    atomic<long long> maximo;
+
+    static int cubeta(long long valor)
+    {
+        if (valor < SUBCUBETAS)
+            return valor < 0 ? 0 : static_cast<int>(valor);
+        int exponente = 63 - __builtin_clzll(static_cast<unsigned long long>(valor));
+        int mantisa = static_cast<int>(valor >> (exponente - BITS_SUBCUBETAS)); // Entre SUBCUBETAS y 2*SUBCUBETAS-1
+        return SUBCUBETAS + (exponente - BITS_SUBCUBETAS) * SUBCUBETAS + (mantisa - SUBCUBETAS);
+    }
+
+    // Mayor valor que cae en la cubeta
+    static long long limiteSuperior(int indice)
+    {
+        if (indice < SUBCUBETAS)
+            return indice;
+        int exponente = (indice - SUBCUBETAS) / SUBCUBETAS + BITS_SUBCUBETAS;
+        long long mantisa = (indice - SUBCUBETAS) % SUBCUBETAS + SUBCUBETAS;
+        int desplazamiento = exponente - BITS_SUBCUBETAS;
+        if (exponente == 63 && mantisa == 2 * SUBCUBETAS - 1)
+            return LLONG_MAX;
+        return ((mantisa + 1) << desplazamiento) - 1;
+    }
+
+    static void actualizarMinimo(atomic<long long> &actual, long long valor)
+    {
+        long long visto = actual.load(memory_order_relaxed);
+        while (valor < visto && !actual.compare_exchange_weak(visto, valor, memory_order_relaxed))
+        {
+        }
+    }
+
+    static void actualizarMaximo(atomic<long long> &actual, long long valor)
+    {
+        long long visto = actual.load(memory_order_relaxed);
+        while (valor > visto && !actual.compare_exchange_weak(visto, valor, memory_order_relaxed))
+        {
+        }
+    }
+
+public:
+    HistogramaLatencia() { reiniciar(); }
+
+    void reiniciar()
+    {
+        for (auto &c : cuentas)
+            c.store(0, memory_order_relaxed);
+        cantidad = 0;
+        suma = 0;
+        minimo = LLONG_MAX;
+        maximo = 0;
+    }
+
+    /**
+     * @brief Registra una latencia (en nanosegundos). Seguro desde varios hilos a la vez.
+     */
+    void registrar(long long nanosegundos)
+    {
+        if (nanosegundos < 0)
+            nanosegundos = 0;
+        cuentas[cubeta(nanosegundos)].fetch_add(1, memory_order_relaxed);
+        cantidad.fetch_add(1, memory_order_relaxed);
+        suma.fetch_add(nanosegundos, memory_order_relaxed);
+        actualizarMinimo(minimo, nanosegundos);
+        actualizarMaximo(maximo, nanosegundos);
+    }
+
+    /**
+     * @brief Suma a este histograma los contadores de otro (de otro hilo o de otra ejecución).
+     */
+    void combinar(const HistogramaLatencia &otro)
+    {
+        for (int i = 0; i < NUM_CUBETAS; i++)
+        {
+            long long c = otro.cuentas[i].load(memory_order_relaxed);
+            if (c != 0)
+                cuentas[i].fetch_add(c, memory_order_relaxed);
+        }
+        cantidad += otro.cantidad.load();
+        suma += otro.suma.load();
+        if (otro.cantidad > 0)
+        {
+            actualizarMinimo(minimo, otro.minimo);
+            actualizarMaximo(maximo, otro.maximo);
+        }
+    }
+
+    long long getCantidad() const { return cantidad; }
+    long long getMaximo() const { return maximo; }
+    long long getMinimo() const { return cantidad > 0 ? minimo.load() : 0; }
+    double media() const { return cantidad > 0 ? static_cast<double>(suma) / cantidad : 0.0; }
+
+    /**
+     * @brief Valor por debajo del cual queda el p % de las muestras (límite superior de su cubeta).
+     */
+    long long percentil(double p) const
+    {
+        long long total = cantidad;
+        if (total == 0)
+            return 0;
+        long long objetivo = static_cast<long long>(ceil(p / 100.0 * total));
+        objetivo = max(1LL, min(objetivo, total));
+
+        long long acumulado = 0;
+        for (int i = 0; i < NUM_CUBETAS; i++)
+        {
+            acumulado += cuentas[i].load(memory_order_relaxed);
+            if (acumulado >= objetivo)
+                return min(limiteSuperior(i), maximo.load());
+        }
+        return maximo;
+    }
+
+    /**
+     * @brief Una línea con cantidad, percentiles, máximo y, si se indica la duración, el rendimiento.
+     *
+     * @param segundos Tiempo de pared en que se registraron las muestras (0 = no mostrar rendimiento).
+     */
+    string resumen(double segundos = 0.0) const
+    {
+        ostringstream oss;
+        oss << fixed << setprecision(3) << "n=" << cantidad;
+        for (int i = 0; i < NUM_PERCENTILES_RESUMEN; i++)
+            oss << "  " << nombresPercentiles[i] << "=" << percentil(percentilesResumen[i]) / 1e6 << " ms";
+        oss << "  max=" << maximo / 1e6 << " ms";
+        if (segundos > 0)
+            oss << "  (" << setprecision(1) << cantidad / segundos << "/s)";
+        return oss.str();
+    }
+
+    /**
+     * @brief Escribe el histograma en el formato de texto descrito arriba.
+     */
+    void volcar(ostream &salida, const string &nombre) const
+    {
+        salida << "histograma " << nombre << " " << cantidad << " " << suma << " " << getMinimo() << " " << maximo << "\n";
+        for (int i = 0; i < NUM_CUBETAS; i++)
+        {
+            long long c = cuentas[i].load(memory_order_relaxed);
+            if (c != 0)
+                salida << i << " " << c << "\n";
+        }
+        salida << "fin\n";
+    }
+
+    /**
+     * @brief Lee el cuerpo de un bloque (tras la línea "histograma") y lo suma a este histograma.
+     */
+    bool cargar(istream &entrada, long long n, long long s, long long mn, long long mx)
+    {
+        string linea;
+        while (getline(entrada, linea) && linea != "fin")
+        {
+            istringstream campos(linea);
+            int i;
+            long long c;
+            if (!(campos >> i >> c) || i < 0 || i >= NUM_CUBETAS)
+                return false;
+            cuentas[i] += c;
+        }
+        cantidad += n;
+        suma += s;
+        if (n > 0)
+        {
+            actualizarMinimo(minimo, mn);
+            actualizarMaximo(maximo, mx);
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Carga todos los histogramas de un archivo, sumando los que se repiten por nombre.
+ *
+ * @param ruta Archivo generado con HistogramaLatencia::volcar.
+ * @param histogramas Mapa nombre -> histograma donde se acumulan (se crean si no existen).
+ * @return bool false si el archivo no se pudo abrir o tiene un formato inválido.
+ */
+bool cargarHistogramas(const string &ruta, map<string, unique_ptr<HistogramaLatencia>> &histogramas)
+{
+    ifstream entrada(ruta);
+    if (!entrada.is_open())
+    {
+        cerr << "No se pudo abrir " << ruta << endl;
+        return false;
+    }
+
+    string linea;
+    while (getline(entrada, linea))
+    {
+        istringstream cabecera(linea);
+        string palabra, nombre;
+        long long n, s, mn, mx;
+        if (!(cabecera >> palabra >> nombre >> n >> s >> mn >> mx) || palabra != "histograma")
+        {
+            cerr << "Formato invalido en " << ruta << ": " << linea << endl;
+            return false;
+        }
+        unique_ptr<HistogramaLatencia> &h = histogramas[nombre];
+        if (!h)
+            h.reset(new HistogramaLatencia());
+        if (!h->cargar(entrada, n, s, mn, mx))
+        {
+            cerr << "Formato invalido en " << ruta << " (histograma " << nombre << ")" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // F21_HISTOGRAMA_H
@@ -0,0 +1,294 @@
+/**
+ * @file F22_traza.h
+ * @brief Registro de intervalos (spans) por hilo y exportación en formato Chrome Trace Event.
+ *
+ * Cada SpanTraza guarda al destruirse un evento con su nombre, el identificador del archivo o
+ * copia que se está procesando y sus instantes de inicio y fin. Los eventos van a un buffer
+ * circular propio de cada hilo: registrar no toma ningún mutex, y si un hilo llena su buffer se
+ * pierden sus eventos más antiguos (se cuentan como descartados). Al terminar, guardarTraza()
+ * escribe un JSON que se abre en https://ui.perfetto.dev o en chrome://tracing, con una fila
+ * por hilo y los spans anidados.
+ *
+ * Con la traza apagada un SpanTraza solo lee un atómico; compilando con -DSIN_TRAZAS la clase
+ * queda vacía y el compilador la elimina por completo.
+ *
+ * En los hilos del reactor de corrutinas un span puede empezar en un hilo y acabar en otro, y
+ * varios procesos se intercalan en el mismo hilo, así que allí los spans se exportan como
+ * eventos asíncronos (una pista por span) en lugar de anidarse en la fila del hilo. Lo mismo
+ * ocurre con los spans de etapa del pipeline fusionado, que cubren todo el archivo y se solapan.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F22_TRAZA_H
+#define F22_TRAZA_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include <atomic>
+#include <memory>
+
+/**
+ * @def CAPACIDAD_TRAZA_HILO
+ * @brief Eventos que guarda cada hilo antes de empezar a sobrescribir los más antiguos.
+ */
+#define CAPACIDAD_TRAZA_HILO (1 << 15)
+
+/**
+ * @struct EventoTraza
+ * @brief Un span terminado. El nombre debe ser un literal (solo se guarda el puntero).
+ */
+
+struct EventoTraza
+{
+    const char *nombre;
+    int archivo;                  // Copia o archivo en proceso (-1 si no hay)
+    unsigned long long asincrono; // Id. del evento asíncrono (0 = span normal del hilo)
+    long long inicioNs, finNs;    // Desde que se activó la traza
+};
+
+/**
+ * @struct BufferTraza
+ * @brief Buffer circular de eventos de un hilo. Solo lo escribe su hilo.
+ */
+
+struct BufferTraza
+{
+    int tid;
+    string nombreHilo;
+    vector<EventoTraza> eventos;
+    atomic<unsigned long long> escritos{0};
+};
+
+// Escapa comillas y barras para un texto JSON (los caracteres de control se omiten)
+string escaparJSON(const string &texto)
+{
+    string resultado;
+    for (char c : texto)
+    {
+        if (c == '"' || c == '\\')
+            resultado += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            resultado += c;
+    }
+    return resultado;
+}
+
+/**
+ * @class RegistroTraza
+ * @brief Conjunto de buffers de todos los hilos que han registrado eventos.
+ *
+ * Los buffers pertenecen al registro, no a los hilos, así que los eventos sobreviven a los hilos
+ * que los generaron. guardar() debe llamarse cuando ya no se están registrando spans.
+ */
+
+class RegistroTraza
+{
+private:
+    mutex mutex_registro;
+    vector<unique_ptr<BufferTraza>> buffers;
+    chrono::steady_clock::time_point origen;
+    atomic<bool> activa{false};
+    atomic<unsigned long long> siguienteAsincrono{1};
+
+    static void escribirEvento(ostream &salida, const EventoTraza &e, int tid, bool &primero)
+    {
+        string nombre = escaparJSON(e.nombre);
+        string argumentos = e.archivo >= 0 ? ",\"args\":{\"archivo\":" + to_string(e.archivo) + "}" : "";
+        salida << (primero ? "\n" : ",\n");
+        primero = false;
+        if (e.asincrono == 0)
+        {
+            salida << "{\"name\":\"" << nombre << "\",\"cat\":\"crypto\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                   << ",\"ts\":" << e.inicioNs / 1e3 << ",\"dur\":" << (e.finNs - e.inicioNs) / 1e3 << argumentos << "}";
+            return;
+        }
+        salida << "{\"name\":\"" << nombre << "\",\"cat\":\"asincrono\",\"ph\":\"b\",\"id\":" << e.asincrono << ",\"pid\":1,\"tid\":" << tid
+               << ",\"ts\":" << e.inicioNs / 1e3 << argumentos << "},\n"
+               << "{\"name\":\"" << nombre << "\",\"cat\":\"asincrono\",\"ph\":\"e\",\"id\":" << e.asincrono << ",\"pid\":1,\"tid\":" << tid
+               << ",\"ts\":" << e.finNs / 1e3 << "}";
+    }
+
+public:
+    static RegistroTraza &global()
+    {
+        static RegistroTraza registro;
+        return registro;
+    }
+
+    bool estaActiva() const { return activa.load(memory_order_relaxed); }
+
+    /**
+     * @brief Empieza a registrar; los instantes se miden desde esta llamada.
+     */
+    void activar()
+    {
+        origen = chrono::steady_clock::now();
+        activa = true;
+    }
+
+    void desactivar() { activa = false; }
+
+    long long ahoraNs() const { return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origen).count(); }
+
+    unsigned long long nuevoIdAsincrono() { return siguienteAsincrono.fetch_add(1, memory_order_relaxed); }
+
+    // Buffer del hilo que llama; la primera vez lo crea y lo da de alta
+    BufferTraza &bufferHilo()
+    {
+        thread_local BufferTraza *propio = nullptr;
+        if (propio == nullptr)
+        {
+            unique_ptr<BufferTraza> nuevo(new BufferTraza());
+            nuevo->eventos.resize(CAPACIDAD_TRAZA_HILO);
+            lock_guard<mutex> lock(mutex_registro);
+            nuevo->tid = static_cast<int>(buffers.size()) + 1;
+            nuevo->nombreHilo = "hilo " + to_string(nuevo->tid);
+            propio = nuevo.get();
+            buffers.push_back(move(nuevo));
+        }
+        return *propio;
+    }
+
+    void registrar(const EventoTraza &evento)
+    {
+        BufferTraza &buffer = bufferHilo();
+        unsigned long long n = buffer.escritos.load(memory_order_relaxed);
+        buffer.eventos[n % CAPACIDAD_TRAZA_HILO] = evento;
+        buffer.escritos.store(n + 1, memory_order_release);
+    }
+
+    /**
+     * @brief Escribe todos los eventos en formato Chrome Trace Event (JSON).
+     *
+     * @return bool false si no se pudo crear el archivo.
+     */
+    bool guardar(const string &ruta)
+    {
+        ofstream salida(ruta);
+        if (!salida.is_open())
+        {
+            cerr << "No se pudo crear " << ruta << endl;
+            return false;
+        }
+
+        lock_guard<mutex> lock(mutex_registro);
+        unsigned long long total = 0, descartados = 0;
+        bool primero = true;
+        salida << fixed << setprecision(3) << "{\"traceEvents\":[";
+        for (const auto &buffer : buffers)
+        {
+            salida << (primero ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+                   << ",\"args\":{\"name\":\"" << escaparJSON(buffer->nombreHilo) << "\"}}";
+            primero = false;
+
+            unsigned long long escritos = buffer->escritos.load(memory_order_acquire);
+            unsigned long long desde = escritos > CAPACIDAD_TRAZA_HILO ? escritos - CAPACIDAD_TRAZA_HILO : 0;
+            for (unsigned long long i = desde; i < escritos; i++)
+                escribirEvento(salida, buffer->eventos[i % CAPACIDAD_TRAZA_HILO], buffer->tid, primero);
+            total += escritos - desde;
+            descartados += desde;
+        }
+        salida << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"eventos\":" << total << ",\"descartados\":" << descartados << "}}\n";
+
+        cout << "Traza: " << total << " eventos de " << buffers.size() << " hilos en " << ruta;
+        if (descartados > 0)
+            cout << " (" << descartados << " descartados por buffer lleno)";
+        cout << endl;
+        return true;
+    }
+};
+
+// Copia o archivo que procesa el hilo (lo heredan los spans que no indican uno)
+int &archivoTrazaActual()
+{
+    thread_local int archivo = -1;
+    return archivo;
+}
+
+// Marca los hilos cuyos spans se exportan como asíncronos (hilos del reactor de corrutinas)
+bool &hiloTrazaAsincrono()
+{
+    thread_local bool asincrono = false;
+    return asincrono;
+}
+
+inline bool trazaActiva()
+{
+#ifdef SIN_TRAZAS
+    return false;
+#else
+    return RegistroTraza::global().estaActiva();
+#endif
+}
+
+void activarTraza() { RegistroTraza::global().activar(); }
+
+bool guardarTraza(const string &ruta)
+{
+    RegistroTraza::global().desactivar();
+    return RegistroTraza::global().guardar(ruta);
+}
+
+/**
+ * @brief Pone nombre a la fila del hilo que llama (no hace nada con la traza apagada).
+ */
+void nombrarHiloTraza(const string &nombre)
+{
+    if (trazaActiva())
+        RegistroTraza::global().bufferHilo().nombreHilo = nombre;
+}
+
+/**
+ * @class SpanTraza
+ * @brief Registra el intervalo entre su construcción y su destrucción.
+ *
+ * @param nombre Literal con el nombre del span.
+ * @param archivo Copia o archivo al que pertenece; si es -1 se hereda del span que lo contiene.
+ */
+
+class SpanTraza
+{
+#ifndef SIN_TRAZAS
+private:
+    const char *nombre;
+    int archivo, archivoAnterior;
+    unsigned long long asincrono;
+    long long inicio;
+    bool activo;
+
+public:
+    SpanTraza(const char *nombre, int archivo = -1) : nombre(nombre), activo(trazaActiva())
+    {
+        if (!activo)
+            return;
+        RegistroTraza &registro = RegistroTraza::global();
+        asincrono = hiloTrazaAsincrono() ? registro.nuevoIdAsincrono() : 0;
+        archivoAnterior = archivoTrazaActual();
+        this->archivo = archivo >= 0 ? archivo : archivoAnterior;
+        if (asincrono == 0)
+            archivoTrazaActual() = this->archivo;
+        inicio = registro.ahoraNs();
+    }
+
+    ~SpanTraza()
+    {
+        if (!activo)
+            return;
+        RegistroTraza &registro = RegistroTraza::global();
+        registro.registrar({nombre, archivo, asincrono, inicio, registro.ahoraNs()});
+        if (asincrono == 0)
+            archivoTrazaActual() = archivoAnterior; // Un span asíncrono puede acabar en otro hilo
+    }
+#else
+public:
+    SpanTraza(const char *, int = -1) {}
+#endif
+
+    SpanTraza(const SpanTraza &) = delete;
+    SpanTraza &operator=(const SpanTraza &) = delete;
+};
+
+#endif // F22_TRAZA_H
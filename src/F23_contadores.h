@@ -0,0 +1,220 @@
+/**
+ * @file F23_contadores.h
+ * @brief Contadores de rendimiento del procesador (perf_event_open) por hilo.
+ *
+ * Cada hilo abre, la primera vez que se le piden, un grupo de contadores que solo cuentan lo
+ * que ejecuta ese hilo (los de hardware, solo en modo usuario): ciclos, instrucciones, fallos
+ * de caché, fallos de predicción de saltos, fallos de página y cambios de contexto. Leer el grupo es una sola
+ * llamada read(), así que se puede hacer al entrar y al salir de cada etapa y atribuirle la
+ * diferencia (ver CronometroEtapa en F11_pipeline_fusionado.h).
+ *
+ * Si un contador no se puede abrir (contenedores, máquinas virtuales sin PMU, o
+ * perf_event_paranoid demasiado alto) queda como no disponible y se informa el motivo; los
+ * demás siguen funcionando. Los contadores de software (fallos de página, cambios de contexto)
+ * suelen estar disponibles aunque los de hardware no lo estén.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F23_CONTADORES_H
+#define F23_CONTADORES_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CONTADORES_PERF_DISPONIBLES 1
+#endif
+
+enum Contador
+{
+    CONTADOR_CICLOS,
+    CONTADOR_INSTRUCCIONES,
+    CONTADOR_FALLOS_CACHE,
+    CONTADOR_FALLOS_SALTO,
+    CONTADOR_FALLOS_PAGINA,
+    CONTADOR_CAMBIOS_CONTEXTO,
+    NUM_CONTADORES
+};
+
+const char *nombresContadores[NUM_CONTADORES] = {"ciclos", "instrucciones", "fallos cache", "fallos salto", "fallos pagina", "cambios contexto"};
+
+/**
+ * @struct LecturaContadores
+ * @brief Valores de todos los contadores en un instante (-1 = contador no disponible).
+ */
+
+struct LecturaContadores
+{
+    long long valores[NUM_CONTADORES];
+};
+
+// Motivo por el que falta algún contador (el primero que se encontró)
+string &motivoSinContadores()
+{
+    static string motivo;
+    return motivo;
+}
+
+mutex &mutexMotivoContadores()
+{
+    static mutex m;
+    return m;
+}
+
+/**
+ * @class ContadoresHilo
+ * @brief Grupo de contadores del hilo que lo crea. Se obtiene con contadoresHilo().
+ */
+
+class ContadoresHilo
+{
+private:
+    int fds[NUM_CONTADORES];
+    int posicion[NUM_CONTADORES]; // Posición de cada contador en la lectura del grupo (-1 = no abierto)
+    int lider;
+    int abiertos;
+
+#ifdef CONTADORES_PERF_DISPONIBLES
+    static void configurar(Contador c, perf_event_attr &atributos)
+    {
+        static const unsigned long long configuraciones[NUM_CONTADORES] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_PAGE_FAULTS, PERF_COUNT_SW_CONTEXT_SWITCHES};
+        memset(&atributos, 0, sizeof(atributos));
+        atributos.size = sizeof(atributos);
+        atributos.type = c >= CONTADOR_FALLOS_PAGINA ? PERF_TYPE_SOFTWARE : PERF_TYPE_HARDWARE;
+        atributos.config = configuraciones[c];
+        atributos.exclude_kernel = atributos.type == PERF_TYPE_HARDWARE; // Solo modo usuario: basta con perf_event_paranoid <= 2
+        atributos.exclude_hv = 1;
+        atributos.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    }
+#endif
+
+public:
+    ContadoresHilo() : lider(-1), abiertos(0)
+    {
+        for (int c = 0; c < NUM_CONTADORES; c++)
+            fds[c] = posicion[c] = -1;
+#ifdef CONTADORES_PERF_DISPONIBLES
+        for (int c = 0; c < NUM_CONTADORES; c++)
+        {
+            perf_event_attr atributos;
+            configurar(static_cast<Contador>(c), atributos);
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &atributos, 0, -1, lider, 0));
+            if (fd < 0)
+            {
+                lock_guard<mutex> lock(mutexMotivoContadores());
+                if (motivoSinContadores().empty())
+                    motivoSinContadores() = string(nombresContadores[c]) + ": " + strerror(errno);
+                continue;
+            }
+            fds[c] = fd;
+            posicion[c] = abiertos++;
+            if (lider < 0)
+                lider = fd;
+        }
+#else
+        lock_guard<mutex> lock(mutexMotivoContadores());
+        motivoSinContadores() = "perf_event_open solo existe en Linux";
+#endif
+    }
+
+    ~ContadoresHilo()
+    {
+#ifdef CONTADORES_PERF_DISPONIBLES
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+#endif
+    }
+
+    ContadoresHilo(const ContadoresHilo &) = delete;
+    ContadoresHilo &operator=(const ContadoresHilo &) = delete;
+
+    bool disponible() const { return lider >= 0; }
+
+    /**
+     * @brief Lee todos los contadores del grupo con una sola llamada.
+     *
+     * Si el núcleo tuvo que repartir los contadores en el tiempo (multiplexado), los valores se
+     * escalan por el tiempo habilitado / tiempo en ejecución.
+     *
+     * @return bool false si el grupo no está disponible o la lectura falló.
+     */
+    bool leer(LecturaContadores &lectura) const
+    {
+        for (auto &v : lectura.valores)
+            v = -1;
+#ifdef CONTADORES_PERF_DISPONIBLES
+        if (lider < 0)
+            return false;
+        unsigned long long datos[3 + NUM_CONTADORES]; // nr, habilitado, en ejecución, valores
+        if (read(lider, datos, sizeof(datos)) < static_cast<ssize_t>((3 + abiertos) * sizeof(unsigned long long)))
+            return false;
+        double escala = datos[2] > 0 ? static_cast<double>(datos[1]) / datos[2] : 1.0;
+        for (int c = 0; c < NUM_CONTADORES; c++)
+            if (posicion[c] >= 0)
+                lectura.valores[c] = static_cast<long long>(datos[3 + posicion[c]] * escala);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool tiene(Contador c) const { return posicion[c] >= 0; }
+
+    // Un bit (1 << Contador) por cada contador abierto
+    int mascara() const
+    {
+        int bits = 0;
+        for (int c = 0; c < NUM_CONTADORES; c++)
+            if (posicion[c] >= 0)
+                bits |= 1 << c;
+        return bits;
+    }
+};
+
+// Grupo de contadores del hilo que llama (se abre la primera vez)
+ContadoresHilo &contadoresHilo()
+{
+    thread_local ContadoresHilo contadores;
+    return contadores;
+}
+
+/**
+ * @brief Texto con los contadores disponibles y, si falta alguno, el motivo.
+ *
+ * @param disponibles Máscara (ContadoresHilo::mascara) de los contadores que se abrieron en los
+ *                    hilos que midieron; no se consulta el hilo que llama, que puede no haber
+ *                    abierto nunca su grupo.
+ */
+string describirContadores(int disponibles)
+{
+    ostringstream oss;
+    oss << "Contadores disponibles:";
+    bool alguno = false;
+    for (int c = 0; c < NUM_CONTADORES; c++)
+    {
+        if (disponibles & (1 << c))
+        {
+            oss << (alguno ? ", " : " ") << nombresContadores[c];
+            alguno = true;
+        }
+    }
+    if (!alguno)
+        oss << " ninguno";
+    lock_guard<mutex> lock(mutexMotivoContadores());
+    if (!motivoSinContadores().empty())
+        oss << " (no disponible " << motivoSinContadores() << ")";
+    return oss.str();
+}
+
+#endif // F23_CONTADORES_H
@@ -0,0 +1,306 @@
+/**
+ * @file F24_banco_pruebas.h
+ * @brief Banco de pruebas que repite las ejecuciones y da medianas con intervalo de confianza.
+ *
+ * Una sola ejecución secuencial seguida de una paralela no sirve para comparar: la paralela
+ * encuentra la caché de páginas caliente y el porcentaje de mejora es una única muestra. El
+ * banco ejecuta cada variante varias veces:
+ * - Primero unas rondas de calentamiento que no se cuentan.
+ * - En cada ronda alterna el orden de las variantes (A B, B A, ...) para que ninguna se
+ *   beneficie siempre de ir después.
+ * - Antes de cada ejecución puede borrar las copias generadas y los almacenes por contenido (se
+ *   vuelven a crear desde cero) y pedir al núcleo que descarte de la caché las páginas de los
+ *   directorios de trabajo.
+ * El resultado de cada variante es la mediana con un intervalo de confianza del 95 % sin
+ * suponer ninguna distribución (por estadísticos de orden), y la aceleración se calcula ronda a
+ * ronda entre la primera variante y cada una de las demás. Se informa en texto y en JSON.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F24_BANCO_PRUEBAS_H
+#define F24_BANCO_PRUEBAS_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @struct ConfiguracionBanco
+ * @brief Opciones del banco de pruebas.
+ */
+
+struct ConfiguracionBanco
+{
+    int calentamiento = 1;      // Rondas iniciales que no se cuentan
+    int repeticiones = 5;       // Rondas medidas
+    bool alternar = true;       // Invierte el orden de las variantes en rondas alternas
+    bool vaciarCache = false;   // Descarta de la caché de páginas los directorios de trabajo antes de cada ejecución
+    bool regenerar = false;     // Borra las copias generadas antes de cada ejecución
+    vector<string> directorios; // Directorios de trabajo afectados por vaciarCache y regenerar
+    vector<string> almacenes;   // Almacenes por contenido que regenerar también vacía
+};
+
+/**
+ * @struct VarianteBanco
+ * @brief Una forma de ejecutar el trabajo. La función devuelve los segundos que tardó.
+ */
+
+struct VarianteBanco
+{
+    string nombre;
+    function<double()> ejecutar;
+    vector<double> segundos; // Una muestra por ronda medida
+};
+
+/**
+ * @struct EstadisticaBanco
+ * @brief Mediana e intervalo de confianza del 95 % de una serie de muestras.
+ */
+
+struct EstadisticaBanco
+{
+    double mediana = 0, inferior = 0, superior = 0, minimo = 0, maximo = 0;
+};
+
+/**
+ * @brief Mediana con su intervalo de confianza del 95 % por estadísticos de orden.
+ *
+ * La cantidad de muestras por debajo de la mediana real sigue una binomial(n, 1/2); el intervalo
+ * va de la muestra j a la n-j+1 (ordenadas) con el mayor j que deja como mucho un 2.5 % en cada
+ * cola. Con menos de 6 muestras no hay tal j y el intervalo es el rango completo.
+ */
+EstadisticaBanco calcularEstadistica(vector<double> muestras)
+{
+    EstadisticaBanco e;
+    size_t n = muestras.size();
+    if (n == 0)
+        return e;
+    sort(muestras.begin(), muestras.end());
+    e.minimo = muestras.front();
+    e.maximo = muestras.back();
+    e.mediana = n % 2 ? muestras[n / 2] : (muestras[n / 2 - 1] + muestras[n / 2]) / 2;
+
+    // P(X < j) acumulada de la binomial(n, 1/2)
+    size_t j = 0;
+    double acumulada = 0, termino = pow(0.5, static_cast<double>(n)); // P(X = 0)
+    for (size_t k = 0; k < n; k++)
+    {
+        acumulada += termino;
+        if (acumulada > 0.025)
+            break;
+        j = k + 1;
+        termino = termino * (n - k) / (k + 1);
+    }
+    e.inferior = j > 0 ? muestras[j - 1] : muestras.front();
+    e.superior = j > 0 ? muestras[n - j] : muestras.back();
+    return e;
+}
+
+/**
+ * @brief Pide al núcleo que descarte de la caché de páginas los archivos de un directorio.
+ *
+ * Sin privilegios no se puede vaciar toda la caché (/proc/sys/vm/drop_caches), pero sí
+ * descartar las páginas limpias de archivos concretos con posix_fadvise(DONTNEED).
+ */
+void descartarCacheDirectorio(const string &directorio)
+{
+    DIR *dir = opendir(directorio.c_str());
+    if (dir == nullptr)
+        return;
+    while (struct dirent *entrada = readdir(dir))
+    {
+        string nombre = entrada->d_name;
+        if (nombre == "." || nombre == "..")
+            continue;
+        int fd = open((directorio + nombre).c_str(), O_RDONLY);
+        if (fd < 0)
+            continue;
+        fdatasync(fd); // Las páginas sucias no se pueden descartar
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+    closedir(dir);
+}
+
+/**
+ * @brief Borra las copias generadas (archivos que empiezan por un dígito) de un directorio.
+ */
+void borrarCopiasDirectorio(const string &directorio)
+{
+    DIR *dir = opendir(directorio.c_str());
+    if (dir == nullptr)
+        return;
+    vector<string> borrar;
+    while (struct dirent *entrada = readdir(dir))
+        if (isdigit(static_cast<unsigned char>(entrada->d_name[0])))
+            borrar.push_back(directorio + entrada->d_name);
+    closedir(dir);
+    for (const auto &ruta : borrar)
+        remove(ruta.c_str());
+}
+
+/**
+ * @brief Borra todos los archivos de un directorio (sin entrar en subdirectorios).
+ */
+void vaciarDirectorio(const string &directorio)
+{
+    DIR *dir = opendir(directorio.c_str());
+    if (dir == nullptr)
+        return;
+    vector<string> borrar;
+    while (struct dirent *entrada = readdir(dir))
+        if (entrada->d_type != DT_DIR)
+            borrar.push_back(directorio + entrada->d_name);
+    closedir(dir);
+    for (const auto &ruta : borrar)
+        remove(ruta.c_str());
+}
+
+/**
+ * @class BancoPruebas
+ * @brief Ejecuta las variantes por rondas y resume los resultados.
+ */
+
+class BancoPruebas
+{
+private:
+    ConfiguracionBanco configuracion;
+    vector<VarianteBanco> variantes;
+    vector<vector<double>> aceleraciones; // [variante][ronda]: segundos de la primera / segundos de esta
+    function<void()> alEmpezarMedidas;    // Se ejecuta al acabar el calentamiento
+
+    void prepararEjecucion()
+    {
+        for (const auto &directorio : configuracion.directorios)
+        {
+            if (configuracion.regenerar)
+                borrarCopiasDirectorio(directorio);
+            if (configuracion.vaciarCache)
+                descartarCacheDirectorio(directorio);
+        }
+        // Sin vaciar el almacén, cada ronda tras la primera sería un acierto y solo se mediría la materialización
+        if (configuracion.regenerar)
+            for (const auto &almacen : configuracion.almacenes)
+                vaciarDirectorio(almacen);
+    }
+
+    // Ejecuta una variante con la salida estándar silenciada
+    double medir(VarianteBanco &variante)
+    {
+        prepararEjecucion();
+        ostringstream descartada;
+        streambuf *original = cout.rdbuf(descartada.rdbuf());
+        double segundos = variante.ejecutar();
+        cout.rdbuf(original);
+        return segundos;
+    }
+
+public:
+    BancoPruebas(const ConfiguracionBanco &config) : configuracion(config)
+    {
+        configuracion.repeticiones = max(1, configuracion.repeticiones);
+        configuracion.calentamiento = max(0, configuracion.calentamiento);
+    }
+
+    // La primera variante que se agrega es la referencia de las aceleraciones
+    void agregar(const string &nombre, function<double()> ejecutar) { variantes.push_back({nombre, move(ejecutar), {}}); }
+
+    // Función que se ejecuta una vez, entre el calentamiento y la primera ronda medida (p. ej. para
+    // poner a cero medidas acumuladas durante el calentamiento)
+    void antesDeMedir(function<void()> funcion) { alEmpezarMedidas = move(funcion); }
+
+    void ejecutar()
+    {
+        int rondas = configuracion.calentamiento + configuracion.repeticiones;
+        aceleraciones.assign(variantes.size(), {});
+        for (int r = 0; r < rondas; r++)
+        {
+            bool medida = r >= configuracion.calentamiento;
+            if (r == configuracion.calentamiento && alEmpezarMedidas)
+                alEmpezarMedidas();
+            bool invertir = configuracion.alternar && r % 2 == 1;
+            vector<double> ronda(variantes.size());
+            for (size_t k = 0; k < variantes.size(); k++)
+            {
+                size_t v = invertir ? variantes.size() - 1 - k : k;
+                ronda[v] = medir(variantes[v]);
+            }
+
+            cerr << (medida ? "Ronda " : "Calentamiento ") << (medida ? r - configuracion.calentamiento + 1 : r + 1) << ":";
+            for (size_t v = 0; v < variantes.size(); v++)
+                cerr << " " << variantes[v].nombre << " " << fixed << setprecision(3) << ronda[v] << " s";
+            cerr << endl;
+
+            if (!medida)
+                continue;
+            for (size_t v = 0; v < variantes.size(); v++)
+            {
+                variantes[v].segundos.push_back(ronda[v]);
+                aceleraciones[v].push_back(ronda[v] > 0 ? ronda[0] / ronda[v] : 0.0);
+            }
+        }
+    }
+
+    /**
+     * @brief Tabla con la mediana, el intervalo y la aceleración de cada variante.
+     */
+    string resumen() const
+    {
+        ostringstream oss;
+        oss << fixed << setprecision(4);
+        oss << "================================" << endl;
+        oss << "        BANCO DE PRUEBAS        " << endl;
+        oss << "================================" << endl;
+        oss << "Rondas: " << configuracion.repeticiones << " (+" << configuracion.calentamiento << " de calentamiento)"
+            << (configuracion.alternar ? ", orden alterno" : "") << (configuracion.regenerar ? ", copias regeneradas" : "")
+            << (configuracion.vaciarCache ? ", cache descartada" : "") << endl;
+        for (size_t v = 0; v < variantes.size(); v++)
+        {
+            EstadisticaBanco t = calcularEstadistica(variantes[v].segundos);
+            oss << left << setw(12) << variantes[v].nombre << right << " mediana " << t.mediana << " s  IC95 [" << t.inferior << ", " << t.superior
+                << "]  min " << t.minimo << "  max " << t.maximo << endl;
+        }
+        for (size_t v = 1; v < variantes.size(); v++)
+        {
+            EstadisticaBanco a = calcularEstadistica(aceleraciones[v]);
+            oss << setprecision(3) << "Aceleracion " << variantes[v].nombre << " / " << variantes[0].nombre << ": " << a.mediana << "x  IC95 ["
+                << a.inferior << ", " << a.superior << "]  (mejora " << setprecision(2) << (1 - 1 / a.mediana) * 100 << " %)" << endl;
+        }
+        oss << "================================";
+        return oss.str();
+    }
+
+    /**
+     * @brief Los mismos resultados en JSON, con todas las muestras.
+     */
+    string json() const
+    {
+        ostringstream oss;
+        oss << setprecision(9);
+        oss << "{\"repeticiones\":" << configuracion.repeticiones << ",\"calentamiento\":" << configuracion.calentamiento
+            << ",\"alternar\":" << (configuracion.alternar ? "true" : "false") << ",\"regenerar\":" << (configuracion.regenerar ? "true" : "false")
+            << ",\"vaciarCache\":" << (configuracion.vaciarCache ? "true" : "false") << ",\"variantes\":[";
+        for (size_t v = 0; v < variantes.size(); v++)
+        {
+            EstadisticaBanco t = calcularEstadistica(variantes[v].segundos);
+            EstadisticaBanco a = calcularEstadistica(aceleraciones[v]);
+            oss << (v ? "," : "") << "{\"nombre\":\"" << variantes[v].nombre << "\",\"muestras\":[";
+            for (size_t k = 0; k < variantes[v].segundos.size(); k++)
+                oss << (k ? "," : "") << variantes[v].segundos[k];
+            oss << "],\"mediana\":" << t.mediana << ",\"ic95\":[" << t.inferior << "," << t.superior << "],\"minimo\":" << t.minimo
+                << ",\"maximo\":" << t.maximo << ",\"aceleracion\":" << a.mediana << ",\"aceleracionIc95\":[" << a.inferior << "," << a.superior << "]}";
+        }
+        oss << "]}";
+        return oss.str();
+    }
+};
+
+#endif // F24_BANCO_PRUEBAS_H
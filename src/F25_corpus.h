@@ -0,0 +1,455 @@
+/**
+ * @file F25_corpus.h
+ * @brief Generador determinista de corpus sintéticos para pruebas de rendimiento reproducibles.
+ *
+ * A partir de una semilla genera un conjunto de archivos con un tamaño total dado, repartido
+ * según una distribución (fija, uniforme, lognormal o Pareto), y con una mezcla de caracteres
+ * configurable: proporción de letras, dígitos y bytes no ASCII, que recorren ramas distintas
+ * del cifrado; el resto son espacios, signos y saltos de línea. Una parte de los archivos puede
+ * ser binaria (bytes aleatorios) o dispersa (huecos con bloques de texto cada MiB).
+ *
+ * Junto a los archivos se escribe un manifiesto:
+ *   # corpus semilla=42 bytes=67108864 archivos=100 distribucion=lognormal ...
+ *   <ruta>\t<bytes>\t<tipo>\t<sha256>
+ * La primera línea guarda la configuración completa y cada línea el tamaño y el tipo de su
+ * archivo, así que el mismo corpus se puede volver a generar en otra máquina a partir del
+ * manifiesto y comprobar con los hashes que es idéntico.
+ * El modo por lotes (--lote-lista) acepta el manifiesto como lista de archivos.
+ *
+ * El generador usa mt19937_64 (su secuencia está fijada por el estándar) y sus propias
+ * transformaciones a uniforme, normal y Pareto en lugar de las distribuciones de <random>,
+ * cuyos resultados cambian entre bibliotecas estándar. El contenido de los archivos y su tipo
+ * solo dependen de operaciones enteras y de suma, producto y comparación en coma flotante
+ * (exactas en IEEE 754). Los tamaños de las distribuciones lognormal y Pareto, en cambio, pasan
+ * por exp, log, cos y pow de la biblioteca matemática, que no garantiza el mismo último bit en
+ * todas las plataformas: con la misma semilla otra máquina podría repartir algún byte de otra
+ * forma. Por eso la regeneración desde un manifiesto usa los tamaños y tipos anotados en él.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F01_archivo.h: Proporciona TAMANO_BLOQUE, crearDirectorio y el hash SHA-256.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F25_CORPUS_H
+#define F25_CORPUS_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F01_archivo.h"
+#include <cmath>
+#include <map>
+#include <random>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @def SEPARACION_DISPERSO
+ * @brief En los archivos dispersos hay un bloque de texto al comienzo de cada MiB; el resto son huecos.
+ */
+#define SEPARACION_DISPERSO (1024 * 1024)
+
+enum DistribucionTamanos
+{
+    TAMANOS_FIJOS,       // Todos los archivos del mismo tamaño
+    TAMANOS_UNIFORMES,   // Pesos uniformes en [0.5, 1.5)
+    TAMANOS_LOGNORMALES, // exp(N(0, forma)): muchos pequeños y algunos grandes
+    TAMANOS_PARETO,      // Cola pesada con índice forma: pocos archivos concentran casi todo
+    NUM_DISTRIBUCIONES
+};
+
+const char *nombresDistribuciones[NUM_DISTRIBUCIONES] = {"fija", "uniforme", "lognormal", "pareto"};
+
+enum TipoArchivoCorpus
+{
+    CORPUS_TEXTO,
+    CORPUS_BINARIO,
+    CORPUS_DISPERSO,
+    NUM_TIPOS_CORPUS
+};
+
+const char *nombresTiposCorpus[NUM_TIPOS_CORPUS] = {"texto", "binario", "disperso"};
+
+/**
+ * @struct ConfiguracionCorpus
+ * @brief Todo lo que determina un corpus: con la misma configuración se obtienen los mismos bytes.
+ */
+
+struct ConfiguracionCorpus
+{
+    unsigned long long semilla = 1;
+    long long bytes = 64LL * 1024 * 1024; // Tamaño total del corpus
+    int archivos = 100;
+    DistribucionTamanos distribucion = TAMANOS_LOGNORMALES;
+    double forma = 1.0;    // Sigma de la lognormal o índice de Pareto
+    double letras = 0.75;  // Proporción de letras en los archivos de texto
+    double digitos = 0.10; // Proporción de dígitos
+    double noAscii = 0.0;  // Proporción de bytes 0x80-0xFF
+    double binarios = 0.0; // Proporción de archivos binarios
+    double dispersos = 0.0; // Proporción de archivos dispersos
+};
+
+/**
+ * @struct EntradaCorpus
+ * @brief Una línea del manifiesto.
+ */
+
+struct EntradaCorpus
+{
+    string ruta;
+    long long bytes;
+    string tipo;
+    string hash;
+};
+
+// Uniforme en [0, 1) con los 53 bits altos
+double uniformeCorpus(mt19937_64 &azar)
+{
+    return (azar() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Normal estándar por Box-Muller
+double normalCorpus(mt19937_64 &azar)
+{
+    double u1 = 1.0 - uniformeCorpus(azar), u2 = uniformeCorpus(azar);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/**
+ * @brief Texto de una línea con la configuración (la cabecera del manifiesto, sin el "# corpus").
+ */
+string describirConfiguracionCorpus(const ConfiguracionCorpus &c)
+{
+    ostringstream oss;
+    oss << setprecision(15) << "semilla=" << c.semilla << " bytes=" << c.bytes << " archivos=" << c.archivos
+        << " distribucion=" << nombresDistribuciones[c.distribucion] << " forma=" << c.forma << " letras=" << c.letras
+        << " digitos=" << c.digitos << " noascii=" << c.noAscii << " binarios=" << c.binarios << " dispersos=" << c.dispersos;
+    return oss.str();
+}
+
+/**
+ * @brief Asigna una opción "clave=valor" a la configuración.
+ *
+ * @return bool false si la clave o el valor no son válidos.
+ */
+bool asignarOpcionCorpus(ConfiguracionCorpus &c, const string &clave, const string &valor)
+{
+    if (clave == "distribucion")
+    {
+        for (int d = 0; d < NUM_DISTRIBUCIONES; d++)
+            if (valor == nombresDistribuciones[d])
+            {
+                c.distribucion = static_cast<DistribucionTamanos>(d);
+                return true;
+            }
+        return false;
+    }
+
+    // El valor tiene que ser un número completo: "abc", "12abc" o uno fuera de rango no valen
+    size_t leidos = 0;
+    try
+    {
+        if (clave == "semilla")
+            c.semilla = stoull(valor, &leidos);
+        else if (clave == "bytes")
+            c.bytes = stoll(valor, &leidos);
+        else if (clave == "archivos")
+            c.archivos = stoi(valor, &leidos);
+        else if (clave == "forma")
+            c.forma = stod(valor, &leidos);
+        else if (clave == "letras")
+            c.letras = stod(valor, &leidos);
+        else if (clave == "digitos")
+            c.digitos = stod(valor, &leidos);
+        else if (clave == "noascii")
+            c.noAscii = stod(valor, &leidos);
+        else if (clave == "binarios")
+            c.binarios = stod(valor, &leidos);
+        else if (clave == "dispersos")
+            c.dispersos = stod(valor, &leidos);
+        else
+            return false;
+    }
+    catch (const invalid_argument &)
+    {
+        return false;
+    }
+    catch (const out_of_range &)
+    {
+        return false;
+    }
+    return leidos == valor.size();
+}
+
+/**
+ * @brief Tamaños de los archivos: pesos según la distribución, escalados al total.
+ */
+vector<long long> tamanosCorpus(const ConfiguracionCorpus &c)
+{
+    mt19937_64 azar(c.semilla);
+    int n = max(1, c.archivos);
+    vector<double> pesos(n);
+    double suma = 0;
+    for (auto &p : pesos)
+    {
+        switch (c.distribucion)
+        {
+        case TAMANOS_FIJOS:
+            p = 1.0;
+            break;
+        case TAMANOS_UNIFORMES:
+            p = 0.5 + uniformeCorpus(azar);
+            break;
+        case TAMANOS_LOGNORMALES:
+            p = exp(c.forma * normalCorpus(azar));
+            break;
+        default:
+            p = pow(1.0 - uniformeCorpus(azar), -1.0 / max(0.1, c.forma)); // Inversa de la Pareto con mínimo 1
+            break;
+        }
+        suma += p;
+    }
+
+    vector<long long> tamanos(n);
+    long long asignados = 0;
+    for (int k = 0; k < n; k++)
+    {
+        tamanos[k] = static_cast<long long>(floor(c.bytes * (pesos[k] / suma)));
+        asignados += tamanos[k];
+    }
+    tamanos[n - 1] += c.bytes - asignados; // El redondeo va al último
+    return tamanos;
+}
+
+// Rellena un bloque según el tipo de archivo y la mezcla de caracteres
+void rellenarBloqueCorpus(char *bloque, size_t largo, TipoArchivoCorpus tipo, const ConfiguracionCorpus &c, mt19937_64 &azar)
+{
+    static const char letras[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static const char otros[] = " .,;:!?\n";
+    if (tipo == CORPUS_BINARIO)
+    {
+        for (size_t j = 0; j < largo; j++)
+            bloque[j] = static_cast<char>(azar() & 0xFF);
+        return;
+    }
+    double limiteLetras = c.letras, limiteDigitos = limiteLetras + c.digitos, limiteNoAscii = limiteDigitos + c.noAscii;
+    for (size_t j = 0; j < largo; j++)
+    {
+        unsigned long long r = azar();
+        double u = (r >> 11) * (1.0 / 9007199254740992.0);
+        if (u < limiteLetras)
+            bloque[j] = letras[r % 52];
+        else if (u < limiteDigitos)
+            bloque[j] = static_cast<char>('0' + r % 10);
+        else if (u < limiteNoAscii)
+            bloque[j] = static_cast<char>(0x80 | (r & 0x7F));
+        else
+            bloque[j] = otros[r % 8];
+    }
+}
+
+/**
+ * @brief SHA-256 de un archivo leído por bloques (no lo carga entero en memoria).
+ */
+string hashArchivoPorBloques(const string &ruta)
+{
+    ifstream entrada(ruta, ios::binary);
+    if (!entrada.is_open())
+        return "";
+    sha256 contexto;
+    vector<char> bloque(TAMANO_BLOQUE);
+    while (entrada.read(bloque.data(), bloque.size()) || entrada.gcount() > 0)
+        contexto.sha_append(reinterpret_cast<const BYTE *>(bloque.data()), entrada.gcount());
+    return contexto.sha_digest();
+}
+
+/**
+ * @brief Genera un archivo del corpus.
+ *
+ * @return bool false si no se pudo escribir.
+ */
+bool generarArchivoCorpus(const string &ruta, long long bytes, TipoArchivoCorpus tipo, const ConfiguracionCorpus &c, unsigned long long semillaArchivo)
+{
+    mt19937_64 azar(semillaArchivo);
+    int fd = open(ruta.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        cerr << "No se pudo crear " << ruta << endl;
+        return false;
+    }
+
+    vector<char> bloque(TAMANO_BLOQUE);
+    bool correcto = true;
+    if (tipo == CORPUS_DISPERSO)
+    {
+        // Tamaño final con ftruncate (todo huecos) y un bloque de texto al comienzo de cada MiB
+        correcto = ftruncate(fd, bytes) == 0;
+        for (long long desplazamiento = 0; correcto && desplazamiento < bytes; desplazamiento += SEPARACION_DISPERSO)
+        {
+            size_t largo = static_cast<size_t>(min<long long>(bloque.size(), bytes - desplazamiento));
+            rellenarBloqueCorpus(bloque.data(), largo, CORPUS_TEXTO, c, azar);
+            correcto = pwrite(fd, bloque.data(), largo, desplazamiento) == static_cast<ssize_t>(largo);
+        }
+    }
+    else
+    {
+        for (long long restantes = bytes; correcto && restantes > 0;)
+        {
+            size_t largo = static_cast<size_t>(min<long long>(bloque.size(), restantes));
+            rellenarBloqueCorpus(bloque.data(), largo, tipo, c, azar);
+            correcto = write(fd, bloque.data(), largo) == static_cast<ssize_t>(largo);
+            restantes -= largo;
+        }
+    }
+    close(fd);
+    if (!correcto)
+        cerr << "Error al escribir " << ruta << endl;
+    return correcto;
+}
+
+/**
+ * @brief Genera el corpus en un directorio y escribe su manifiesto.
+ *
+ * @param c Configuración del corpus.
+ * @param directorio Directorio de salida (se crea si no existe; el padre debe existir).
+ * @param rutaManifiesto Ruta del manifiesto (vacía = directorio + "corpus.manifiesto").
+ * @param anteriores Entradas de un manifiesto anterior (regeneración): si no es nulo, los tamaños
+ *                   y tipos se toman de ahí en lugar de calcularlos a partir de la semilla.
+ * @return vector<EntradaCorpus> Archivos generados (vacío si hubo un error).
+ */
+vector<EntradaCorpus> generarCorpus(const ConfiguracionCorpus &c, string directorio, string rutaManifiesto = "",
+                                    const vector<EntradaCorpus> *anteriores = nullptr)
+{
+    if (!directorio.empty() && directorio.back() != '/')
+        directorio += '/';
+    if (rutaManifiesto.empty())
+        rutaManifiesto = directorio + "corpus.manifiesto";
+    vector<EntradaCorpus> entradas;
+    if (!crearDirectorio(directorio))
+    {
+        cerr << "No se pudo crear el directorio " << directorio << endl;
+        return entradas;
+    }
+
+    vector<long long> tamanos;
+    vector<TipoArchivoCorpus> tipos;
+    if (anteriores != nullptr)
+    {
+        for (const auto &e : *anteriores)
+        {
+            int t = 0;
+            while (t < NUM_TIPOS_CORPUS && e.tipo != nombresTiposCorpus[t])
+                t++;
+            if (t == NUM_TIPOS_CORPUS || e.bytes < 0)
+            {
+                cerr << "Entrada invalida en el manifiesto: " << e.ruta << endl;
+                return entradas;
+            }
+            tamanos.push_back(e.bytes);
+            tipos.push_back(static_cast<TipoArchivoCorpus>(t));
+        }
+    }
+    else
+    {
+        tamanos = tamanosCorpus(c);
+        mt19937_64 azarTipos(c.semilla ^ 0x9E3779B97F4A7C15ULL);
+        for (size_t k = 0; k < tamanos.size(); k++)
+        {
+            double u = uniformeCorpus(azarTipos);
+            tipos.push_back(u < c.binarios ? CORPUS_BINARIO : u < c.binarios + c.dispersos ? CORPUS_DISPERSO
+                                                                                           : CORPUS_TEXTO);
+        }
+    }
+
+    int digitos = static_cast<int>(to_string(tamanos.size()).size());
+    for (size_t k = 0; k < tamanos.size(); k++)
+    {
+        TipoArchivoCorpus tipo = tipos[k];
+        ostringstream nombre;
+        nombre << directorio << "c" << setw(digitos) << setfill('0') << k << (tipo == CORPUS_BINARIO ? ".bin" : ".txt");
+
+        // Cada archivo tiene su propia semilla: se puede regenerar uno sin generar los anteriores
+        unsigned long long semillaArchivo = c.semilla * 6364136223846793005ULL + 1442695040888963407ULL * (k + 1);
+        if (!generarArchivoCorpus(nombre.str(), tamanos[k], tipo, c, semillaArchivo))
+            return {};
+        entradas.push_back({nombre.str(), tamanos[k], nombresTiposCorpus[tipo], hashArchivoPorBloques(nombre.str())});
+    }
+
+    ofstream manifiesto(rutaManifiesto);
+    if (!manifiesto.is_open())
+    {
+        cerr << "No se pudo crear " << rutaManifiesto << endl;
+        return {};
+    }
+    manifiesto << "# corpus " << describirConfiguracionCorpus(c) << "\n";
+    for (const auto &e : entradas)
+        manifiesto << e.ruta << "\t" << e.bytes << "\t" << e.tipo << "\t" << e.hash << "\n";
+    return entradas;
+}
+
+/**
+ * @brief Lee un manifiesto: su configuración (de la cabecera) y sus entradas.
+ *
+ * @return bool false si no se pudo abrir o la cabecera no es válida.
+ */
+bool leerManifiestoCorpus(const string &ruta, ConfiguracionCorpus &c, vector<EntradaCorpus> &entradas)
+{
+    ifstream manifiesto(ruta);
+    if (!manifiesto.is_open())
+    {
+        cerr << "No se pudo abrir el manifiesto " << ruta << endl;
+        return false;
+    }
+    string linea;
+    while (getline(manifiesto, linea))
+    {
+        if (linea.compare(0, 9, "# corpus ") == 0)
+        {
+            istringstream opciones(linea.substr(9));
+            string opcion;
+            while (opciones >> opcion)
+            {
+                size_t igual = opcion.find('=');
+                if (igual == string::npos || !asignarOpcionCorpus(c, opcion.substr(0, igual), opcion.substr(igual + 1)))
+                {
+                    cerr << "Opcion invalida en el manifiesto: " << opcion << endl;
+                    return false;
+                }
+            }
+            continue;
+        }
+        if (linea.empty() || linea[0] == '#')
+            continue;
+        istringstream campos(linea);
+        EntradaCorpus e;
+        string bytes;
+        getline(campos, e.ruta, '\t');
+        getline(campos, bytes, '\t');
+        getline(campos, e.tipo, '\t');
+        getline(campos, e.hash, '\t');
+        e.bytes = atoll(bytes.c_str());
+        entradas.push_back(e);
+    }
+    return true;
+}
+
+/**
+ * @brief Comprueba que los archivos del manifiesto existen con el tamaño y el hash anotados.
+ *
+ * @return int Cantidad de archivos que no coinciden.
+ */
+int verificarCorpus(const vector<EntradaCorpus> &entradas)
+{
+    int distintos = 0;
+    for (const auto &e : entradas)
+    {
+        if (devolverTamanoArchivo(e.ruta) != e.bytes || hashArchivoPorBloques(e.ruta) != e.hash)
+        {
+            cerr << "No coincide: " << e.ruta << endl;
+            distintos++;
+        }
+    }
+    return distintos;
+}
+
+#endif // F25_CORPUS_H
@@ -0,0 +1,210 @@
+/**
+ * @file F26_memoria.h
+ * @brief Contabilidad de memoria: reserva por etapa y por proceso, y memoria residente máxima.
+ *
+ * Reemplaza los operator new/delete globales (también los alineados) por versiones que, con el rastreo activado
+ * (activarRastreoMemoria, opción --memoria), suman en contadores propios de cada hilo los bytes
+ * pedidos, la cantidad de reservas y los bytes vivos. MedicionMemoria toma una instantánea al
+ * empezar una etapa o un proceso y da al terminar lo reservado y el pico de bytes vivos por
+ * encima del punto de partida (ver CronometroEtapa en F11_pipeline_fusionado.h). Con el rastreo
+ * apagado cada new solo lee un atómico antes de llamar a malloc.
+ *
+ * Un programa solo puede reemplazar los operadores una vez, y este archivo llega a todas las
+ * pruebas y benchmarks a través de F11_pipeline_fusionado.h, así que los operadores solo se
+ * definen si el programa define REEMPLAZAR_OPERADORES_MEMORIA antes de incluirlo (lo hace
+ * main.cpp). Sin esa macro, o con -DSIN_RASTREO_MEMORIA, MedicionMemoria no mide nada.
+ *
+ * Los contadores son del hilo: un bloque liberado en otro hilo resta de los vivos del hilo que
+ * lo libera, así que el pico es una aproximación cuando la memoria cambia de hilo. En el reactor
+ * de corrutinas varios procesos se intercalan en un hilo y cada etapa suma también lo que los
+ * demás reservan mientras tanto. Los bytes vivos se miden con malloc_usable_size, que incluye el
+ * redondeo del asignador.
+ *
+ * La memoria residente (VmRSS) y su máximo (VmHWM) se leen de /proc/self/status.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F26_MEMORIA_H
+#define F26_MEMORIA_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__) && __has_include(<malloc.h>)
+#include <malloc.h>
+#define TAMANO_RESERVA(p) malloc_usable_size(p)
+#else
+#define TAMANO_RESERVA(p) 0 // Sin el tamaño real no se pueden seguir los bytes vivos
+#endif
+
+/**
+ * @struct ContadoresMemoriaHilo
+ * @brief Reservas del hilo desde que arrancó. Sin constructor: el hilo lo usa sin inicializarlo.
+ */
+
+struct ContadoresMemoriaHilo
+{
+    long long bytes;        // Bytes pedidos a new
+    long long asignaciones; // Llamadas a new
+    long long vivos;        // Bytes reservados y aún no liberados por este hilo
+    long long pico;         // Máximo de vivos desde la última MedicionMemoria
+};
+
+thread_local ContadoresMemoriaHilo memoriaHilo;
+atomic<bool> rastreoMemoria(false);
+
+void activarRastreoMemoria() { rastreoMemoria.store(true); }
+bool rastreoMemoriaActivo() { return rastreoMemoria.load(memory_order_relaxed); }
+
+#if defined(REEMPLAZAR_OPERADORES_MEMORIA) && !defined(SIN_RASTREO_MEMORIA)
+/**
+ * @brief Reserva como el operator new estándar: si no hay memoria llama al new_handler
+ * instalado y lo vuelve a intentar, y solo lanza bad_alloc si no hay ninguno.
+ *
+ * @param alineacion Alineación pedida con align_val_t (0 = la de malloc).
+ */
+void *reservarRastreado(size_t bytes, size_t alineacion = 0)
+{
+    if (bytes == 0)
+        bytes = 1;
+    void *p = nullptr;
+    while (true)
+    {
+        if (alineacion == 0)
+            p = malloc(bytes);
+        else if (posix_memalign(&p, max(alineacion, sizeof(void *)), bytes) != 0)
+            p = nullptr;
+        if (p != nullptr)
+            break;
+        new_handler manejador = get_new_handler();
+        if (manejador == nullptr)
+            throw bad_alloc();
+        manejador();
+    }
+    if (rastreoMemoria.load(memory_order_relaxed))
+    {
+        ContadoresMemoriaHilo &m = memoriaHilo;
+        m.bytes += bytes;
+        m.asignaciones++;
+        m.vivos += TAMANO_RESERVA(p);
+        if (m.vivos > m.pico)
+            m.pico = m.vivos;
+    }
+    return p;
+}
+
+void liberarRastreado(void *p) noexcept
+{
+    if (p == nullptr)
+        return;
+    if (rastreoMemoria.load(memory_order_relaxed))
+        memoriaHilo.vivos -= TAMANO_RESERVA(p);
+    free(p);
+}
+
+// Las versiones nothrow de la biblioteca estándar llaman a estas
+void *operator new(size_t bytes) { return reservarRastreado(bytes); }
+void *operator new[](size_t bytes) { return reservarRastreado(bytes); }
+void *operator new(size_t bytes, align_val_t alineacion) { return reservarRastreado(bytes, static_cast<size_t>(alineacion)); }
+void *operator new[](size_t bytes, align_val_t alineacion) { return reservarRastreado(bytes, static_cast<size_t>(alineacion)); }
+void operator delete(void *p) noexcept { liberarRastreado(p); }
+void operator delete[](void *p) noexcept { liberarRastreado(p); }
+void operator delete(void *p, size_t) noexcept { liberarRastreado(p); }
+void operator delete[](void *p, size_t) noexcept { liberarRastreado(p); }
+void operator delete(void *p, align_val_t) noexcept { liberarRastreado(p); }
+void operator delete[](void *p, align_val_t) noexcept { liberarRastreado(p); }
+void operator delete(void *p, size_t, align_val_t) noexcept { liberarRastreado(p); }
+void operator delete[](void *p, size_t, align_val_t) noexcept { liberarRastreado(p); }
+#endif
+
+/**
+ * @class MedicionMemoria
+ * @brief Lo que reserva el hilo entre iniciar() y terminar(). Se pueden anidar.
+ */
+
+class MedicionMemoria
+{
+private:
+    ContadoresMemoriaHilo *hilo; // Contadores del hilo donde empezó (nulo = sin medir)
+    long long bytesInicio, asignacionesInicio, vivosInicio, picoAnterior;
+
+public:
+    MedicionMemoria() : hilo(nullptr), bytesInicio(0), asignacionesInicio(0), vivosInicio(0), picoAnterior(0) {}
+
+    void iniciar()
+    {
+        if (!rastreoMemoriaActivo())
+            return;
+        hilo = &memoriaHilo;
+        bytesInicio = hilo->bytes;
+        asignacionesInicio = hilo->asignaciones;
+        vivosInicio = hilo->vivos;
+        picoAnterior = hilo->pico; // El pico se reinicia para esta medición y se restaura al terminar
+        hilo->pico = hilo->vivos;
+    }
+
+    /**
+     * @brief Da lo reservado desde iniciar() y el pico de bytes vivos sobre el punto de partida.
+     *
+     * @return bool false si no se midió o la medición acabó en otro hilo (corrutinas).
+     */
+    bool terminar(long long &bytes, long long &asignaciones, long long &pico)
+    {
+        if (hilo == nullptr || hilo != &memoriaHilo)
+            return false;
+        bytes = hilo->bytes - bytesInicio;
+        asignaciones = hilo->asignaciones - asignacionesInicio;
+        pico = hilo->pico - vivosInicio;
+        hilo->pico = max(hilo->pico, picoAnterior);
+        hilo = nullptr;
+        return true;
+    }
+};
+
+/**
+ * @brief Lee un campo en kB de /proc/self/status ("VmRSS", "VmHWM", ...).
+ *
+ * @return long long KiB, o -1 si no está disponible.
+ */
+long long leerMemoriaProceso(const string &campo)
+{
+    ifstream estado("/proc/self/status");
+    string linea;
+    while (getline(estado, linea))
+        if (linea.compare(0, campo.size(), campo) == 0 && linea.size() > campo.size() && linea[campo.size()] == ':')
+            return atoll(linea.c_str() + campo.size() + 1);
+    return -1;
+}
+
+// Actualiza un máximo compartido entre hilos
+void actualizarMaximo(atomic<long long> &maximo, long long valor)
+{
+    long long actual = maximo.load(memory_order_relaxed);
+    while (valor > actual && !maximo.compare_exchange_weak(actual, valor, memory_order_relaxed))
+        ;
+}
+
+/**
+ * @brief Bytes en unidades legibles (B, KiB, MiB, GiB).
+ */
+string formatearBytes(double bytes)
+{
+    const char *unidades[] = {"B", "KiB", "MiB", "GiB"};
+    int u = 0;
+    while (bytes >= 1024 && u < 3)
+    {
+        bytes /= 1024;
+        u++;
+    }
+    ostringstream oss;
+    oss << fixed << setprecision(u == 0 ? 0 : 1) << bytes << " " << unidades[u];
+    return oss.str();
+}
+
+#endif // F26_MEMORIA_H
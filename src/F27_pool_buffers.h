@@ -0,0 +1,369 @@
+/**
+ * @file F27_pool_buffers.h
+ * @brief Pool de buffers por hilo para la memoria de E/S y de trabajo de cada proceso.
+ *
+ * Cada proceso abre varios flujos (cada uno reserva su buffer interno al abrirse) y lee o
+ * transforma bloques en memoria temporal; con N hilos trabajando eso son reservas y
+ * liberaciones continuas. BufferPrestado toma un buffer del pool del hilo y lo devuelve al
+ * destruirse, así que en régimen estable el pipeline no reserva memoria.
+ *
+ * Organización (tipo slab):
+ * - Los tamaños se redondean a clases potencia de dos, de 4 KiB a 64 MiB. Cada hilo guarda una
+ *   lista de buffers libres por clase, sin mutex.
+ * - Las clases menores de 2 MiB se cortan de bloques de 2 MiB alineados (arenas), que pueden
+ *   ir respaldados por páginas grandes transparentes (activarPaginasGrandes, madvise); las
+ *   mayores se reservan con su propio mmap. Cada clase corta de su propia arena, así que una
+ *   arena se reparte entera en buffers del mismo tamaño sin sobrantes, y todos los buffers
+ *   quedan alineados a página (mbind y el primer toque trabajan por páginas; ver bufferLocal
+ *   en F17_afinidad.h). La memoria no se devuelve al sistema.
+ * - Si un hilo acumula demasiados libres de una clase, o termina, los pasa a un depósito común
+ *   de donde los toman los demás hilos antes de reservar memoria nueva (los pools con hilos que
+ *   nacen y mueren, como el de un hilo por copia, también reutilizan).
+ * - Un buffer que se devuelve desde otro hilo (corrutinas que cambian de hilo) entra al pool
+ *   de ese hilo: la memoria es común a todo el programa.
+ * Los pedidos mayores de 64 MiB, o todos con desactivarPoolBuffers, van directos a new[].
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F27_POOL_BUFFERS_H
+#define F27_POOL_BUFFERS_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include <atomic>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/**
+ * @def CLASE_MINIMA_POOL / CLASE_MAXIMA_POOL
+ * @brief Exponentes de la menor (4 KiB) y la mayor (64 MiB) clase de tamaño del pool.
+ */
+#define CLASE_MINIMA_POOL 12
+#define CLASE_MAXIMA_POOL 26
+#define NUM_CLASES_POOL (CLASE_MAXIMA_POOL - CLASE_MINIMA_POOL + 1)
+
+/**
+ * @def TAMANO_ARENA_POOL
+ * @brief Bloques de los que se cortan las clases pequeñas; coincide con una página grande de x86-64.
+ */
+#define TAMANO_ARENA_POOL (2 * 1024 * 1024)
+
+/**
+ * @def LIBRES_POR_CLASE_POOL
+ * @brief Buffers libres de una clase que guarda cada hilo; el resto pasa al depósito común.
+ */
+#define LIBRES_POR_CLASE_POOL 8
+
+/**
+ * @struct EstadisticasPool
+ * @brief Contadores del pool (de todos los hilos al consultarlos con estadisticasPoolBuffers).
+ */
+
+struct EstadisticasPool
+{
+    long long prestamos = 0;    // Buffers pedidos
+    long long aciertos = 0;     // Servidos desde la lista del hilo
+    long long deposito = 0;     // Servidos desde el depósito común
+    long long reservas = 0;     // Buffers nuevos cortados de la arena o reservados
+    long long directos = 0;     // Pedidos fuera del pool (demasiado grandes o pool desactivado)
+    long long bytesMapeados = 0; // Memoria total obtenida del sistema para el pool
+    long long enUso = 0;        // Bytes prestados en este momento
+    long long picoEnUso = 0;    // Máximo de bytes prestados a la vez (suma de los máximos de cada hilo)
+};
+
+atomic<bool> poolBuffersActivo(true);
+atomic<bool> paginasGrandesPool(false);
+
+void desactivarPoolBuffers() { poolBuffersActivo.store(false); }
+void activarPaginasGrandes() { paginasGrandesPool.store(true); }
+
+class PoolBuffersHilo;
+
+/**
+ * @struct EstadoGlobalPool
+ * @brief Lo compartido entre hilos: depósito de libres, arenas y registro de pools vivos.
+ */
+
+struct EstadoGlobalPool
+{
+    mutex m;
+    vector<char *> libres[NUM_CLASES_POOL];
+    vector<PoolBuffersHilo *> pools;
+    EstadisticasPool retiradas; // Contadores de los hilos que ya terminaron
+    atomic<long long> bytesMapeados{0};
+    char *arenas[NUM_CLASES_POOL] = {}; // Arena de TAMANO_ARENA_POOL de la que corta cada clase pequeña
+    size_t usadoArena[NUM_CLASES_POOL] = {};
+};
+
+EstadoGlobalPool &estadoGlobalPool()
+{
+    static EstadoGlobalPool *estado = new EstadoGlobalPool(); // No se destruye: los hilos pueden terminar después de main
+    return *estado;
+}
+
+// Memoria nueva del sistema, alineada a 2 MiB si se piden páginas grandes
+char *mapearMemoriaPool(size_t bytes)
+{
+#ifdef __linux__
+    bool grandes = paginasGrandesPool.load(memory_order_relaxed);
+    size_t extra = grandes ? TAMANO_ARENA_POOL : 0;
+    void *memoria = mmap(nullptr, bytes + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memoria == MAP_FAILED)
+        return nullptr;
+    char *inicio = static_cast<char *>(memoria);
+    if (grandes)
+    {
+        // Se recorta el sobrante para dejar la región alineada
+        uintptr_t direccion = reinterpret_cast<uintptr_t>(inicio);
+        size_t antes = (TAMANO_ARENA_POOL - direccion % TAMANO_ARENA_POOL) % TAMANO_ARENA_POOL;
+        if (antes > 0)
+            munmap(inicio, antes);
+        if (extra - antes > 0)
+            munmap(inicio + antes + bytes, extra - antes);
+        inicio += antes;
+#ifdef MADV_HUGEPAGE
+        madvise(inicio, bytes, MADV_HUGEPAGE); // Si el núcleo no lo admite, quedan páginas normales
+#endif
+    }
+    estadoGlobalPool().bytesMapeados += bytes;
+    return inicio;
+#else
+    estadoGlobalPool().bytesMapeados += bytes;
+    return new (nothrow) char[bytes];
+#endif
+}
+
+// Corta un buffer nuevo de una clase: de la arena de su clase las pequeñas, con su propio mapeo las grandes
+char *reservarClasePool(int clase)
+{
+    size_t bytes = size_t(1) << (clase + CLASE_MINIMA_POOL);
+    if (bytes >= TAMANO_ARENA_POOL)
+        return mapearMemoriaPool(bytes);
+
+    EstadoGlobalPool &estado = estadoGlobalPool();
+    lock_guard<mutex> lock(estado.m);
+    if (estado.arenas[clase] == nullptr || estado.usadoArena[clase] == TAMANO_ARENA_POOL)
+    {
+        // La arena anterior ya se cortó entera: los tamaños son potencias de dos que dividen 2 MiB
+        estado.arenas[clase] = mapearMemoriaPool(TAMANO_ARENA_POOL);
+        estado.usadoArena[clase] = 0;
+        if (estado.arenas[clase] == nullptr)
+            return nullptr;
+    }
+    char *buffer = estado.arenas[clase] + estado.usadoArena[clase];
+    estado.usadoArena[clase] += bytes;
+    return buffer;
+}
+
+/**
+ * @class PoolBuffersHilo
+ * @brief Listas de buffers libres de un hilo. Solo las toca su hilo; los contadores son atómicos
+ * para que otro hilo pueda leerlos.
+ */
+
+class PoolBuffersHilo
+{
+private:
+    vector<char *> libres[NUM_CLASES_POOL];
+    atomic<long long> prestamos{0}, aciertos{0}, deposito{0}, reservas{0}, directos{0}, enUso{0}, picoEnUso{0};
+
+    static void sumar(atomic<long long> &contador, long long valor) { contador.store(contador.load(memory_order_relaxed) + valor, memory_order_relaxed); }
+
+public:
+    PoolBuffersHilo()
+    {
+        EstadoGlobalPool &estado = estadoGlobalPool();
+        lock_guard<mutex> lock(estado.m);
+        estado.pools.push_back(this);
+    }
+
+    ~PoolBuffersHilo()
+    {
+        EstadoGlobalPool &estado = estadoGlobalPool();
+        lock_guard<mutex> lock(estado.m);
+        for (int c = 0; c < NUM_CLASES_POOL; c++)
+            estado.libres[c].insert(estado.libres[c].end(), libres[c].begin(), libres[c].end());
+        sumarEstadisticas(estado.retiradas);
+        for (size_t k = 0; k < estado.pools.size(); k++)
+            if (estado.pools[k] == this)
+            {
+                estado.pools.erase(estado.pools.begin() + k);
+                break;
+            }
+    }
+
+    PoolBuffersHilo(const PoolBuffersHilo &) = delete;
+    PoolBuffersHilo &operator=(const PoolBuffersHilo &) = delete;
+
+    // Clase de un tamaño, o -1 si no entra en el pool
+    static int clase(size_t bytes)
+    {
+        int c = 0;
+        while (c < NUM_CLASES_POOL && (size_t(1) << (c + CLASE_MINIMA_POOL)) < bytes)
+            c++;
+        return c < NUM_CLASES_POOL ? c : -1;
+    }
+
+    char *prestar(int c)
+    {
+        sumar(prestamos, 1);
+        char *buffer = nullptr;
+        if (!libres[c].empty())
+        {
+            buffer = libres[c].back();
+            libres[c].pop_back();
+            sumar(aciertos, 1);
+        }
+        else
+        {
+            EstadoGlobalPool &estado = estadoGlobalPool();
+            {
+                lock_guard<mutex> lock(estado.m);
+                if (!estado.libres[c].empty())
+                {
+                    buffer = estado.libres[c].back();
+                    estado.libres[c].pop_back();
+                }
+            }
+            if (buffer != nullptr)
+                sumar(deposito, 1);
+            else if ((buffer = reservarClasePool(c)) != nullptr)
+                sumar(reservas, 1);
+            else
+                return nullptr;
+        }
+        sumar(enUso, size_t(1) << (c + CLASE_MINIMA_POOL));
+        if (enUso.load(memory_order_relaxed) > picoEnUso.load(memory_order_relaxed))
+            picoEnUso.store(enUso.load(memory_order_relaxed), memory_order_relaxed);
+        return buffer;
+    }
+
+    void devolver(char *buffer, int c)
+    {
+        sumar(enUso, -(static_cast<long long>(1) << (c + CLASE_MINIMA_POOL)));
+        if (libres[c].size() < LIBRES_POR_CLASE_POOL)
+        {
+            libres[c].push_back(buffer);
+            return;
+        }
+        EstadoGlobalPool &estado = estadoGlobalPool();
+        lock_guard<mutex> lock(estado.m);
+        estado.libres[c].push_back(buffer);
+    }
+
+    void contarDirecto() { sumar(directos, 1); }
+
+    void sumarEstadisticas(EstadisticasPool &e) const
+    {
+        e.prestamos += prestamos;
+        e.aciertos += aciertos;
+        e.deposito += deposito;
+        e.reservas += reservas;
+        e.directos += directos;
+        e.enUso += enUso;
+        e.picoEnUso += picoEnUso;
+    }
+};
+
+// Pool del hilo que llama (se crea la primera vez)
+PoolBuffersHilo &poolBuffersHilo()
+{
+    thread_local PoolBuffersHilo pool;
+    return pool;
+}
+
+/**
+ * @class BufferPrestado
+ * @brief Buffer de al menos 'tamano' bytes tomado del pool del hilo y devuelto al destruirse.
+ *
+ * El contenido inicial es indeterminado (puede traer datos de un préstamo anterior).
+ */
+
+class BufferPrestado
+{
+private:
+    char *buffer;
+    size_t capacidad;
+    int clase; // -1 = reservado fuera del pool
+
+public:
+    explicit BufferPrestado(size_t tamano) : buffer(nullptr), capacidad(tamano), clase(-1)
+    {
+        if (poolBuffersActivo.load(memory_order_relaxed))
+            clase = PoolBuffersHilo::clase(tamano);
+        if (clase >= 0 && (buffer = poolBuffersHilo().prestar(clase)) != nullptr)
+        {
+            capacidad = size_t(1) << (clase + CLASE_MINIMA_POOL);
+            return;
+        }
+        clase = -1;
+        poolBuffersHilo().contarDirecto();
+        buffer = new char[tamano > 0 ? tamano : 1];
+    }
+
+    ~BufferPrestado()
+    {
+        if (clase >= 0)
+            poolBuffersHilo().devolver(buffer, clase);
+        else
+            delete[] buffer;
+    }
+
+    BufferPrestado(const BufferPrestado &) = delete;
+    BufferPrestado &operator=(const BufferPrestado &) = delete;
+
+    char *datos() const { return buffer; }
+    size_t tamano() const { return capacidad; }
+};
+
+/**
+ * @brief Da a un flujo de archivo un buffer prestado y lo abre.
+ *
+ * El buffer debe vivir más que el flujo (declararlo antes). Así el flujo no reserva su propio
+ * buffer al abrirse, y con TAMANO_BLOQUE hace menos llamadas al sistema que con el de 8 KiB.
+ */
+template <class Flujo>
+void abrirConBuffer(Flujo &flujo, const string &ruta, ios::openmode modo, BufferPrestado &buffer)
+{
+    flujo.rdbuf()->pubsetbuf(buffer.datos(), static_cast<streamsize>(buffer.tamano()));
+    flujo.open(ruta, modo);
+}
+
+/**
+ * @brief Suma los contadores de todos los hilos (vivos y terminados).
+ */
+EstadisticasPool estadisticasPoolBuffers()
+{
+    EstadoGlobalPool &estado = estadoGlobalPool();
+    lock_guard<mutex> lock(estado.m);
+    EstadisticasPool e = estado.retiradas;
+    e.enUso = 0; // Lo prestado por hilos terminados ya se devolvió
+    for (const PoolBuffersHilo *pool : estado.pools)
+        pool->sumarEstadisticas(e);
+    e.bytesMapeados = estado.bytesMapeados;
+    return e;
+}
+
+/**
+ * @brief Una línea con los contadores del pool y el porcentaje de préstamos sin memoria nueva.
+ */
+string describirPoolBuffers()
+{
+    EstadisticasPool e = estadisticasPoolBuffers();
+    ostringstream oss;
+    oss << "Pool de buffers: ";
+    if (!poolBuffersActivo)
+        return oss.str() + "desactivado (" + to_string(e.directos) + " buffers reservados con new)";
+    double reutilizados = e.prestamos > 0 ? 100.0 * (e.aciertos + e.deposito) / e.prestamos : 0.0;
+    oss << fixed << setprecision(1) << e.prestamos << " prestamos (" << reutilizados << " % reutilizados, " << e.deposito
+        << " del deposito), " << e.reservas << " reservas nuevas, " << e.directos << " fuera del pool, "
+        << e.bytesMapeados / 1048576.0 << " MiB mapeados, pico en uso " << e.picoEnUso / 1048576.0 << " MiB"
+        << (paginasGrandesPool ? ", paginas grandes" : "");
+    return oss.str();
+}
+
+#endif // F27_POOL_BUFFERS_H
@@ -0,0 +1,806 @@
+/**
+ * @file F28_cli.h
+ * @brief Interfaz de línea de comandos no interactiva con subcomandos.
+ *
+ * El modo clásico de main pregunta N por la entrada estándar y ejecuta siempre los dos drivers
+ * sobre los directorios de trabajo fijos. Los subcomandos permiten usar el programa desde
+ * scripts y trabajos por lotes:
+ *
+ *   encrypt  -i ENTRADA -o SALIDA      Encripta un archivo
+ *   decrypt  -i ENTRADA -o SALIDA      Desencripta un archivo
+ *   hash     -i ARCHIVO [...]          SHA-256 de uno o varios archivos
+ *   verify   -i ORIGINAL -e ENCRIPTADO Comprueba que desencriptar ENCRIPTADO da ORIGINAL
+ *   verify   -i ARCHIVO --sha256 HASH  Comprueba el hash de un archivo
+ *   verify   --manifiesto ARCHIVO      Comprueba tamaños y hashes de un manifiesto de corpus (F25_corpus.h)
+ *   pipeline -i ARCHIVO [...] | --lista ARCHIVO | --dir DIR [-o DIR]
+ *                                      Los siete pasos sobre archivos reales (modo por lotes)
+ *   bench    --copias N [--modo paralelo|dag|hilo-por-copia]
+ *                                      Banco de pruebas secuencial frente al modo elegido
+ *
+ * Opciones comunes:
+ *   --backend flujo|bloques|mmap|robo  Forma de hacer la E/S (por defecto bloques):
+ *       flujo    las funciones de F01_archivo.h (ifstream/ofstream carácter a carácter)
+ *       bloques  pread/pwrite por bloques, repartidos entre --hilos
+ *       mmap     el archivo proyectado en memoria, por tramos repartidos entre --hilos
+ *       robo     (solo pipeline) fragmentos con robo de trabajo (F15_robo_trabajo.h)
+ *     En pipeline y bench, bloques es el pipeline fusionado de F11_pipeline_fusionado.h.
+ *   --hilos N         Hilos (por defecto los núcleos disponibles)
+ *   --bloque BYTES    Tamaño de bloque o fragmento (por defecto 64 KiB; 1 MiB con robo)
+ *   --cifrado cesar|ninguno  Cifrado de encrypt/decrypt/verify (ninguno = copia, para medir la E/S)
+ *   --formato texto|json     Formato de la salida
+ *
+ * Códigos de salida: 0 correcto, 1 la verificación falló (hash distinto, contenido distinto o
+ * algún proceso del pipeline incorrecto), 2 error de uso o de E/S.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F06_main_secuencial.h, F07_main_paralelo.h y F12_planificador_dag.h: Los drivers de bench.
+ * - F13_lote.h y F15_robo_trabajo.h: Los drivers de pipeline.
+ * - F24_banco_pruebas.h: El banco de pruebas de bench.
+ * - F25_corpus.h: El manifiesto de verify --manifiesto.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F28_CLI_H
+#define F28_CLI_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F06_main_secuencial.h"
+#include "F07_main_paralelo.h"
+#include "F12_planificador_dag.h"
+#include "F13_lote.h"
+#include "F15_robo_trabajo.h"
+#include "F24_banco_pruebas.h"
+#include "F25_corpus.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SALIDA_CORRECTA 0
+#define SALIDA_VERIFICACION_FALLIDA 1
+#define SALIDA_ERROR_USO 2
+
+enum BackendES
+{
+    ES_FLUJO,
+    ES_BLOQUES,
+    ES_MMAP,
+    ES_ROBO,
+    NUM_BACKENDS
+};
+
+const char *nombresBackends[NUM_BACKENDS] = {"flujo", "bloques", "mmap", "robo"};
+
+enum CifradoCLI
+{
+    CIFRADO_CESAR,
+    CIFRADO_NINGUNO,
+    NUM_CIFRADOS
+};
+
+const char *nombresCifrados[NUM_CIFRADOS] = {"cesar", "ninguno"};
+
+// Subcomandos con su nombre en castellano como alias
+const char *subcomandosCLI[][2] = {{"encrypt", "encriptar"}, {"decrypt", "desencriptar"}, {"hash", "hash"},
+                                   {"verify", "verificar"}, {"bench", "banco"}, {"pipeline", "pipeline"}};
+
+/**
+ * @struct OpcionesCLI
+ * @brief Subcomando y opciones leídas de la línea de comandos.
+ */
+
+struct OpcionesCLI
+{
+    string comando;           // Nombre en inglés del subcomando
+    vector<string> entradas;  // -i (repetible) y argumentos sueltos
+    string salida;            // -o: archivo (encrypt/decrypt) o directorio (pipeline)
+    string encriptado;        // -e: archivo encriptado que verify compara con la entrada
+    string hashEsperado;      // --sha256
+    string manifiesto;        // --manifiesto
+    string lista, directorio; // --lista y --dir de pipeline
+    BackendES backend = ES_BLOQUES;
+    int hilos = 0;
+    long long bloque = 0; // 0 = el valor por defecto del backend
+    CifradoCLI cifrado = CIFRADO_CESAR;
+    bool json = false;
+    int copias = 0;
+    string modo = "paralelo";
+    ConfiguracionBanco banco;
+};
+
+/**
+ * @struct ArchivoCLI
+ * @brief Resultado de un archivo en encrypt, decrypt, hash o verify.
+ */
+
+struct ArchivoCLI
+{
+    string ruta;
+    long long bytes = 0;
+    string hash;
+    bool correcto = true; // En verify: coincide; en los demás: se pudo procesar
+    string error;         // Vacío si se pudo procesar
+};
+
+bool esSubcomandoCLI(const string &nombre)
+{
+    for (const auto &s : subcomandosCLI)
+        if (nombre == s[0] || nombre == s[1])
+            return true;
+    return false;
+}
+
+void mostrarAyudaCLI(ostream &salida)
+{
+    salida << "Uso: crypto SUBCOMANDO [opciones]\n"
+              "  encrypt  -i ENTRADA -o SALIDA\n"
+              "  decrypt  -i ENTRADA -o SALIDA\n"
+              "  hash     -i ARCHIVO [ARCHIVO...]\n"
+              "  verify   -i ORIGINAL -e ENCRIPTADO | -i ARCHIVO --sha256 HASH | --manifiesto ARCHIVO\n"
+              "  pipeline -i ARCHIVO [...] | --lista ARCHIVO | --dir DIR  [-o DIR]\n"
+              "  bench    --copias N [--modo paralelo|dag|hilo-por-copia] [--repeticiones R] [--calentamiento W]\n"
+              "Opciones: --backend flujo|bloques|mmap|robo  --hilos N  --bloque BYTES  --cifrado cesar|ninguno\n"
+              "          --formato texto|json\n"
+              "Salida: 0 correcto, 1 verificacion fallida, 2 error de uso o de E/S\n";
+}
+
+/**
+ * @brief Lee el subcomando (argv[0]) y sus opciones.
+ *
+ * @return bool false si hay una opción desconocida o un valor inválido (el motivo va a cerr).
+ */
+bool leerOpcionesCLI(int argc, char *argv[], OpcionesCLI &o)
+{
+    for (const auto &s : subcomandosCLI)
+        if (argv[0] == string(s[0]) || argv[0] == string(s[1]))
+            o.comando = s[0];
+
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        bool valor = a + 1 < argc;
+        if ((opcion == "-i" || opcion == "--entrada") && valor)
+            o.entradas.push_back(argv[++a]);
+        else if ((opcion == "-o" || opcion == "--salida") && valor)
+            o.salida = argv[++a];
+        else if ((opcion == "-e" || opcion == "--encriptado") && valor)
+            o.encriptado = argv[++a];
+        else if (opcion == "--sha256" && valor)
+            o.hashEsperado = argv[++a];
+        else if (opcion == "--manifiesto" && valor)
+            o.manifiesto = argv[++a];
+        else if (opcion == "--lista" && valor)
+            o.lista = argv[++a];
+        else if (opcion == "--dir" && valor)
+            o.directorio = argv[++a];
+        else if (opcion == "--hilos" && valor)
+            o.hilos = atoi(argv[++a]);
+        else if (opcion == "--bloque" && valor)
+            o.bloque = atoll(argv[++a]);
+        else if (opcion == "--copias" && valor)
+            o.copias = atoi(argv[++a]);
+        else if (opcion == "--modo" && valor)
+            o.modo = argv[++a];
+        else if (opcion == "--repeticiones" && valor)
+            o.banco.repeticiones = atoi(argv[++a]);
+        else if (opcion == "--calentamiento" && valor)
+            o.banco.calentamiento = atoi(argv[++a]);
+        else if (opcion == "--formato" && valor)
+        {
+            string formato = argv[++a];
+            if (formato != "texto" && formato != "json")
+            {
+                cerr << "Formato desconocido: " << formato << endl;
+                return false;
+            }
+            o.json = formato == "json";
+        }
+        else if (opcion == "--backend" && valor)
+        {
+            string nombre = argv[++a];
+            int b = 0;
+            while (b < NUM_BACKENDS && nombre != nombresBackends[b])
+                b++;
+            if (b == NUM_BACKENDS)
+            {
+                cerr << "Backend desconocido: " << nombre << endl;
+                return false;
+            }
+            o.backend = static_cast<BackendES>(b);
+        }
+        else if (opcion == "--cifrado" && valor)
+        {
+            string nombre = argv[++a];
+            int c = 0;
+            while (c < NUM_CIFRADOS && nombre != nombresCifrados[c])
+                c++;
+            if (c == NUM_CIFRADOS)
+            {
+                cerr << "Cifrado desconocido: " << nombre << endl;
+                return false;
+            }
+            o.cifrado = static_cast<CifradoCLI>(c);
+        }
+        else if (!opcion.empty() && opcion[0] != '-')
+            o.entradas.push_back(opcion);
+        else
+        {
+            cerr << "Opcion desconocida o sin valor: " << opcion << endl;
+            return false;
+        }
+    }
+
+    if (o.hilos <= 0)
+        o.hilos = max(1u, thread::hardware_concurrency());
+    if (o.bloque <= 0)
+        o.bloque = o.backend == ES_ROBO ? TAMANO_FRAGMENTO_ROBO : TAMANO_BLOQUE;
+    if (o.backend == ES_ROBO && o.comando != "pipeline")
+    {
+        cerr << "El backend robo solo existe en pipeline" << endl;
+        return false;
+    }
+    return true;
+}
+
+char caracterSinCambios(char c) { return c; }
+
+// Fecha de modificación (st_mtim) en nanosegundos
+long long nanosegundosModificacion(const struct stat &estado) { return estado.st_mtim.tv_sec * 1000000000LL + estado.st_mtim.tv_nsec; }
+
+// Función que aplica el cifrado elegido a cada carácter (o su inversa)
+char (*funcionCifradoCLI(CifradoCLI cifrado, bool descifrar))(char)
+{
+    if (cifrado == CIFRADO_NINGUNO)
+        return caracterSinCambios;
+    return descifrar ? desencriptarCaracter : encriptarCaracter;
+}
+
+// pread/pwrite completos (reintentan las lecturas o escrituras parciales)
+bool leerCompleto(int fd, char *datos, size_t bytes, off_t posicion)
+{
+    while (bytes > 0)
+    {
+        ssize_t n = pread(fd, datos, bytes, posicion);
+        if (n <= 0)
+            return false;
+        datos += n;
+        bytes -= n;
+        posicion += n;
+    }
+    return true;
+}
+
+bool escribirCompleto(int fd, const char *datos, size_t bytes, off_t posicion)
+{
+    while (bytes > 0)
+    {
+        ssize_t n = pwrite(fd, datos, bytes, posicion);
+        if (n <= 0)
+            return false;
+        datos += n;
+        bytes -= n;
+        posicion += n;
+    }
+    return true;
+}
+
+/**
+ * @brief Reparte [0, total) en tramos de 'bloque' bytes entre 'hilos' hilos.
+ *
+ * Cada hilo toma el siguiente tramo libre; si un tramo falla, los demás hilos dejan de tomar.
+ *
+ * @return bool false si algún tramo falló.
+ */
+bool repartirTramos(long long total, long long bloque, int hilos, const function<bool(long long, long long)> &tramo)
+{
+    atomic<long long> siguiente(0);
+    atomic<bool> correcto(true);
+    auto trabajar = [&]
+    {
+        for (long long inicio = siguiente.fetch_add(bloque); inicio < total && correcto; inicio = siguiente.fetch_add(bloque))
+            if (!tramo(inicio, min(total, inicio + bloque)))
+                correcto = false;
+    };
+    hilos = static_cast<int>(max(1LL, min<long long>(hilos, (total + bloque - 1) / bloque)));
+    vector<thread> grupo;
+    for (int h = 1; h < hilos; h++)
+        grupo.emplace_back(trabajar);
+    trabajar(); // El hilo que llama también trabaja
+    for (auto &hilo : grupo)
+        hilo.join();
+    return correcto;
+}
+
+/**
+ * @class ProyeccionArchivo
+ * @brief Archivo abierto y proyectado en memoria con mmap; se libera al destruirse.
+ */
+
+class ProyeccionArchivo
+{
+private:
+    int fd;
+    char *datos;
+    long long bytes;
+
+public:
+    // Solo lectura si escritura es false; si no, crea el archivo con el tamaño indicado
+    ProyeccionArchivo(const string &ruta, bool escritura = false, long long tamano = 0) : fd(-1), datos(nullptr), bytes(0)
+    {
+        fd = escritura ? open(ruta.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : open(ruta.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        bytes = escritura ? tamano : devolverTamanoArchivo(ruta);
+        if (escritura && ftruncate(fd, bytes) != 0)
+            bytes = -1;
+        if (bytes <= 0)
+            return; // Un archivo vacío no se puede proyectar (ni hace falta)
+        void *memoria = mmap(nullptr, bytes, escritura ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (memoria == MAP_FAILED)
+        {
+            bytes = -1;
+            return;
+        }
+        datos = static_cast<char *>(memoria);
+        madvise(datos, bytes, MADV_SEQUENTIAL);
+    }
+
+    ~ProyeccionArchivo()
+    {
+        if (datos != nullptr)
+            munmap(datos, bytes);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    ProyeccionArchivo(const ProyeccionArchivo &) = delete;
+    ProyeccionArchivo &operator=(const ProyeccionArchivo &) = delete;
+
+    bool abierta() const { return fd >= 0 && bytes >= 0; }
+    char *getDatos() const { return datos; }
+    long long getBytes() const { return bytes; }
+};
+
+/**
+ * @brief Aplica el cifrado (o su inversa) a un archivo con el backend elegido.
+ *
+ * @return bool false si no se pudo leer o escribir (el motivo queda en resultado.error).
+ */
+bool transformarArchivoCLI(const string &entrada, const string &salida, bool descifrar, const OpcionesCLI &o, ArchivoCLI &resultado)
+{
+    resultado.ruta = entrada;
+    resultado.bytes = devolverTamanoArchivo(entrada);
+    if (resultado.bytes < 0)
+    {
+        resultado.error = "no se pudo abrir " + entrada;
+        return false;
+    }
+    char (*f)(char) = funcionCifradoCLI(o.cifrado, descifrar);
+
+    if (o.backend == ES_FLUJO)
+    {
+        if (o.cifrado == CIFRADO_NINGUNO)
+            generarCopia(entrada, salida);
+        else if (descifrar)
+            desencriptarArchivo(entrada, salida);
+        else
+            encriptarArchivo(entrada, salida);
+        if (devolverTamanoArchivo(salida) != resultado.bytes)
+            resultado.error = "no se pudo escribir " + salida;
+        return resultado.error.empty();
+    }
+
+    if (o.backend == ES_MMAP)
+    {
+        ProyeccionArchivo origen(entrada), destino(salida, true, resultado.bytes);
+        if (!origen.abierta() || !destino.abierta())
+        {
+            resultado.error = "no se pudo proyectar " + (origen.abierta() ? salida : entrada);
+            return false;
+        }
+        const char *in = origen.getDatos();
+        char *out = destino.getDatos();
+        repartirTramos(resultado.bytes, o.bloque, o.hilos, [&](long long desde, long long hasta)
+                       {
+            for (long long j = desde; j < hasta; j++)
+                out[j] = f(in[j]);
+            return true; });
+        return true;
+    }
+
+    // Bloques con pread/pwrite: cada tramo se transforma en un buffer prestado del hilo
+    int fdEntrada = open(entrada.c_str(), O_RDONLY);
+    int fdSalida = open(salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool correcto = fdEntrada >= 0 && fdSalida >= 0 && ftruncate(fdSalida, resultado.bytes) == 0;
+    if (correcto)
+        correcto = repartirTramos(resultado.bytes, o.bloque, o.hilos, [&](long long desde, long long hasta)
+                                  {
+            BufferPrestado bloque(hasta - desde);
+            char *datos = bloque.datos();
+            if (!leerCompleto(fdEntrada, datos, hasta - desde, desde))
+                return false;
+            for (long long j = 0; j < hasta - desde; j++)
+                datos[j] = f(datos[j]);
+            return escribirCompleto(fdSalida, datos, hasta - desde, desde); });
+    if (fdEntrada >= 0)
+        close(fdEntrada);
+    if (fdSalida >= 0)
+        close(fdSalida);
+    if (!correcto)
+        resultado.error = "error de E/S con " + entrada + " o " + salida;
+    return correcto;
+}
+
+/**
+ * @brief SHA-256 de un archivo con el backend elegido.
+ *
+ * Todos los backends dan el mismo resultado que sha256sum, también con un archivo vacío
+ * (e3b0c442...b855).
+ *
+ * @return bool false si no se pudo leer.
+ */
+bool hashArchivoCLI(const string &ruta, const OpcionesCLI &o, ArchivoCLI &resultado)
+{
+    resultado.ruta = ruta;
+    resultado.bytes = devolverTamanoArchivo(ruta);
+    if (resultado.bytes < 0)
+    {
+        resultado.error = "no se pudo abrir " + ruta;
+        return false;
+    }
+
+    if (o.backend == ES_FLUJO)
+    {
+        resultado.hash = generarHashArchivo(ruta);
+        return true;
+    }
+
+    sha256 contexto;
+    if (o.backend == ES_MMAP)
+    {
+        ProyeccionArchivo archivo(ruta);
+        if (!archivo.abierta())
+        {
+            resultado.error = "no se pudo proyectar " + ruta;
+            return false;
+        }
+        if (archivo.getBytes() > 0)
+            contexto.sha_append(reinterpret_cast<const BYTE *>(archivo.getDatos()), archivo.getBytes());
+    }
+    else
+    {
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            resultado.error = "no se pudo abrir " + ruta;
+            return false;
+        }
+        BufferPrestado bloque(o.bloque);
+        ssize_t leidos;
+        while ((leidos = read(fd, bloque.datos(), o.bloque)) > 0)
+            contexto.sha_append(reinterpret_cast<const BYTE *>(bloque.datos()), leidos);
+        close(fd);
+        if (leidos < 0)
+        {
+            resultado.error = "error al leer " + ruta;
+            return false;
+        }
+    }
+    resultado.hash = contexto.sha_digest();
+    return true;
+}
+
+/**
+ * @brief Comprueba que descifrar 'encriptado' reproduce 'original', sin escribir nada.
+ *
+ * @return bool false si no se pudo leer alguno (resultado.correcto indica si coinciden).
+ */
+bool verificarDescifradoCLI(const string &original, const string &encriptado, const OpcionesCLI &o, ArchivoCLI &resultado)
+{
+    resultado.ruta = encriptado;
+    resultado.bytes = devolverTamanoArchivo(encriptado);
+    long long bytesOriginal = devolverTamanoArchivo(original);
+    if (resultado.bytes < 0 || bytesOriginal < 0)
+    {
+        resultado.error = "no se pudo abrir " + (resultado.bytes < 0 ? encriptado : original);
+        resultado.bytes = 0;
+        return false;
+    }
+    if (resultado.bytes != bytesOriginal)
+    {
+        resultado.correcto = false;
+        return true;
+    }
+    char (*f)(char) = funcionCifradoCLI(o.cifrado, true);
+
+    if (o.backend == ES_FLUJO)
+    {
+        resultado.correcto = o.cifrado == CIFRADO_NINGUNO ? compararArchivos(original, encriptado) : verificarDesencriptado(encriptado, original);
+        return true;
+    }
+
+    if (o.backend == ES_MMAP)
+    {
+        ProyeccionArchivo a(original), b(encriptado);
+        if (!a.abierta() || !b.abierta())
+        {
+            resultado.error = "no se pudo proyectar " + (a.abierta() ? encriptado : original);
+            return false;
+        }
+        resultado.correcto = repartirTramos(resultado.bytes, o.bloque, o.hilos, [&](long long desde, long long hasta)
+                                            {
+            for (long long j = desde; j < hasta; j++)
+                if (f(b.getDatos()[j]) != a.getDatos()[j])
+                    return false;
+            return true; });
+        return true;
+    }
+
+    int fdOriginal = open(original.c_str(), O_RDONLY), fdEncriptado = open(encriptado.c_str(), O_RDONLY);
+    atomic<bool> errorES(fdOriginal < 0 || fdEncriptado < 0);
+    if (!errorES)
+        resultado.correcto = repartirTramos(resultado.bytes, o.bloque, o.hilos, [&](long long desde, long long hasta)
+                                            {
+            BufferPrestado bloqueOriginal(hasta - desde), bloqueEncriptado(hasta - desde);
+            char *a = bloqueOriginal.datos(), *b = bloqueEncriptado.datos();
+            if (!leerCompleto(fdOriginal, a, hasta - desde, desde) || !leerCompleto(fdEncriptado, b, hasta - desde, desde))
+            {
+                errorES = true;
+                return false;
+            }
+            for (long long j = 0; j < hasta - desde; j++)
+                b[j] = f(b[j]);
+            return memcmp(a, b, hasta - desde) == 0; });
+    if (fdOriginal >= 0)
+        close(fdOriginal);
+    if (fdEncriptado >= 0)
+        close(fdEncriptado);
+    if (errorES)
+        resultado.error = "error al leer " + original + " o " + encriptado;
+    return !errorES;
+}
+
+// Ejecuta trabajo(k) para k en [0, n) con 'hilos' hilos (un archivo por vez cada hilo)
+void paraCadaArchivo(size_t n, int hilos, const function<void(size_t)> &trabajo)
+{
+    atomic<size_t> siguiente(0);
+    auto trabajar = [&]
+    {
+        for (size_t k = siguiente++; k < n; k = siguiente++)
+            trabajo(k);
+    };
+    vector<thread> grupo;
+    for (int h = 1; h < min<long long>(hilos, n); h++)
+        grupo.emplace_back(trabajar);
+    trabajar();
+    for (auto &hilo : grupo)
+        hilo.join();
+}
+
+/**
+ * @brief Muestra los resultados en texto o en JSON.
+ */
+void mostrarResultadosCLI(const OpcionesCLI &o, const vector<ArchivoCLI> &archivos, double segundos, bool correcto)
+{
+    long long bytes = 0;
+    for (const auto &a : archivos)
+        bytes += max(0LL, a.bytes);
+    double mbPorSegundo = segundos > 0 ? bytes / segundos / 1e6 : 0.0;
+
+    if (o.json)
+    {
+        cout << fixed << setprecision(6) << "{\"comando\":\"" << o.comando << "\",\"backend\":\"" << nombresBackends[o.backend]
+             << "\",\"cifrado\":\"" << nombresCifrados[o.cifrado] << "\",\"hilos\":" << o.hilos << ",\"bloque\":" << o.bloque
+             << ",\"correcto\":" << (correcto ? "true" : "false") << ",\"bytes\":" << bytes << ",\"segundos\":" << segundos
+             << ",\"mbPorSegundo\":" << mbPorSegundo << ",\"archivos\":[";
+        for (size_t k = 0; k < archivos.size(); k++)
+        {
+            const ArchivoCLI &a = archivos[k];
+            cout << (k ? "," : "") << "{\"ruta\":\"" << escaparJSON(a.ruta) << "\",\"bytes\":" << a.bytes;
+            if (o.comando == "hash" || !a.hash.empty())
+                cout << ",\"sha256\":\"" << a.hash << "\"";
+            cout << ",\"correcto\":" << (a.correcto && a.error.empty() ? "true" : "false");
+            if (!a.error.empty())
+                cout << ",\"error\":\"" << escaparJSON(a.error) << "\"";
+            cout << "}";
+        }
+        cout << "]}" << endl;
+        return;
+    }
+
+    for (const auto &a : archivos)
+    {
+        if (!a.error.empty())
+            cerr << "Error: " << a.error << endl;
+        else if (o.comando == "hash")
+            cout << a.hash << "  " << a.ruta << endl; // Mismo formato que sha256sum
+        else if (o.comando == "verify")
+            cout << (a.correcto ? "OK      " : "FALLO   ") << a.ruta << endl;
+        else
+            cout << a.ruta << " -> " << o.salida << endl;
+    }
+    cout << fixed << setprecision(1) << bytes << " bytes en " << setprecision(3) << segundos << " s (" << setprecision(1) << mbPorSegundo
+         << " MB/s, backend " << nombresBackends[o.backend] << ", " << o.hilos << " hilos)" << endl;
+}
+
+/**
+ * @brief pipeline: los siete pasos sobre archivos reales con el driver por lotes elegido.
+ */
+int pipelineCLI(const OpcionesCLI &o)
+{
+    if (o.backend == ES_MMAP || o.cifrado != CIFRADO_CESAR)
+    {
+        cerr << "pipeline admite los backends flujo, bloques y robo, y solo el cifrado cesar" << endl;
+        return SALIDA_ERROR_USO;
+    }
+    string salida = o.salida.empty() ? "file_workspace_batch/" : o.salida;
+    vector<string> archivos = o.entradas;
+    if (!o.lista.empty())
+    {
+        vector<string> lista = leerListaArchivos(o.lista);
+        archivos.insert(archivos.end(), lista.begin(), lista.end());
+    }
+    if (!o.directorio.empty())
+    {
+        vector<string> encontrados = RecorridoParalelo(salida).recorrer(o.directorio, o.hilos);
+        archivos.insert(archivos.end(), encontrados.begin(), encontrados.end());
+    }
+    if (archivos.empty())
+    {
+        cerr << "pipeline necesita archivos (-i, --lista o --dir)" << endl;
+        return SALIDA_ERROR_USO;
+    }
+    for (const auto &archivo : archivos)
+        if (devolverTamanoArchivo(archivo) < 0) // El driver de robo lo trataría como un archivo vacío
+        {
+            cerr << "No se pudo abrir " << archivo << endl;
+            return SALIDA_ERROR_USO;
+        }
+
+    // Con JSON se silencia la salida de los drivers: solo queda el resumen
+    ostringstream descartada;
+    streambuf *original = o.json ? cout.rdbuf(descartada.rdbuf()) : nullptr;
+    ResumenLote resumen;
+    if (o.backend == ES_ROBO)
+        resumen = mainRoboTrabajo(archivos, salida, o.hilos, o.bloque);
+    else
+    {
+        OpcionesProceso opciones;
+        opciones.fusionado = o.backend == ES_BLOQUES;
+        resumen = mainLote(archivos, salida, opciones, o.hilos);
+    }
+    if (original != nullptr)
+        cout.rdbuf(original);
+
+    if (o.json)
+        cout << fixed << setprecision(6) << "{\"comando\":\"pipeline\",\"backend\":\"" << nombresBackends[o.backend] << "\",\"hilos\":" << o.hilos
+             << ",\"correcto\":" << (resumen.fallidos == 0 ? "true" : "false") << ",\"archivos\":" << resumen.archivos
+             << ",\"fallidos\":" << resumen.fallidos << ",\"bytes\":" << resumen.bytes << ",\"segundos\":" << resumen.segundos
+             << ",\"mbPorSegundo\":" << (resumen.segundos > 0 ? resumen.bytes / resumen.segundos / 1e6 : 0.0)
+             << ",\"manifiesto\":\"" << escaparJSON(normalizarDirectorio(salida) + "manifiesto.csv") << "\"}" << endl;
+    return resumen.fallidos == 0 ? SALIDA_CORRECTA : SALIDA_VERIFICACION_FALLIDA;
+}
+
+/**
+ * @brief bench: banco de pruebas del modo secuencial frente al modo elegido con N copias.
+ */
+int bancoCLI(const OpcionesCLI &o)
+{
+    if (o.copias < 1 || (o.modo != "paralelo" && o.modo != "dag" && o.modo != "hilo-por-copia") ||
+        (o.backend != ES_FLUJO && o.backend != ES_BLOQUES))
+    {
+        cerr << "bench necesita --copias N, --modo paralelo|dag|hilo-por-copia y el backend flujo o bloques" << endl;
+        return SALIDA_ERROR_USO;
+    }
+    if (devolverTamanoArchivo("file_workspace_sequential/original.txt") < 0 || devolverTamanoArchivo("file_workspace_parallel/original.txt") < 0)
+    {
+        cerr << "bench se ejecuta donde estan file_workspace_sequential/ y file_workspace_parallel/ con su original.txt" << endl;
+        return SALIDA_ERROR_USO;
+    }
+
+    OpcionesProceso opciones;
+    opciones.fusionado = o.backend == ES_BLOQUES;
+    ConfiguracionBanco configuracion = o.banco;
+    configuracion.regenerar = true;
+    configuracion.directorios = {"file_workspace_sequential/", "file_workspace_parallel/"};
+    BancoPruebas banco(configuracion);
+    banco.agregar("secuencial", [&]
+                  { return mainSecuencial(o.copias, opciones).duracionSegundos(); });
+    banco.agregar(o.modo, [&]
+                  { return (o.modo == "dag"              ? mainDAG(o.copias, opciones, o.hilos)
+                            : o.modo == "hilo-por-copia" ? mainParaleloHiloPorCopia(o.copias, opciones)
+                                                         : mainParalelo(o.copias, opciones, o.hilos))
+                        .duracionSegundos(); });
+    banco.ejecutar();
+    cout << (o.json ? banco.json() : banco.resumen()) << endl;
+    return SALIDA_CORRECTA;
+}
+
+/**
+ * @brief Ejecuta un subcomando. argv[0] es el nombre del subcomando.
+ *
+ * @return int Código de salida (SALIDA_CORRECTA, SALIDA_VERIFICACION_FALLIDA o SALIDA_ERROR_USO).
+ */
+int mainCLI(int argc, char *argv[])
+{
+    for (int a = 1; a < argc; a++)
+        if (argv[a] == string("-h") || argv[a] == string("--help"))
+        {
+            mostrarAyudaCLI(cout);
+            return SALIDA_CORRECTA;
+        }
+    OpcionesCLI o;
+    if (!leerOpcionesCLI(argc, argv, o))
+    {
+        mostrarAyudaCLI(cerr);
+        return SALIDA_ERROR_USO;
+    }
+    if (o.comando == "pipeline")
+        return pipelineCLI(o);
+    if (o.comando == "bench")
+        return bancoCLI(o);
+
+    vector<ArchivoCLI> archivos;
+    auto inicio = chrono::steady_clock::now();
+    if (o.comando == "encrypt" || o.comando == "decrypt")
+    {
+        if (o.entradas.size() != 1 || o.salida.empty())
+        {
+            cerr << o.comando << " necesita una entrada (-i) y una salida (-o)" << endl;
+            return SALIDA_ERROR_USO;
+        }
+        archivos.resize(1);
+        transformarArchivoCLI(o.entradas[0], o.salida, o.comando == "decrypt", o, archivos[0]);
+    }
+    else if (o.comando == "hash" || (o.comando == "verify" && !o.hashEsperado.empty()))
+    {
+        if (o.entradas.empty() || (o.comando == "verify" && o.entradas.size() != 1))
+        {
+            cerr << (o.comando == "hash" ? "hash necesita al menos un archivo" : "verify --sha256 necesita un archivo (-i)") << endl;
+            return SALIDA_ERROR_USO;
+        }
+        archivos.resize(o.entradas.size());
+        paraCadaArchivo(o.entradas.size(), o.hilos, [&](size_t k)
+                        { hashArchivoCLI(o.entradas[k], o, archivos[k]); });
+        if (o.comando == "verify")
+            archivos[0].correcto = archivos[0].error.empty() && archivos[0].hash == o.hashEsperado;
+    }
+    else if (o.comando == "verify" && !o.manifiesto.empty())
+    {
+        ConfiguracionCorpus corpus;
+        vector<EntradaCorpus> entradas;
+        if (!leerManifiestoCorpus(o.manifiesto, corpus, entradas))
+            return SALIDA_ERROR_USO;
+        archivos.resize(entradas.size());
+        paraCadaArchivo(entradas.size(), o.hilos, [&](size_t k)
+                        {
+            hashArchivoCLI(entradas[k].ruta, o, archivos[k]);
+            archivos[k].correcto = archivos[k].error.empty() && archivos[k].bytes == entradas[k].bytes && archivos[k].hash == entradas[k].hash; });
+    }
+    else if (o.comando == "verify")
+    {
+        if (o.entradas.size() != 1 || o.encriptado.empty())
+        {
+            cerr << "verify necesita -i ORIGINAL -e ENCRIPTADO, -i ARCHIVO --sha256 HASH o --manifiesto ARCHIVO" << endl;
+            return SALIDA_ERROR_USO;
+        }
+        archivos.resize(1);
+        verificarDescifradoCLI(o.entradas[0], o.encriptado, o, archivos[0]);
+    }
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    bool errorES = false, correcto = true;
+    for (const auto &a : archivos)
+    {
+        errorES = errorES || !a.error.empty();
+        correcto = correcto && a.correcto && a.error.empty();
+    }
+    mostrarResultadosCLI(o, archivos, segundos, correcto);
+    if (errorES)
+        return SALIDA_ERROR_USO;
+    return correcto ? SALIDA_CORRECTA : SALIDA_VERIFICACION_FALLIDA;
+}
+
+#endif // F28_CLI_H
@@ -0,0 +1,1047 @@
+/**
+ * @file F29_demonio.h
+ * @brief Demonio local que atiende trabajos de hash y encriptado por un socket Unix.
+ *
+ * Lanzar el programa miles de veces para trabajos cortos cuesta más en arranque, creación de
+ * hilos y cachés frías que el trabajo en sí. El demonio (crypto daemon) se queda en marcha con
+ * su pool de hilos, los pools de buffers de esos hilos y una caché de digestos, y atiende
+ * peticiones enmarcadas que llegan por un socket Unix:
+ *
+ * - El socket es SOCK_SEQPACKET: cada sendmsg es un mensaje completo (una cabecera fija y un
+ *   texto), así que el marco lo conserva el núcleo y no hace falta reensamblar.
+ * - Una petición nombra los archivos por ruta (absoluta, la resuelve el cliente) o los entrega ya
+ *   abiertos con SCM_RIGHTS: el demonio lee y escribe los descriptores del cliente sin volver a
+ *   resolver rutas ni necesitar permisos sobre ellas.
+ * - Cada conexión puede tener muchas peticiones en curso; las respuestas vuelven en cuanto
+ *   termina cada trabajo, en el orden en que terminan, con el id de la petición.
+ *
+ * Un hilo atiende el socket con epoll y reparte los trabajos al PoolHilos (F14_pool_hilos.h)
+ * sin bloquearse nunca:
+ * - Los sockets de los clientes no bloquean. Cada trabajador envía su respuesta al terminar; si
+ *   no cabe en el socket, queda en la bandeja de salida de la conexión y el hilo de epoll la
+ *   envía cuando llega EPOLLOUT.
+ * - Una conexión con MAX_PENDIENTES_CONEXION peticiones sin respuesta enviada deja de leerse
+ *   (se quita EPOLLIN) hasta que el cliente recoja respuestas; así un cliente que no lee no
+ *   hace crecer la bandeja sin límite.
+ * - Si ya hay CAPACIDAD_COLA_DEMONIO trabajos en el pool, no se lee ninguna conexión hasta que
+ *   termine alguno, así que enviar() al pool nunca espera a que la cola tenga sitio.
+ *
+ * La caché de digestos guarda el SHA-256 de cada archivo regular por dispositivo, inodo, tamaño
+ * y fecha de modificación. Solo se guarda si la modificación es anterior en más de
+ * MARGEN_CACHE_DIGESTOS_NS al hash (la fecha tiene una resolución gruesa y un cambio en el mismo
+ * instante no se distinguiría) y si el archivo no cambió mientras se leía.
+ *
+ * El cliente (crypto client) y el generador de carga (benchmarks/carga_demonio.cpp) usan
+ * ClienteDemonio. Las cabeceras viajan en el orden de bytes de la máquina: el socket es local.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F14_pool_hilos.h: El pool de hilos que se mantiene caliente.
+ * - F28_cli.h: Las funciones de cifrado, las lecturas y escrituras completas y los códigos de salida.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F29_DEMONIO_H
+#define F29_DEMONIO_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F14_pool_hilos.h"
+#include "F28_cli.h"
+#include <csignal>
+#include <deque>
+#include <unordered_map>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#define MAGIA_DEMONIO 0x50595243u // "CRYP"
+#define VERSION_DEMONIO 1
+#define MAX_MENSAJE_DEMONIO 65536
+#define MAX_DESCRIPTORES_DEMONIO 2
+#define CAPACIDAD_CACHE_DIGESTOS 65536
+#define MARGEN_CACHE_DIGESTOS_NS 2000000000LL // 2 s
+#define RUTA_SOCKET_DEMONIO "crypto.sock"
+#define MAX_PENDIENTES_CONEXION 256 // Peticiones de una conexión sin respuesta enviada; el cliente no debe pasar de aquí
+#define CAPACIDAD_COLA_DEMONIO 1024 // Trabajos en el pool (en cola o en curso) de todas las conexiones
+
+enum OperacionDemonio
+{
+    OP_HASH,
+    OP_ENCRIPTAR,
+    OP_DESENCRIPTAR,
+    OP_ESTADISTICAS,
+    OP_DETENER,
+    NUM_OPERACIONES_DEMONIO
+};
+
+// Nombre de cada operación y su alias en castellano
+const char *nombresOperacionesDemonio[NUM_OPERACIONES_DEMONIO][2] = {
+    {"hash", "hash"}, {"encrypt", "encriptar"}, {"decrypt", "desencriptar"}, {"stats", "estadisticas"}, {"stop", "detener"}};
+
+enum EstadoDemonio
+{
+    ESTADO_DEMONIO_OK,
+    ESTADO_DEMONIO_ERROR,    // El trabajo falló (archivo inexistente, error de E/S)
+    ESTADO_DEMONIO_INVALIDO, // El mensaje no se entiende
+};
+
+/**
+ * @struct CabeceraPeticion
+ * @brief Inicio de cada petición. La siguen 'largo' bytes: "entrada\0salida".
+ *
+ * Con descriptores = 1 la entrada llega abierta; con 2 también la salida (rutas vacías).
+ */
+
+struct CabeceraPeticion
+{
+    uint32_t magia;
+    uint16_t version;
+    uint16_t operacion;
+    uint64_t id;
+    uint32_t descriptores;
+    uint32_t largo;
+};
+
+/**
+ * @struct CabeceraRespuesta
+ * @brief Inicio de cada respuesta. La siguen 'largo' bytes: el hash o el mensaje de error.
+ */
+
+struct CabeceraRespuesta
+{
+    uint32_t magia;
+    uint16_t estado;
+    uint16_t cache; // 1 si el hash salió de la caché de digestos
+    uint64_t id;
+    int64_t bytes;
+    int64_t nanosegundos; // Desde que el demonio recibió la petición hasta la respuesta
+    uint32_t largo;
+    uint32_t reservado;
+};
+
+/**
+ * @struct RespuestaDemonio
+ * @brief Respuesta ya decodificada.
+ */
+
+struct RespuestaDemonio
+{
+    uint64_t id = 0;
+    EstadoDemonio estado = ESTADO_DEMONIO_OK;
+    bool cache = false;
+    long long bytes = 0;
+    long long nanosegundos = 0;
+    string texto; // Hash (hash: del archivo; encrypt/decrypt: de la salida), estadísticas o error
+};
+
+int buscarOperacionDemonio(const string &nombre)
+{
+    for (int op = 0; op < NUM_OPERACIONES_DEMONIO; op++)
+        if (nombre == nombresOperacionesDemonio[op][0] || nombre == nombresOperacionesDemonio[op][1])
+            return op;
+    return -1;
+}
+
+void cerrarDescriptores(vector<int> &descriptores)
+{
+    for (int fd : descriptores)
+        close(fd);
+    descriptores.clear();
+}
+
+/**
+ * @brief Envía un mensaje (cabecera y texto) con descriptores opcionales en un solo sendmsg.
+ */
+bool enviarMensaje(int fd, const void *cabecera, size_t largoCabecera, const string &texto, const vector<int> &descriptores = {})
+{
+    iovec partes[2] = {{const_cast<void *>(cabecera), largoCabecera}, {const_cast<char *>(texto.data()), texto.size()}};
+    msghdr mensaje = {};
+    mensaje.msg_iov = partes;
+    mensaje.msg_iovlen = texto.empty() ? 1 : 2;
+
+    union
+    {
+        cmsghdr alineacion;
+        char buffer[CMSG_SPACE(sizeof(int) * MAX_DESCRIPTORES_DEMONIO)];
+    } control;
+    if (!descriptores.empty())
+    {
+        mensaje.msg_control = control.buffer;
+        mensaje.msg_controllen = CMSG_SPACE(sizeof(int) * descriptores.size());
+        cmsghdr *c = CMSG_FIRSTHDR(&mensaje);
+        c->cmsg_level = SOL_SOCKET;
+        c->cmsg_type = SCM_RIGHTS;
+        c->cmsg_len = CMSG_LEN(sizeof(int) * descriptores.size());
+        memcpy(CMSG_DATA(c), descriptores.data(), sizeof(int) * descriptores.size());
+    }
+
+    ssize_t n;
+    do
+        n = sendmsg(fd, &mensaje, MSG_NOSIGNAL);
+    while (n < 0 && errno == EINTR);
+    return n == static_cast<ssize_t>(largoCabecera + texto.size());
+}
+
+/**
+ * @brief Recibe un mensaje completo y los descriptores que lo acompañan.
+ *
+ * @param bloquear false para no esperar si no hay mensajes.
+ * @return int 1 si recibió un mensaje (datos vacío si venía truncado), 0 si no había ninguno
+ *         (sin bloquear) y -1 si la conexión se cerró o falló.
+ */
+int recibirMensaje(int fd, vector<char> &datos, vector<int> &descriptores, bool bloquear = true)
+{
+    datos.resize(MAX_MENSAJE_DEMONIO);
+    iovec parte = {datos.data(), datos.size()};
+    union
+    {
+        cmsghdr alineacion;
+        char buffer[CMSG_SPACE(sizeof(int) * MAX_DESCRIPTORES_DEMONIO)];
+    } control;
+    msghdr mensaje = {};
+    mensaje.msg_iov = &parte;
+    mensaje.msg_iovlen = 1;
+    mensaje.msg_control = control.buffer;
+    mensaje.msg_controllen = sizeof(control.buffer);
+
+    ssize_t n;
+    do
+        n = recvmsg(fd, &mensaje, MSG_CMSG_CLOEXEC | (bloquear ? 0 : MSG_DONTWAIT));
+    while (n < 0 && errno == EINTR);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return 0;
+
+    descriptores.clear();
+    if (n > 0)
+        for (cmsghdr *c = CMSG_FIRSTHDR(&mensaje); c != nullptr; c = CMSG_NXTHDR(&mensaje, c))
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS)
+                for (size_t k = 0; k < (c->cmsg_len - CMSG_LEN(0)) / sizeof(int); k++)
+                {
+                    int recibido;
+                    memcpy(&recibido, CMSG_DATA(c) + k * sizeof(int), sizeof(int));
+                    descriptores.push_back(recibido);
+                }
+    if (n <= 0)
+        return -1;
+    if (mensaje.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+    {
+        cerrarDescriptores(descriptores);
+        datos.clear();
+        return 1;
+    }
+    datos.resize(n);
+    return 1;
+}
+
+/**
+ * @brief SHA-256 de todo el contenido de un descriptor (el de la entrada vacía si no tiene datos, como la CLI).
+ */
+bool hashDescriptor(int fd, string &hash, long long &bytes)
+{
+    sha256 contexto;
+    BufferPrestado bloque(TAMANO_BLOQUE);
+    bytes = 0;
+    ssize_t leidos;
+    while ((leidos = pread(fd, bloque.datos(), TAMANO_BLOQUE, bytes)) > 0)
+    {
+        contexto.sha_append(reinterpret_cast<const BYTE *>(bloque.datos()), leidos);
+        bytes += leidos;
+    }
+    hash = contexto.sha_digest();
+    return leidos == 0;
+}
+
+/**
+ * @brief Aplica f a todo el contenido de fdEntrada, lo escribe en fdSalida y calcula el hash de la salida.
+ *
+ * @param hashEntrada Si no es nulo, recibe también el hash de la entrada (en el mismo recorrido).
+ */
+bool transformarDescriptor(int fdEntrada, int fdSalida, char (*f)(char), string &hash, long long &bytes, string *hashEntrada = nullptr)
+{
+    sha256 contexto, contextoEntrada;
+    BufferPrestado bloque(TAMANO_BLOQUE);
+    char *datos = bloque.datos();
+    bytes = 0;
+    ssize_t leidos;
+    while ((leidos = pread(fdEntrada, datos, TAMANO_BLOQUE, bytes)) > 0)
+    {
+        if (hashEntrada != nullptr)
+            contextoEntrada.sha_append(reinterpret_cast<const BYTE *>(datos), leidos);
+        for (ssize_t j = 0; j < leidos; j++)
+            datos[j] = f(datos[j]);
+        if (!escribirCompleto(fdSalida, datos, leidos, bytes))
+            return false;
+        contexto.sha_append(reinterpret_cast<const BYTE *>(datos), leidos);
+        bytes += leidos;
+    }
+    hash = contexto.sha_digest();
+    if (hashEntrada != nullptr)
+        *hashEntrada = contextoEntrada.sha_digest();
+    return leidos == 0 && ftruncate(fdSalida, bytes) == 0; // La salida pasada por descriptor puede ser más larga
+}
+
+/**
+ * @class CacheDigestos
+ * @brief SHA-256 de archivos regulares ya calculados, por identidad y versión del archivo.
+ *
+ * Al llenarse descarta las entradas más antiguas.
+ */
+
+class CacheDigestos
+{
+private:
+    mutex mutex_cache;
+    unordered_map<string, string> digestos;
+    deque<string> orden; // Claves en orden de inserción
+    atomic<long long> aciertos, fallos;
+
+    static string clave(const struct stat &estado)
+    {
+        return to_string(estado.st_dev) + ":" + to_string(estado.st_ino) + ":" + to_string(estado.st_size) + ":" +
+               to_string(nanosegundosModificacion(estado));
+    }
+
+public:
+    CacheDigestos() : aciertos(0), fallos(0) {}
+
+    bool buscar(const struct stat &estado, string &hash)
+    {
+        lock_guard<mutex> lock(mutex_cache);
+        auto it = digestos.find(clave(estado));
+        if (it == digestos.end())
+        {
+            fallos++;
+            return false;
+        }
+        aciertos++;
+        hash = it->second;
+        return true;
+    }
+
+    /**
+     * @brief Guarda el hash si el archivo no cambió desde 'antes' y su modificación no es reciente.
+     */
+    void guardar(const struct stat &antes, const struct stat &despues, const string &hash)
+    {
+        long long ahora = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+        if (!S_ISREG(antes.st_mode) || clave(antes) != clave(despues) || ahora - nanosegundosModificacion(antes) < MARGEN_CACHE_DIGESTOS_NS)
+            return;
+        lock_guard<mutex> lock(mutex_cache);
+        if (!digestos.emplace(clave(antes), hash).second)
+            return;
+        orden.push_back(clave(antes));
+        if (orden.size() > CAPACIDAD_CACHE_DIGESTOS)
+        {
+            digestos.erase(orden.front());
+            orden.pop_front();
+        }
+    }
+
+    long long getAciertos() const { return aciertos; }
+    long long getFallos() const { return fallos; }
+
+    size_t entradas()
+    {
+        lock_guard<mutex> lock(mutex_cache);
+        return digestos.size();
+    }
+};
+
+/**
+ * @struct ConexionDemonio
+ * @brief Un cliente conectado. Los trabajos en curso la comparten: el socket se cierra con el último.
+ */
+
+struct ConexionDemonio
+{
+    int fd;
+    mutex mutex_envio;                                      // Protege lo que sigue: lo usan el hilo de epoll y los trabajadores
+    deque<pair<CabeceraRespuesta, string>> salida;          // Respuestas que no cupieron en el socket, en orden
+    int pendientes = 0;                                     // Peticiones leídas cuya respuesta aún no se envió
+    uint32_t eventos = EPOLLIN;                             // Eventos registrados en epoll
+    bool cerrada = false;                                   // El cliente se fue: las respuestas se descartan
+
+    ConexionDemonio(int descriptor) : fd(descriptor) {}
+    ~ConexionDemonio() { close(fd); }
+};
+
+int eventoDetenerDemonio = -1; // eventfd que despierta al demonio desde el manejador de señales
+
+void manejarSenalDemonio(int)
+{
+    uint64_t uno = 1;
+    if (eventoDetenerDemonio >= 0 && write(eventoDetenerDemonio, &uno, sizeof(uno)) < 0)
+        return;
+}
+
+/**
+ * @class DemonioCrypto
+ * @brief Servidor de trabajos de hash y encriptado sobre un socket Unix SOCK_SEQPACKET.
+ */
+
+class DemonioCrypto
+{
+private:
+    string rutaSocket;
+    int fdEscucha, epollFd, eventoFd;
+    int eventoReanudarFd; // Lo escribe un trabajador al liberar sitio en el pool si se dejó de leer por estar lleno
+    bool detener;
+    unordered_map<int, shared_ptr<ConexionDemonio>> conexiones; // Solo la usa el hilo de epoll
+    CacheDigestos cache;
+    atomic<long long> peticiones, errores, bytesProcesados, conexionesAceptadas;
+    atomic<int> trabajosEnPool;  // Enviados al pool y sin terminar
+    atomic<bool> pausaPorPool;   // El hilo de epoll dejó de leer porque el pool estaba lleno
+    chrono::steady_clock::time_point inicio;
+    PoolHilos pool; // Declarado al final: se destruye (y termina sus trabajos) antes que lo demás
+
+    // Registra en epoll los eventos que tocan según el estado de la conexión (con mutex_envio tomado)
+    void actualizarEventos(ConexionDemonio &conexion)
+    {
+        if (conexion.cerrada)
+            return;
+        bool leer = conexion.pendientes < MAX_PENDIENTES_CONEXION && trabajosEnPool < CAPACIDAD_COLA_DEMONIO;
+        uint32_t eventos = (leer ? static_cast<uint32_t>(EPOLLIN) : 0u) | (conexion.salida.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+        if (eventos == conexion.eventos)
+            return;
+        epoll_event evento = {};
+        evento.events = eventos;
+        evento.data.fd = conexion.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, conexion.fd, &evento);
+        conexion.eventos = eventos;
+    }
+
+    // Envía sin bloquear las respuestas de la bandeja hasta que el socket se llene (con mutex_envio tomado)
+    void vaciarSalida(ConexionDemonio &conexion)
+    {
+        while (!conexion.cerrada && !conexion.salida.empty())
+        {
+            const auto &mensaje = conexion.salida.front();
+            if (!enviarMensaje(conexion.fd, &mensaje.first, sizeof(mensaje.first), mensaje.second))
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    return; // Sigue con EPOLLOUT
+                conexion.cerrada = true; // El cliente se fue: el hilo de epoll verá el cierre y la quitará
+                conexion.pendientes -= static_cast<int>(conexion.salida.size());
+                conexion.salida.clear();
+                return;
+            }
+            conexion.salida.pop_front();
+            conexion.pendientes--;
+        }
+    }
+
+    void responder(ConexionDemonio &conexion, const RespuestaDemonio &r)
+    {
+        CabeceraRespuesta cabecera = {};
+        cabecera.magia = MAGIA_DEMONIO;
+        cabecera.estado = r.estado;
+        cabecera.cache = r.cache;
+        cabecera.id = r.id;
+        cabecera.bytes = r.bytes;
+        cabecera.nanosegundos = r.nanosegundos;
+        cabecera.largo = static_cast<uint32_t>(r.texto.size());
+        lock_guard<mutex> lock(conexion.mutex_envio);
+        if (conexion.cerrada)
+        {
+            conexion.pendientes--; // Si el cliente se fue, la respuesta se pierde
+            return;
+        }
+        conexion.salida.emplace_back(cabecera, r.texto);
+        vaciarSalida(conexion);
+        actualizarEventos(conexion);
+    }
+
+    void cerrarConexion(unordered_map<int, shared_ptr<ConexionDemonio>>::iterator it)
+    {
+        ConexionDemonio &conexion = *it->second;
+        {
+            lock_guard<mutex> lock(conexion.mutex_envio);
+            conexion.cerrada = true;
+            conexion.pendientes -= static_cast<int>(conexion.salida.size());
+            conexion.salida.clear();
+        }
+        // Las respuestas pendientes se pierden; el socket se cierra cuando acaben sus trabajos
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, conexion.fd, nullptr);
+        shutdown(conexion.fd, SHUT_RDWR);
+        conexiones.erase(it);
+    }
+
+    // Se ejecuta en un hilo del pool
+    void procesar(shared_ptr<ConexionDemonio> conexion, OperacionDemonio op, uint64_t id, const string &entrada, const string &salida,
+                  vector<int> descriptores, chrono::steady_clock::time_point recibida)
+    {
+        RespuestaDemonio r;
+        r.id = id;
+        int fdEntrada = descriptores.size() > 0 ? descriptores[0] : open(entrada.c_str(), O_RDONLY | O_CLOEXEC);
+        int fdSalida = -1;
+        if (op != OP_HASH)
+            fdSalida = descriptores.size() > 1 ? descriptores[1] : open(salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        struct stat antes, despues;
+        if (fdEntrada < 0 || (op != OP_HASH && fdSalida < 0))
+        {
+            r.estado = ESTADO_DEMONIO_ERROR;
+            r.texto = string("no se pudo abrir ") + (fdEntrada < 0 ? entrada : salida) + ": " + strerror(errno);
+        }
+        else if (op == OP_HASH)
+        {
+            bool estado = fstat(fdEntrada, &antes) == 0;
+            if (estado && S_ISREG(antes.st_mode) && cache.buscar(antes, r.texto))
+            {
+                r.cache = true;
+                r.bytes = antes.st_size;
+            }
+            else if (!hashDescriptor(fdEntrada, r.texto, r.bytes))
+            {
+                r.estado = ESTADO_DEMONIO_ERROR;
+                r.texto = "error al leer " + entrada;
+            }
+            else if (estado && fstat(fdEntrada, &despues) == 0)
+                cache.guardar(antes, despues, r.texto);
+        }
+        else if (!transformarDescriptor(fdEntrada, fdSalida, funcionCifradoCLI(CIFRADO_CESAR, op == OP_DESENCRIPTAR), r.texto, r.bytes))
+        {
+            r.estado = ESTADO_DEMONIO_ERROR;
+            r.texto = "error de E/S con " + entrada + " o " + salida;
+        }
+
+        // Los descriptores recibidos ya están en fdEntrada/fdSalida
+        if (fdEntrada >= 0)
+            close(fdEntrada);
+        if (fdSalida >= 0)
+            close(fdSalida);
+        for (size_t k = op == OP_HASH ? 1 : 2; k < descriptores.size(); k++)
+            close(descriptores[k]);
+
+        r.nanosegundos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - recibida).count();
+        peticiones++;
+        bytesProcesados += r.bytes;
+        if (r.estado != ESTADO_DEMONIO_OK)
+            errores++;
+        responder(*conexion, r);
+
+        trabajosEnPool--;
+        if (pausaPorPool.exchange(false))
+        {
+            uint64_t uno = 1;
+            if (write(eventoReanudarFd, &uno, sizeof(uno)) < 0)
+                return; // El contador del eventfd ya tenía un aviso
+        }
+    }
+
+    void atender(const shared_ptr<ConexionDemonio> &conexion, const vector<char> &datos, vector<int> &descriptores)
+    {
+        auto recibida = chrono::steady_clock::now();
+        CabeceraPeticion cabecera = {};
+        if (datos.size() >= sizeof(cabecera))
+            memcpy(&cabecera, datos.data(), sizeof(cabecera));
+
+        {
+            lock_guard<mutex> lock(conexion->mutex_envio);
+            conexion->pendientes++; // Cada petición recibe exactamente una respuesta
+        }
+
+        RespuestaDemonio r;
+        r.id = cabecera.id;
+        if (datos.size() < sizeof(cabecera) || cabecera.magia != MAGIA_DEMONIO || cabecera.version != VERSION_DEMONIO ||
+            cabecera.operacion >= NUM_OPERACIONES_DEMONIO || cabecera.largo != datos.size() - sizeof(cabecera) ||
+            cabecera.descriptores != descriptores.size() || descriptores.size() > MAX_DESCRIPTORES_DEMONIO)
+        {
+            cerrarDescriptores(descriptores);
+            errores++;
+            r.estado = ESTADO_DEMONIO_INVALIDO;
+            r.texto = "mensaje invalido";
+            responder(*conexion, r);
+            return;
+        }
+
+        OperacionDemonio op = static_cast<OperacionDemonio>(cabecera.operacion);
+        if (op == OP_ESTADISTICAS || op == OP_DETENER)
+        {
+            cerrarDescriptores(descriptores);
+            r.texto = estadisticas();
+            responder(*conexion, r);
+            if (op == OP_DETENER)
+                detener = true;
+            return;
+        }
+
+        string texto(datos.begin() + sizeof(cabecera), datos.end());
+        size_t separador = texto.find('\0');
+        string entrada = texto.substr(0, separador);
+        string salida = separador == string::npos ? "" : texto.substr(separador + 1);
+        trabajosEnPool++; // leerConexion no lee si el pool está lleno: enviar() no llega a esperar
+        pool.enviar([this, conexion, op, id = cabecera.id, entrada, salida, descriptores, recibida]
+                    { procesar(conexion, op, id, entrada, salida, descriptores, recibida); });
+        descriptores.clear(); // Ahora son del trabajo
+    }
+
+    void aceptarConexiones()
+    {
+        int fd;
+        while ((fd = accept4(fdEscucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+        {
+            epoll_event evento = {};
+            evento.events = EPOLLIN;
+            evento.data.fd = fd;
+            conexiones[fd] = make_shared<ConexionDemonio>(fd);
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &evento);
+            conexionesAceptadas++;
+        }
+    }
+
+    // Con cada evento de una conexión: envía lo que quepa de la bandeja y lee peticiones mientras haya cupo
+    void atenderEvento(int fd, uint32_t eventos)
+    {
+        auto it = conexiones.find(fd);
+        if (it == conexiones.end())
+            return;
+        shared_ptr<ConexionDemonio> conexion = it->second;
+        if (eventos & (EPOLLHUP | EPOLLERR))
+        {
+            cerrarConexion(it); // El cliente cerró del todo: ya no puede recibir respuestas
+            return;
+        }
+        if (eventos & EPOLLOUT)
+        {
+            lock_guard<mutex> lock(conexion->mutex_envio);
+            vaciarSalida(*conexion);
+            actualizarEventos(*conexion);
+        }
+        if (!(eventos & EPOLLIN))
+            return;
+
+        vector<char> datos;
+        vector<int> descriptores;
+        while (!detener)
+        {
+            if (trabajosEnPool >= CAPACIDAD_COLA_DEMONIO)
+            {
+                // Se vuelve a mirar después de avisar: si un trabajo terminó entretanto, se sigue leyendo
+                pausaPorPool = true;
+                if (trabajosEnPool >= CAPACIDAD_COLA_DEMONIO)
+                {
+                    lock_guard<mutex> lock(conexion->mutex_envio);
+                    actualizarEventos(*conexion);
+                    return;
+                }
+            }
+            {
+                lock_guard<mutex> lock(conexion->mutex_envio);
+                if (conexion->pendientes >= MAX_PENDIENTES_CONEXION)
+                {
+                    actualizarEventos(*conexion); // Vuelve a leerse cuando salgan respuestas
+                    return;
+                }
+            }
+            int r = recibirMensaje(fd, datos, descriptores, false);
+            if (r == 0)
+                return;
+            if (r < 0)
+            {
+                cerrarConexion(it);
+                return;
+            }
+            atender(conexion, datos, descriptores);
+        }
+    }
+
+    // Tras un aviso de eventoReanudarFd: vuelve a leer las conexiones que se pararon con el pool lleno
+    void reanudarConexiones()
+    {
+        uint64_t avisos;
+        if (read(eventoReanudarFd, &avisos, sizeof(avisos)) < 0)
+            return;
+        for (auto &c : conexiones)
+        {
+            lock_guard<mutex> lock(c.second->mutex_envio);
+            actualizarEventos(*c.second);
+        }
+    }
+
+    // Al detenerse: espera (como mucho un segundo por conexión) a que los clientes recojan lo que queda
+    void enviarRestantes()
+    {
+        timeval espera = {1, 0};
+        for (auto &c : conexiones)
+        {
+            ConexionDemonio &conexion = *c.second;
+            fcntl(conexion.fd, F_SETFL, fcntl(conexion.fd, F_GETFL) & ~O_NONBLOCK);
+            setsockopt(conexion.fd, SOL_SOCKET, SO_SNDTIMEO, &espera, sizeof(espera));
+            lock_guard<mutex> lock(conexion.mutex_envio);
+            vaciarSalida(conexion);
+        }
+    }
+
+public:
+    DemonioCrypto(const string &ruta, int numHilos = 0)
+        : rutaSocket(ruta), fdEscucha(-1), epollFd(-1), eventoFd(-1), eventoReanudarFd(-1), detener(false), peticiones(0), errores(0),
+          bytesProcesados(0), conexionesAceptadas(0), trabajosEnPool(0), pausaPorPool(false), inicio(chrono::steady_clock::now()),
+          pool(numHilos, CAPACIDAD_COLA_DEMONIO) {}
+
+    ~DemonioCrypto()
+    {
+        if (fdEscucha >= 0)
+        {
+            close(fdEscucha);
+            unlink(rutaSocket.c_str());
+        }
+        if (eventoFd >= 0)
+        {
+            eventoDetenerDemonio = -1;
+            close(eventoFd);
+        }
+        if (eventoReanudarFd >= 0)
+            close(eventoReanudarFd);
+        if (epollFd >= 0)
+            close(epollFd);
+    }
+
+    DemonioCrypto(const DemonioCrypto &) = delete;
+    DemonioCrypto &operator=(const DemonioCrypto &) = delete;
+
+    /**
+     * @brief Crea el socket (solo accesible por el usuario) y prepara epoll y las señales.
+     *
+     * Un socket que quedó de un demonio anterior se reemplaza; si otro demonio sigue
+     * escuchando en la ruta, falla.
+     */
+    bool iniciar()
+    {
+        sockaddr_un direccion = {};
+        direccion.sun_family = AF_UNIX;
+        if (rutaSocket.empty() || rutaSocket.size() >= sizeof(direccion.sun_path))
+        {
+            cerr << "Ruta de socket invalida: " << rutaSocket << endl;
+            return false;
+        }
+        strcpy(direccion.sun_path, rutaSocket.c_str());
+
+        int prueba = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (prueba >= 0 && connect(prueba, reinterpret_cast<sockaddr *>(&direccion), sizeof(direccion)) == 0)
+        {
+            close(prueba);
+            cerr << "Ya hay un demonio escuchando en " << rutaSocket << endl;
+            return false;
+        }
+        if (prueba >= 0)
+            close(prueba);
+        struct stat estado;
+        if (lstat(rutaSocket.c_str(), &estado) == 0 && S_ISSOCK(estado.st_mode))
+            unlink(rutaSocket.c_str());
+
+        fdEscucha = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        mode_t mascara = umask(0077);
+        bool enlazado = fdEscucha >= 0 && ::bind(fdEscucha, reinterpret_cast<sockaddr *>(&direccion), sizeof(direccion)) == 0;
+        umask(mascara);
+        if (!enlazado || listen(fdEscucha, SOMAXCONN) != 0)
+        {
+            cerr << "No se pudo escuchar en " << rutaSocket << ": " << strerror(errno) << endl;
+            if (fdEscucha >= 0)
+                close(fdEscucha);
+            fdEscucha = -1;
+            return false;
+        }
+
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        eventoFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event evento = {};
+        evento.events = EPOLLIN;
+        evento.data.fd = fdEscucha;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fdEscucha, &evento);
+        evento.data.fd = eventoFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, eventoFd, &evento);
+        eventoReanudarFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        evento.data.fd = eventoReanudarFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, eventoReanudarFd, &evento);
+
+        eventoDetenerDemonio = eventoFd;
+        signal(SIGINT, manejarSenalDemonio);
+        signal(SIGTERM, manejarSenalDemonio);
+        return true;
+    }
+
+    /**
+     * @brief Atiende conexiones hasta recibir SIGINT/SIGTERM o una petición stop.
+     */
+    void ejecutar()
+    {
+        epoll_event eventos[64];
+        while (!detener)
+        {
+            int n = epoll_wait(epollFd, eventos, 64, -1);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0)
+            {
+                cerr << "epoll_wait: " << strerror(errno) << endl;
+                return;
+            }
+            for (int e = 0; e < n && !detener; e++)
+            {
+                int fd = eventos[e].data.fd;
+                if (fd == eventoFd)
+                    detener = true;
+                else if (fd == fdEscucha)
+                    aceptarConexiones();
+                else if (fd == eventoReanudarFd)
+                    reanudarConexiones();
+                else
+                    atenderEvento(fd, eventos[e].events);
+            }
+        }
+        pool.esperarTodo();
+        enviarRestantes();
+    }
+
+    string estadisticas()
+    {
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        ostringstream oss;
+        oss << fixed << setprecision(1) << "Activo " << segundos << " s, " << pool.numeroHilos() << " hilos, " << conexionesAceptadas
+            << " conexiones (" << conexiones.size() << " abiertas)\n"
+            << "Peticiones: " << peticiones << " (" << errores << " con error), " << formatearBytes(bytesProcesados) << "\n"
+            << "Cache de digestos: " << cache.entradas() << " entradas, " << cache.getAciertos() << " aciertos, " << cache.getFallos()
+            << " fallos\n"
+            << describirPoolBuffers();
+        return oss.str();
+    }
+};
+
+/**
+ * @class ClienteDemonio
+ * @brief Conexión de un cliente con el demonio.
+ */
+
+class ClienteDemonio
+{
+private:
+    int fd;
+
+    // Las rutas relativas se resuelven aquí: el demonio puede estar en otro directorio
+    static string rutaAbsoluta(const string &ruta)
+    {
+        if (ruta.empty() || ruta[0] == '/')
+            return ruta;
+        char actual[4096];
+        return getcwd(actual, sizeof(actual)) != nullptr ? string(actual) + "/" + ruta : ruta;
+    }
+
+public:
+    ClienteDemonio() : fd(-1) {}
+    ~ClienteDemonio()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    ClienteDemonio(const ClienteDemonio &) = delete;
+    ClienteDemonio &operator=(const ClienteDemonio &) = delete;
+
+    bool conectar(const string &ruta)
+    {
+        sockaddr_un direccion = {};
+        direccion.sun_family = AF_UNIX;
+        if (ruta.size() >= sizeof(direccion.sun_path))
+            return false;
+        strcpy(direccion.sun_path, ruta.c_str());
+        fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        return fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&direccion), sizeof(direccion)) == 0;
+    }
+
+    /**
+     * @brief Envía una petición. Con descriptores, las rutas solo sirven para los mensajes de error.
+     */
+    bool enviar(OperacionDemonio op, uint64_t id, const string &entrada, const string &salida = "", const vector<int> &descriptores = {})
+    {
+        string texto = rutaAbsoluta(entrada) + '\0' + rutaAbsoluta(salida);
+        CabeceraPeticion cabecera = {};
+        cabecera.magia = MAGIA_DEMONIO;
+        cabecera.version = VERSION_DEMONIO;
+        cabecera.operacion = op;
+        cabecera.id = id;
+        cabecera.descriptores = static_cast<uint32_t>(descriptores.size());
+        cabecera.largo = static_cast<uint32_t>(texto.size());
+        return enviarMensaje(fd, &cabecera, sizeof(cabecera), texto, descriptores);
+    }
+
+    /**
+     * @brief Espera la siguiente respuesta.
+     *
+     * @return bool false si la conexión se cerró o la respuesta no es válida.
+     */
+    bool recibir(RespuestaDemonio &r)
+    {
+        vector<char> datos;
+        vector<int> descriptores;
+        if (recibirMensaje(fd, datos, descriptores) != 1)
+            return false;
+        cerrarDescriptores(descriptores); // El demonio no los envía
+        CabeceraRespuesta cabecera;
+        if (datos.size() < sizeof(cabecera))
+            return false;
+        memcpy(&cabecera, datos.data(), sizeof(cabecera));
+        if (cabecera.magia != MAGIA_DEMONIO || cabecera.largo != datos.size() - sizeof(cabecera))
+            return false;
+        r.id = cabecera.id;
+        r.estado = static_cast<EstadoDemonio>(cabecera.estado);
+        r.cache = cabecera.cache != 0;
+        r.bytes = cabecera.bytes;
+        r.nanosegundos = cabecera.nanosegundos;
+        r.texto.assign(datos.begin() + sizeof(cabecera), datos.end());
+        return true;
+    }
+};
+
+/**
+ * @brief crypto daemon [--socket RUTA] [--hilos N]: atiende peticiones en primer plano hasta SIGINT/SIGTERM o stop.
+ */
+int mainDemonio(int argc, char *argv[])
+{
+    string ruta = RUTA_SOCKET_DEMONIO;
+    int hilos = 0;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        if (opcion == "--socket" && a + 1 < argc)
+            ruta = argv[++a];
+        else if (opcion == "--hilos" && a + 1 < argc)
+            hilos = atoi(argv[++a]);
+        else
+        {
+            cerr << "Uso: crypto daemon [--socket RUTA] [--hilos N]" << endl;
+            return SALIDA_ERROR_USO;
+        }
+    }
+
+    DemonioCrypto demonio(ruta, hilos);
+    if (!demonio.iniciar())
+        return SALIDA_ERROR_USO;
+    cout << "Escuchando en " << ruta << endl;
+    demonio.ejecutar();
+    cout << demonio.estadisticas() << endl;
+    return SALIDA_CORRECTA;
+}
+
+/**
+ * @brief crypto client [--socket RUTA] [--fd] [--formato texto|json] OPERACION [-i ENTRADA...] [-o SALIDA]
+ *
+ * Envía todas las peticiones por la misma conexión y muestra cada respuesta al llegar. Con --fd
+ * abre los archivos y los pasa al demonio con SCM_RIGHTS.
+ */
+int mainClienteDemonio(int argc, char *argv[])
+{
+    string ruta = RUTA_SOCKET_DEMONIO, salida;
+    vector<string> entradas;
+    int op = -1;
+    bool pasarDescriptores = false, json = false;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        if (opcion == "--socket" && a + 1 < argc)
+            ruta = argv[++a];
+        else if (opcion == "--fd")
+            pasarDescriptores = true;
+        else if (opcion == "--formato" && a + 1 < argc)
+            json = string(argv[++a]) == "json";
+        else if ((opcion == "-i" || opcion == "--entrada") && a + 1 < argc)
+            entradas.push_back(argv[++a]);
+        else if ((opcion == "-o" || opcion == "--salida") && a + 1 < argc)
+            salida = argv[++a];
+        else if (op < 0 && buscarOperacionDemonio(opcion) >= 0)
+            op = buscarOperacionDemonio(opcion);
+        else if (!opcion.empty() && opcion[0] != '-')
+            entradas.push_back(opcion);
+        else
+            op = NUM_OPERACIONES_DEMONIO; // Marca de error
+    }
+    bool transformar = op == OP_ENCRIPTAR || op == OP_DESENCRIPTAR;
+    if (op < 0 || op == NUM_OPERACIONES_DEMONIO || (op == OP_HASH && entradas.empty()) ||
+        (transformar && (entradas.size() != 1 || salida.empty())))
+    {
+        cerr << "Uso: crypto client [--socket RUTA] [--fd] [--formato texto|json] hash ARCHIVO... | encrypt|decrypt -i ENTRADA -o SALIDA | stats | stop"
+             << endl;
+        return SALIDA_ERROR_USO;
+    }
+
+    ClienteDemonio cliente;
+    if (!cliente.conectar(ruta))
+    {
+        cerr << "No se pudo conectar con el demonio en " << ruta << ": " << strerror(errno) << endl;
+        return SALIDA_ERROR_USO;
+    }
+    if (op == OP_ESTADISTICAS || op == OP_DETENER)
+        entradas.assign(1, "");
+
+    // Como mucho MAX_PENDIENTES_CONEXION peticiones sin respuesta: el demonio deja de leer la
+    // conexión al llegar a ese número y, si el cliente siguiera enviando sin leer, ambos esperarían
+    int codigo = SALIDA_CORRECTA;
+    size_t enviadas = 0;
+    for (size_t recibidas = 0; recibidas < entradas.size(); recibidas++)
+    {
+        for (; enviadas < entradas.size() && enviadas - recibidas < MAX_PENDIENTES_CONEXION; enviadas++)
+        {
+            size_t k = enviadas;
+            vector<int> descriptores;
+            if (pasarDescriptores && (op == OP_HASH || transformar))
+            {
+                descriptores.push_back(open(entradas[k].c_str(), O_RDONLY | O_CLOEXEC));
+                if (transformar)
+                    descriptores.push_back(open(salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+                if (find(descriptores.begin(), descriptores.end(), -1) != descriptores.end())
+                {
+                    cerr << "No se pudo abrir " << (descriptores[0] < 0 ? entradas[k] : salida) << endl;
+                    return SALIDA_ERROR_USO;
+                }
+            }
+            bool enviado = cliente.enviar(static_cast<OperacionDemonio>(op), k, entradas[k], salida, descriptores);
+            cerrarDescriptores(descriptores); // El demonio tiene sus propias copias
+            if (!enviado)
+            {
+                cerr << "No se pudo enviar la peticion" << endl;
+                return SALIDA_ERROR_USO;
+            }
+        }
+
+        RespuestaDemonio r;
+        if (!cliente.recibir(r) || r.id >= entradas.size())
+        {
+            cerr << "El demonio cerro la conexion" << endl;
+            return SALIDA_ERROR_USO;
+        }
+        const string &entrada = entradas[r.id];
+        if (r.estado != ESTADO_DEMONIO_OK)
+            codigo = SALIDA_ERROR_USO;
+        if (json)
+            cout << fixed << setprecision(3) << "{\"id\":" << r.id << ",\"operacion\":\"" << nombresOperacionesDemonio[op][0] << "\",\"ruta\":\""
+                 << escaparJSON(entrada) << "\",\"correcto\":" << (r.estado == ESTADO_DEMONIO_OK ? "true" : "false")
+                 << ",\"cache\":" << (r.cache ? "true" : "false") << ",\"bytes\":" << r.bytes << ",\"microsegundos\":" << r.nanosegundos / 1e3
+                 << ",\"" << (r.estado != ESTADO_DEMONIO_OK ? "error" : op <= OP_DESENCRIPTAR ? "sha256" : "texto") << "\":\""
+                 << escaparJSON(r.texto) << "\"}" << endl;
+        else if (r.estado != ESTADO_DEMONIO_OK)
+            cerr << "Error: " << r.texto << endl;
+        else if (op == OP_HASH)
+            cout << r.texto << "  " << entrada << endl;
+        else if (transformar)
+            cout << entrada << " -> " << salida << "  sha256 " << r.texto << endl;
+        else
+            cout << r.texto << endl;
+    }
+    return codigo;
+}
+
+bool esSubcomandoDemonio(const string &nombre)
+{
+    return nombre == "daemon" || nombre == "demonio" || nombre == "client" || nombre == "cliente";
+}
+
+int mainSubcomandoDemonio(int argc, char *argv[])
+{
+    string nombre = argv[0];
+    return nombre == "daemon" || nombre == "demonio" ? mainDemonio(argc, argv) : mainClienteDemonio(argc, argv);
+}
+
+#endif // F29_DEMONIO_H
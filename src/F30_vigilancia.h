@@ -0,0 +1,634 @@
+/**
+ * @file F30_vigilancia.h
+ * @brief Modo vigilancia: encripta y calcula el hash de los archivos de un árbol a medida que cambian.
+ *
+ * En lugar de reprocesar todo en cada ejecución, crypto watch DIR registra vigilancias de inotify
+ * en cada directorio del árbol y solo pasa por el pipeline los archivos creados o modificados:
+ *
+ * - Agrupación: cada evento de un archivo (escritura, cierre, creación, renombrado hacia el árbol)
+ *   aplaza su proceso hasta que lleve --espera ms sin eventos, así una ráfaga de escrituras sobre
+ *   el mismo archivo se procesa una sola vez y no a medio escribir.
+ * - Cola acotada: como mucho --cola trabajos esperan en el PoolHilos; el resto sigue en la lista
+ *   de pendientes, donde los eventos nuevos se siguen agrupando.
+ * - Un archivo que cambia mientras se procesa se vuelve a programar al terminar; la salida se
+ *   escribe en un temporal y se renombra, así que nunca queda una salida a medias.
+ * - Los directorios nuevos se vigilan y se recorren (sus archivos pueden haberse creado antes de
+ *   registrar la vigilancia); los borrados eliminan su salida y su entrada del manifiesto.
+ * - Si la cola de eventos del núcleo se desborda (IN_Q_OVERFLOW) se vuelve a recorrer el árbol.
+ * - El directorio de salida no se vigila aunque esté dentro del árbol (se reconoce por su
+ *   dispositivo e inodo, ver IdentidadDirectorio); tampoco el manifiesto ni los archivos *.tmp.
+ *
+ * Para cada archivo se escribe SALIDA/<ruta relativa>.enc y el manifiesto guarda tamaño, fecha de
+ * modificación, hash del original y hash de la salida. El manifiesto se reescribe (temporal y
+ * renombrado) como mucho una vez por segundo y al terminar. Al arrancar se carga y los archivos
+ * cuyo tamaño y fecha coinciden no se reprocesan, así que reiniciar la vigilancia no repite trabajo;
+ * con --una-vez se sincroniza el árbol y se termina.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F14_pool_hilos.h: Los trabajadores y su cola acotada.
+ * - F29_demonio.h: transformarDescriptor (encripta y calcula los dos hashes en un recorrido) y el
+ *   manejo de SIGINT/SIGTERM.
+ * - F13_lote.h (a través de F29_demonio.h): normalizarDirectorio e IdentidadDirectorio.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F30_VIGILANCIA_H
+#define F30_VIGILANCIA_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F14_pool_hilos.h"
+#include "F29_demonio.h"
+#include <dirent.h>
+#include <map>
+#include <poll.h>
+#include <queue>
+#include <unordered_set>
+#include <sys/inotify.h>
+
+#define ESPERA_VIGILANCIA_MS 200
+#define CAPACIDAD_COLA_VIGILANCIA 64
+#define PERIODO_MANIFIESTO_MS 1000
+#define EVENTOS_VIGILANCIA (IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_EXCL_UNLINK)
+
+/**
+ * @struct EntradaVigilancia
+ * @brief Estado de un archivo ya procesado.
+ */
+
+struct EntradaVigilancia
+{
+    long long bytes = 0;
+    long long modificacion = 0; // Nanosegundos (st_mtim)
+    string hash;                // Del original
+    string hashEncriptado;      // De la salida .enc
+};
+
+// Crea los directorios que faltan hasta el último '/' de la ruta
+void crearDirectoriosPadre(const string &ruta)
+{
+    for (size_t barra = ruta.find('/', 1); barra != string::npos; barra = ruta.find('/', barra + 1))
+        crearDirectorio(ruta.substr(0, barra));
+}
+
+/**
+ * @class VigilanciaDirectorio
+ * @brief Mantiene al día la salida encriptada y el manifiesto de un árbol de directorios.
+ *
+ * El hilo que llama a ejecutar() lee los eventos, agrupa y reparte; los trabajadores del pool
+ * procesan los archivos.
+ */
+
+class VigilanciaDirectorio
+{
+private:
+    typedef chrono::steady_clock reloj;
+
+    string raiz, salida, rutaManifiesto;
+    chrono::milliseconds espera;
+    size_t capacidad;
+    int fdInotify, fdDespertar, fdDetener;
+    unordered_map<int, string> directorios; // Descriptor de vigilancia -> directorio (terminado en '/')
+
+    // Solo los usa el hilo de ejecutar()
+    unordered_map<string, reloj::time_point> pendientes;                               // Ruta -> cuándo procesarla
+    priority_queue<pair<reloj::time_point, string>, vector<pair<reloj::time_point, string>>, greater<>> plazos; // Con entradas obsoletas
+    reloj::time_point ultimoGuardado;
+
+    mutex mutex_estado; // Protege lo que sigue (lo tocan también los trabajadores)
+    unordered_set<string> enCurso, cambiadosEnCurso;
+    vector<string> reprogramar;
+    map<string, EntradaVigilancia> manifiesto; // Ordenado, para que el archivo salga ordenado
+    atomic<bool> manifiestoSucio;
+
+    atomic<long long> eventos, agrupados, procesados, sinCambios, errores, eliminados, desbordes;
+    PoolHilos pool; // Declarado al final: termina sus trabajos antes de que se destruya lo demás
+
+    // La salida puede estar dentro del árbol y escribirse distinto que la raíz ("./" frente a
+    // "salida/"): se reconoce por su identidad, que se vuelve a leer por si se ha recreado
+    bool esSalida(const struct stat &directorio) const { return IdentidadDirectorio(salida).es(directorio); }
+
+    // Los temporales de las salidas y del manifiesto, y el propio manifiesto, no se procesan
+    bool excluido(const string &ruta) const
+    {
+        if (ruta.size() >= 4 && ruta.compare(ruta.size() - 4, 4, ".tmp") == 0)
+            return true;
+        size_t barra = ruta.rfind('/'), barraManifiesto = rutaManifiesto.rfind('/');
+        string nombre = barra == string::npos ? ruta : ruta.substr(barra + 1);
+        string nombreManifiesto = barraManifiesto == string::npos ? rutaManifiesto : rutaManifiesto.substr(barraManifiesto + 1);
+        if (nombre != nombreManifiesto)
+            return false;
+        string directorio = barra == string::npos ? "." : ruta.substr(0, barra + 1);
+        string directorioManifiesto = barraManifiesto == string::npos ? "." : rutaManifiesto.substr(0, barraManifiesto + 1);
+        return IdentidadDirectorio(directorioManifiesto).es(directorio);
+    }
+
+    string rutaSalida(const string &ruta) const { return salida + ruta.substr(raiz.size()) + ".enc"; }
+
+    void programar(const string &ruta, chrono::milliseconds demora)
+    {
+        if (excluido(ruta))
+            return;
+        reloj::time_point cuando = reloj::now() + demora;
+        auto resultado = pendientes.emplace(ruta, cuando);
+        if (!resultado.second)
+        {
+            resultado.first->second = cuando;
+            agrupados++;
+        }
+        plazos.emplace(cuando, ruta);
+    }
+
+    // Vigila un directorio y programa sus archivos; 'vistos' recoge los archivos encontrados
+    void agregarDirectorio(const string &directorio, chrono::milliseconds demora, unordered_set<string> *vistos = nullptr)
+    {
+        struct stat propio;
+        if (stat(directorio.c_str(), &propio) != 0 || esSalida(propio))
+            return;
+        // Primero la vigilancia y después la lectura: no se pierde un archivo creado entre medias
+        int wd = inotify_add_watch(fdInotify, directorio.c_str(), EVENTOS_VIGILANCIA);
+        if (wd < 0)
+        {
+            errores++;
+            cerr << "No se pudo vigilar " << directorio << ": " << strerror(errno) << endl;
+        }
+        else
+            directorios[wd] = directorio;
+
+        DIR *dir = opendir(directorio.c_str());
+        if (dir == nullptr)
+            return;
+        vector<string> subdirectorios;
+        while (dirent *entrada = readdir(dir))
+        {
+            string nombre = entrada->d_name;
+            if (nombre == "." || nombre == "..")
+                continue;
+            string ruta = directorio + nombre;
+            struct stat estado;
+            if (lstat(ruta.c_str(), &estado) != 0)
+                continue;
+            if (S_ISDIR(estado.st_mode))
+            {
+                if (!esSalida(estado))
+                    subdirectorios.push_back(ruta + "/");
+            }
+            else if (S_ISREG(estado.st_mode) && !excluido(ruta))
+            {
+                programar(ruta, demora);
+                if (vistos != nullptr)
+                    vistos->insert(ruta);
+            }
+        }
+        closedir(dir);
+        for (const auto &subdirectorio : subdirectorios)
+            agregarDirectorio(subdirectorio, demora, vistos);
+    }
+
+    // Quita del manifiesto (y borra la salida de) las rutas que cumplen la condición
+    void olvidar(const function<bool(const string &)> &condicion)
+    {
+        lock_guard<mutex> lock(mutex_estado);
+        for (auto it = manifiesto.begin(); it != manifiesto.end();)
+            if (condicion(it->first))
+            {
+                unlink(rutaSalida(it->first).c_str());
+                it = manifiesto.erase(it);
+                manifiestoSucio = true;
+                eliminados++;
+            }
+            else
+                ++it;
+    }
+
+    void olvidarRuta(const string &ruta)
+    {
+        lock_guard<mutex> lock(mutex_estado);
+        if (manifiesto.erase(ruta) > 0)
+        {
+            unlink(rutaSalida(ruta).c_str());
+            manifiestoSucio = true;
+            eliminados++;
+        }
+    }
+
+    // Recorre todo el árbol (al arrancar o tras un desborde) y olvida los archivos que ya no están
+    void recorrerArbol()
+    {
+        unordered_set<string> vistos;
+        agregarDirectorio(raiz, chrono::milliseconds(0), &vistos);
+        olvidar([&](const string &ruta)
+                { return vistos.count(ruta) == 0; });
+    }
+
+    void leerEventos()
+    {
+        alignas(inotify_event) char buffer[64 * 1024];
+        ssize_t leidos;
+        while ((leidos = read(fdInotify, buffer, sizeof(buffer))) > 0)
+            for (char *p = buffer; p < buffer + leidos;)
+            {
+                const inotify_event *evento = reinterpret_cast<const inotify_event *>(p);
+                p += sizeof(inotify_event) + evento->len;
+                eventos++;
+
+                if (evento->mask & IN_Q_OVERFLOW)
+                {
+                    desbordes++;
+                    recorrerArbol();
+                    continue;
+                }
+                auto it = directorios.find(evento->wd);
+                if (it == directorios.end())
+                    continue;
+                if (evento->mask & IN_IGNORED)
+                {
+                    directorios.erase(it);
+                    continue;
+                }
+                string ruta = it->second + (evento->len > 0 ? evento->name : "");
+
+                if (evento->mask & IN_ISDIR)
+                {
+                    if (evento->mask & (IN_CREATE | IN_MOVED_TO))
+                        agregarDirectorio(ruta + "/", espera);
+                    else if (evento->mask & (IN_DELETE | IN_MOVED_FROM))
+                    {
+                        // Un directorio movido fuera del árbol conserva sus vigilancias: se quitan
+                        string prefijo = ruta + "/";
+                        for (const auto &d : directorios)
+                            if (d.second.compare(0, prefijo.size(), prefijo) == 0)
+                                inotify_rm_watch(fdInotify, d.first);
+                        olvidar([&](const string &r)
+                                { return r.compare(0, prefijo.size(), prefijo) == 0; });
+                    }
+                }
+                else if (evento->mask & (IN_DELETE | IN_MOVED_FROM))
+                {
+                    pendientes.erase(ruta);
+                    olvidarRuta(ruta);
+                }
+                else
+                    programar(ruta, espera);
+            }
+    }
+
+    // Manda al pool los pendientes cuyo plazo venció mientras quede sitio en la cola
+    void repartir()
+    {
+        {
+            lock_guard<mutex> lock(mutex_estado);
+            for (const auto &ruta : reprogramar)
+                programar(ruta, espera);
+            reprogramar.clear();
+        }
+        reloj::time_point ahora = reloj::now();
+        while (!plazos.empty() && plazos.top().first <= ahora && pool.trabajosEnCola() < capacidad)
+        {
+            auto [cuando, ruta] = plazos.top();
+            plazos.pop();
+            auto it = pendientes.find(ruta);
+            if (it == pendientes.end() || it->second != cuando)
+                continue; // Plazo obsoleto: el archivo volvió a cambiar o ya se repartió
+            pendientes.erase(it);
+            {
+                lock_guard<mutex> lock(mutex_estado);
+                if (!enCurso.insert(ruta).second)
+                {
+                    cambiadosEnCurso.insert(ruta); // Se repite cuando termine el trabajo actual
+                    continue;
+                }
+            }
+            pool.enviar([this, ruta]
+                        { procesar(ruta); });
+        }
+        while (!plazos.empty() && (pendientes.count(plazos.top().second) == 0 || pendientes[plazos.top().second] != plazos.top().first))
+            plazos.pop();
+    }
+
+    // Se ejecuta en un hilo del pool
+    void procesar(const string &ruta)
+    {
+        struct stat antes;
+        bool existe = stat(ruta.c_str(), &antes) == 0 && S_ISREG(antes.st_mode);
+        bool cambiado = false;
+        if (!existe)
+            olvidarRuta(ruta);
+        else
+        {
+            bool igual;
+            {
+                lock_guard<mutex> lock(mutex_estado);
+                auto it = manifiesto.find(ruta);
+                igual = it != manifiesto.end() && it->second.bytes == antes.st_size && it->second.modificacion == nanosegundosModificacion(antes);
+            }
+            if (igual)
+                sinCambios++;
+            else
+                cambiado = !encriptarArchivoVigilado(ruta);
+        }
+
+        {
+            lock_guard<mutex> lock(mutex_estado);
+            enCurso.erase(ruta);
+            if (cambiadosEnCurso.erase(ruta) > 0 || cambiado)
+                reprogramar.push_back(ruta);
+        }
+        uint64_t uno = 1;
+        if (write(fdDespertar, &uno, sizeof(uno)) < 0)
+            return;
+    }
+
+    /**
+     * @brief Encripta un archivo en su salida y actualiza el manifiesto.
+     *
+     * @return bool false si el archivo cambió mientras se leía (hay que repetirlo).
+     */
+    bool encriptarArchivoVigilado(const string &ruta)
+    {
+        string destino = rutaSalida(ruta), temporal = destino + ".tmp";
+        crearDirectoriosPadre(destino);
+        int fdEntrada = open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+        int fdSalida = open(temporal.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        struct stat antes, despues;
+        EntradaVigilancia entrada;
+        bool correcto = fdEntrada >= 0 && fdSalida >= 0 && fstat(fdEntrada, &antes) == 0 &&
+                        transformarDescriptor(fdEntrada, fdSalida, encriptarCaracter, entrada.hashEncriptado, entrada.bytes, &entrada.hash) &&
+                        fstat(fdEntrada, &despues) == 0;
+        if (fdEntrada >= 0)
+            close(fdEntrada);
+        if (fdSalida >= 0)
+            close(fdSalida);
+
+        if (!correcto)
+        {
+            if (fdEntrada >= 0) // Si no se pudo abrir, lo más probable es que se haya borrado: lo dirá su evento
+            {
+                errores++;
+                cerr << "Error al procesar " << ruta << endl;
+            }
+            unlink(temporal.c_str());
+            return true;
+        }
+        entrada.modificacion = nanosegundosModificacion(despues);
+        if (antes.st_size != despues.st_size || nanosegundosModificacion(antes) != entrada.modificacion || entrada.bytes != despues.st_size)
+        {
+            unlink(temporal.c_str());
+            return false;
+        }
+
+        // Se publica con mutex_estado tomado, igual que olvidarRuta: si el archivo se borró (o se
+        // reemplazó) mientras se leía, su evento ya pasó o pasará después y no lo resucitamos
+        lock_guard<mutex> lock(mutex_estado);
+        struct stat actual;
+        if (despues.st_nlink == 0 || stat(ruta.c_str(), &actual) != 0 || actual.st_dev != despues.st_dev || actual.st_ino != despues.st_ino)
+        {
+            unlink(temporal.c_str());
+            return true; // Lo que haya ahora en la ruta llega con su propio evento
+        }
+        if (rename(temporal.c_str(), destino.c_str()) != 0)
+        {
+            errores++;
+            unlink(temporal.c_str());
+            return true;
+        }
+        manifiesto[ruta] = entrada;
+        manifiestoSucio = true;
+        procesados++;
+        return true;
+    }
+
+    // Parte una línea del manifiesto en campos separados por tabuladores, incluidos los vacíos
+    static vector<string> camposManifiesto(const string &linea)
+    {
+        vector<string> campos;
+        size_t inicio = 0, fin;
+        while ((fin = linea.find('\t', inicio)) != string::npos)
+        {
+            campos.push_back(linea.substr(inicio, fin - inicio));
+            inicio = fin + 1;
+        }
+        campos.push_back(linea.substr(inicio));
+        return campos;
+    }
+
+    void cargarManifiesto()
+    {
+        ifstream archivo(rutaManifiesto);
+        string linea;
+        while (getline(archivo, linea))
+        {
+            if (linea.empty() || linea[0] == '#')
+                continue;
+            // Los hashes pueden venir vacíos (manifiestos anteriores con archivos vacíos): getline
+            // no devuelve un último campo vacío y la entrada se perdería
+            vector<string> campos = camposManifiesto(linea);
+            if (campos.size() < 5)
+                continue;
+            EntradaVigilancia entrada;
+            entrada.bytes = atoll(campos[1].c_str());
+            entrada.modificacion = atoll(campos[2].c_str());
+            entrada.hash = campos[3];
+            entrada.hashEncriptado = campos[4];
+            manifiesto[campos[0]] = entrada;
+        }
+    }
+
+    // Reescribe el manifiesto de una vez (temporal y renombrado)
+    void guardarManifiesto()
+    {
+        ostringstream contenido;
+        {
+            lock_guard<mutex> lock(mutex_estado);
+            if (!manifiestoSucio)
+                return;
+            contenido << "# vigilancia raiz=" << raiz << " salida=" << salida << " campos=ruta,bytes,modificacion_ns,sha256,sha256_encriptado\n";
+            for (const auto &e : manifiesto)
+                contenido << e.first << '\t' << e.second.bytes << '\t' << e.second.modificacion << '\t' << e.second.hash << '\t'
+                          << e.second.hashEncriptado << '\n';
+            manifiestoSucio = false;
+        }
+        ultimoGuardado = reloj::now();
+        string temporal = rutaManifiesto + ".tmp";
+        ofstream archivo(temporal);
+        archivo << contenido.str();
+        archivo.close();
+        if (!archivo || rename(temporal.c_str(), rutaManifiesto.c_str()) != 0)
+            cerr << "No se pudo escribir el manifiesto " << rutaManifiesto << endl;
+    }
+
+    bool ocupado()
+    {
+        lock_guard<mutex> lock(mutex_estado);
+        return !pendientes.empty() || !enCurso.empty() || !reprogramar.empty();
+    }
+
+public:
+    VigilanciaDirectorio(const string &directorio, const string &rutaSalidaDatos, const string &manifiestoDatos, int numHilos = 0,
+                         int esperaMs = ESPERA_VIGILANCIA_MS, size_t capacidadCola = CAPACIDAD_COLA_VIGILANCIA)
+        : raiz(normalizarDirectorio(directorio)), salida(normalizarDirectorio(rutaSalidaDatos)), rutaManifiesto(manifiestoDatos),
+          espera(esperaMs), capacidad(max<size_t>(1, capacidadCola)), fdInotify(-1), fdDespertar(-1), fdDetener(-1), manifiestoSucio(false),
+          eventos(0), agrupados(0), procesados(0), sinCambios(0), errores(0), eliminados(0), desbordes(0), pool(numHilos, capacidad)
+    {
+        if (rutaManifiesto.empty())
+            rutaManifiesto = salida + "vigilancia.manifiesto";
+    }
+
+    ~VigilanciaDirectorio()
+    {
+        pool.esperarTodo();
+        if (fdDetener >= 0)
+            eventoDetenerDemonio = -1;
+        for (int fd : {fdInotify, fdDespertar, fdDetener})
+            if (fd >= 0)
+                close(fd);
+    }
+
+    VigilanciaDirectorio(const VigilanciaDirectorio &) = delete;
+    VigilanciaDirectorio &operator=(const VigilanciaDirectorio &) = delete;
+
+    /**
+     * @brief Abre inotify, carga el manifiesto anterior y registra las vigilancias del árbol.
+     */
+    bool iniciar()
+    {
+        struct stat estado;
+        if (stat(raiz.c_str(), &estado) != 0 || !S_ISDIR(estado.st_mode))
+        {
+            cerr << "No existe el directorio " << raiz << endl;
+            return false;
+        }
+        crearDirectoriosPadre(salida);
+        fdInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        fdDespertar = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        fdDetener = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fdInotify < 0 || fdDespertar < 0 || fdDetener < 0)
+        {
+            cerr << "No se pudo iniciar inotify: " << strerror(errno) << endl;
+            return false;
+        }
+        eventoDetenerDemonio = fdDetener;
+        signal(SIGINT, manejarSenalDemonio);
+        signal(SIGTERM, manejarSenalDemonio);
+
+        cargarManifiesto();
+        recorrerArbol();
+        return true;
+    }
+
+    /**
+     * @brief Procesa eventos hasta SIGINT/SIGTERM o, con unaVez, hasta dejar el árbol sincronizado.
+     */
+    void ejecutar(bool unaVez = false)
+    {
+        while (true)
+        {
+            repartir();
+            bool pendiente = ocupado();
+            if (unaVez && !pendiente)
+                break;
+            if (!pendiente)
+                guardarManifiesto(); // Todo al día: el manifiesto también
+
+            // Se duerme hasta el próximo plazo, el próximo guardado del manifiesto o un evento
+            long long espera = -1;
+            if (!plazos.empty() && pool.trabajosEnCola() < capacidad)
+                espera = max(0LL, static_cast<long long>(chrono::duration_cast<chrono::milliseconds>(plazos.top().first - reloj::now()).count()) + 1);
+            if (manifiestoSucio)
+            {
+                long long guardado = PERIODO_MANIFIESTO_MS - chrono::duration_cast<chrono::milliseconds>(reloj::now() - ultimoGuardado).count();
+                espera = espera < 0 ? max(0LL, guardado) : min(espera, max(0LL, guardado));
+            }
+
+            pollfd fds[3] = {{fdInotify, POLLIN, 0}, {fdDespertar, POLLIN, 0}, {fdDetener, POLLIN, 0}};
+            if (poll(fds, 3, static_cast<int>(espera)) < 0 && errno != EINTR)
+                break;
+            uint64_t valor;
+            if (fds[2].revents & POLLIN)
+                break;
+            if ((fds[1].revents & POLLIN) && read(fdDespertar, &valor, sizeof(valor)) < 0)
+                valor = 0;
+            if (fds[0].revents & POLLIN)
+                leerEventos();
+            if (chrono::duration_cast<chrono::milliseconds>(reloj::now() - ultimoGuardado).count() >= PERIODO_MANIFIESTO_MS)
+                guardarManifiesto();
+        }
+        pool.esperarTodo();
+        {
+            lock_guard<mutex> lock(mutex_estado);
+            reprogramar.clear(); // Los que cambiaron en el último momento se procesan al volver a arrancar
+        }
+        guardarManifiesto();
+    }
+
+    long long numeroErrores() const { return errores; }
+
+    string resumen()
+    {
+        size_t entradas;
+        {
+            lock_guard<mutex> lock(mutex_estado);
+            entradas = manifiesto.size();
+        }
+        ostringstream oss;
+        oss << "Eventos: " << eventos << " (" << agrupados << " agrupados, " << desbordes << " desbordes), " << directorios.size()
+            << " directorios vigilados\n"
+            << "Archivos: " << procesados << " procesados, " << sinCambios << " sin cambios, " << eliminados << " eliminados, " << errores
+            << " con error\n"
+            << "Manifiesto: " << rutaManifiesto << " (" << entradas << " archivos)";
+        return oss.str();
+    }
+};
+
+/**
+ * @brief crypto watch DIR [-o SALIDA] [--manifiesto RUTA] [--hilos N] [--espera MS] [--cola N] [--una-vez]
+ *
+ * @return int SALIDA_CORRECTA, SALIDA_VERIFICACION_FALLIDA si algún archivo o directorio dio
+ *             error, o SALIDA_ERROR_USO.
+ */
+int mainVigilancia(int argc, char *argv[])
+{
+    string directorio, salida = "file_workspace_watch/", manifiesto;
+    int hilos = 0, espera = ESPERA_VIGILANCIA_MS, cola = CAPACIDAD_COLA_VIGILANCIA;
+    bool unaVez = false, valido = true;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        bool valor = a + 1 < argc;
+        if ((opcion == "-o" || opcion == "--salida") && valor)
+            salida = argv[++a];
+        else if (opcion == "--manifiesto" && valor)
+            manifiesto = argv[++a];
+        else if (opcion == "--hilos" && valor)
+            hilos = atoi(argv[++a]);
+        else if (opcion == "--espera" && valor)
+            espera = max(0, atoi(argv[++a]));
+        else if (opcion == "--cola" && valor)
+            cola = max(1, atoi(argv[++a]));
+        else if (opcion == "--una-vez")
+            unaVez = true;
+        else if (directorio.empty() && !opcion.empty() && opcion[0] != '-')
+            directorio = opcion;
+        else
+            valido = false;
+    }
+    if (!valido || directorio.empty())
+    {
+        cerr << "Uso: crypto watch DIR [-o SALIDA] [--manifiesto RUTA] [--hilos N] [--espera MS] [--cola N] [--una-vez]" << endl;
+        return SALIDA_ERROR_USO;
+    }
+
+    VigilanciaDirectorio vigilancia(directorio, salida, manifiesto, hilos, espera, cola);
+    if (!vigilancia.iniciar())
+        return SALIDA_ERROR_USO;
+    if (!unaVez)
+        cout << "Vigilando " << directorio << " (Ctrl+C para terminar)" << endl;
+    vigilancia.ejecutar(unaVez);
+    cout << vigilancia.resumen() << endl;
+    return vigilancia.numeroErrores() == 0 ? SALIDA_CORRECTA : SALIDA_VERIFICACION_FALLIDA;
+}
+
+bool esSubcomandoVigilancia(const string &nombre) { return nombre == "watch" || nombre == "vigilar"; }
+
+#endif // F30_VIGILANCIA_H
@@ -0,0 +1,281 @@
+/**
+ * @file F31_delta.h
+ * @brief Reencriptado por bloques: solo se cifran y escriben los bloques que cambiaron.
+ *
+ * Cuando un archivo grande cambia en unos pocos bytes, encriptarArchivo vuelve a cifrar y
+ * escribir el archivo entero y generarHashArchivo lo vuelve a leer. reencriptarDelta guarda junto
+ * a cada salida .sha una firma (salida + ".bloques") con el SHA-256 de cada bloque de 1 MiB del
+ * original. En la siguiente ejecución:
+ *
+ * - Si el tamaño y la fecha de modificación del original coinciden con la firma, se da por
+ *   igual y no se lee nada (como make o rsync sin --checksum). Un cambio que conserve tamaño y
+ *   fecha (touch -r, un reloj que retrocede) no se detecta: --completo fuerza la reescritura.
+ * - Si no, se lee el original, se calcula el SHA-256 de cada bloque (repartidos entre hilos) y
+ *   solo los bloques cuyo hash cambió se cifran y se escriben con pwrite en su posición.
+ * - El hash del archivo es el hash en árbol de F15_robo_trabajo.h (SHA-256 de los hashes de los
+ *   bloques): se recalcula con los hashes de las hojas, sin volver a hashear el contenido.
+ *
+ * Cuando el tamaño o la fecha cambian, el original se lee entero para saber qué bloques cambiaron;
+ * lo que se ahorra es cifrar y escribir (lo más caro) los bloques que no cambiaron.
+ *
+ * La firma solo se usa si la salida es la que quedó al escribirla (mismo tamaño y fecha de
+ * modificación) y con el mismo tamaño de bloque; si no, o si no existe, se reescribe la salida
+ * entera. La firma se escribe después de la salida (temporal y renombrado): si el proceso se corta
+ * a medias, la salida ya no coincide con la firma y la siguiente ejecución la reescribe entera.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F15_robo_trabajo.h: El hash en árbol y el tamaño de fragmento (1 MiB).
+ * - F28_cli.h: El reparto por tramos entre hilos y las lecturas y escrituras completas.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#ifndef F31_DELTA_H
+#define F31_DELTA_H
+#include "../resources.h" // Importa las librerías estándar de C++ necesarias para la implementación
+#include "F15_robo_trabajo.h"
+#include "F28_cli.h"
+
+#define TAMANO_BLOQUE_DELTA TAMANO_FRAGMENTO_ROBO
+#define EXTENSION_FIRMA_BLOQUES ".bloques"
+
+/**
+ * @struct FirmaBloques
+ * @brief Contenido de la firma por bloques de una salida.
+ */
+
+struct FirmaBloques
+{
+    long long tamanoBloque = TAMANO_BLOQUE_DELTA;
+    long long bytes = 0;               // Tamaño del original (y de la salida)
+    long long entradaModificacion = 0; // st_mtim del original, en nanosegundos
+    long long salidaModificacion = 0;  // st_mtim de la salida al terminar de escribirla
+    string arbol;                      // Hash en árbol del original
+    vector<string> digestos;           // SHA-256 de cada bloque del original
+};
+
+/**
+ * @struct ResultadoDelta
+ * @brief Lo que hizo reencriptarDelta con un archivo.
+ */
+
+struct ResultadoDelta
+{
+    bool correcto = false;
+    bool sinCambios = false; // Tamaño y fecha iguales a la firma: no se leyó nada
+    bool completo = false;   // No había firma válida: se reescribió toda la salida
+    long long bytes = 0;
+    long long bloques = 0, bloquesCambiados = 0;
+    long long bytesLeidos = 0, bytesEscritos = 0;
+    string hashArbol;
+    string error;
+    double segundos = 0.0;
+};
+
+bool leerFirmaBloques(const string &ruta, FirmaBloques &firma)
+{
+    ifstream archivo(ruta);
+    string linea;
+    if (!getline(archivo, linea) || linea.compare(0, 10, "# bloques ") != 0)
+        return false;
+    istringstream campos(linea.substr(10));
+    string campo;
+    while (campos >> campo)
+    {
+        size_t igual = campo.find('=');
+        string clave = campo.substr(0, igual), valor = igual == string::npos ? "" : campo.substr(igual + 1);
+        if (clave == "tamano_bloque")
+            firma.tamanoBloque = atoll(valor.c_str());
+        else if (clave == "bytes")
+            firma.bytes = atoll(valor.c_str());
+        else if (clave == "entrada_mtime")
+            firma.entradaModificacion = atoll(valor.c_str());
+        else if (clave == "salida_mtime")
+            firma.salidaModificacion = atoll(valor.c_str());
+        else if (clave == "arbol")
+            firma.arbol = valor;
+    }
+    firma.digestos.clear();
+    while (getline(archivo, linea))
+        firma.digestos.push_back(linea);
+    long long bloques = firma.tamanoBloque > 0 ? (firma.bytes + firma.tamanoBloque - 1) / firma.tamanoBloque : -1;
+    return static_cast<long long>(firma.digestos.size()) == bloques;
+}
+
+bool guardarFirmaBloques(const string &ruta, const FirmaBloques &firma)
+{
+    string temporal = ruta + ".tmp";
+    ofstream archivo(temporal);
+    archivo << "# bloques tamano_bloque=" << firma.tamanoBloque << " bytes=" << firma.bytes << " entrada_mtime=" << firma.entradaModificacion
+            << " salida_mtime=" << firma.salidaModificacion << " arbol=" << firma.arbol << "\n";
+    for (const auto &d : firma.digestos)
+        archivo << d << "\n";
+    archivo.close();
+    if (!archivo || rename(temporal.c_str(), ruta.c_str()) != 0)
+    {
+        unlink(temporal.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Encripta entrada en salida reescribiendo solo los bloques que cambiaron desde la última vez.
+ *
+ * @param entrada Archivo original.
+ * @param salida Archivo encriptado (.sha); la firma se guarda en salida + ".bloques".
+ * @param numHilos Hilos que leen y cifran bloques; 0 usa hardware_concurrency().
+ * @param completo Ignora la firma y reescribe la salida entera.
+ * @param tamanoBloque Tamaño de bloque (debe coincidir con el de la firma para aprovecharla).
+ */
+ResultadoDelta reencriptarDelta(const string &entrada, const string &salida, int numHilos = 0, bool completo = false,
+                                long long tamanoBloque = TAMANO_BLOQUE_DELTA)
+{
+    SpanTraza span("reencriptarDelta");
+    auto inicio = chrono::steady_clock::now();
+    ResultadoDelta r;
+    const string rutaFirma = salida + EXTENSION_FIRMA_BLOQUES;
+    if (numHilos <= 0)
+        numHilos = max(1u, thread::hardware_concurrency());
+
+    struct stat antes, despues, estadoSalida;
+    if (stat(entrada.c_str(), &antes) != 0 || !S_ISREG(antes.st_mode))
+    {
+        r.error = "no se pudo abrir " + entrada;
+        return r;
+    }
+    r.bytes = antes.st_size;
+    r.bloques = (r.bytes + tamanoBloque - 1) / tamanoBloque;
+
+    FirmaBloques anterior;
+    bool valida = !completo && leerFirmaBloques(rutaFirma, anterior) && anterior.tamanoBloque == tamanoBloque &&
+                  stat(salida.c_str(), &estadoSalida) == 0 && estadoSalida.st_size == anterior.bytes &&
+                  nanosegundosModificacion(estadoSalida) == anterior.salidaModificacion;
+    r.completo = !valida;
+    if (valida && anterior.bytes == r.bytes && anterior.entradaModificacion == nanosegundosModificacion(antes))
+    {
+        r.correcto = r.sinCambios = true;
+        r.hashArbol = anterior.arbol;
+        r.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        return r;
+    }
+
+    int fdEntrada = open(entrada.c_str(), O_RDONLY | O_CLOEXEC);
+    int fdSalida = open(salida.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (valida ? 0 : O_TRUNC), 0644);
+    FirmaBloques firma;
+    firma.tamanoBloque = tamanoBloque;
+    firma.bytes = r.bytes;
+    firma.entradaModificacion = nanosegundosModificacion(antes);
+    firma.digestos.assign(r.bloques, "");
+    atomic<long long> cambiados(0), escritos(0);
+
+    bool correcto = fdEntrada >= 0 && fdSalida >= 0 && ftruncate(fdSalida, r.bytes) == 0;
+    if (correcto)
+        correcto = repartirTramos(r.bytes, tamanoBloque, numHilos, [&](long long desde, long long hasta)
+                                  {
+            long long k = desde / tamanoBloque, largo = hasta - desde;
+            BufferPrestado bloque(largo);
+            char *datos = bloque.datos();
+            if (!leerCompleto(fdEntrada, datos, largo, desde))
+                return false;
+            sha256 contexto;
+            contexto.sha_append(reinterpret_cast<const BYTE *>(datos), largo);
+            firma.digestos[k] = contexto.sha_digest();
+            if (valida && k < static_cast<long long>(anterior.digestos.size()) && anterior.digestos[k] == firma.digestos[k])
+                return true; // El bloque cifrado que hay en la salida sigue valiendo
+
+            for (long long j = 0; j < largo; j++)
+                datos[j] = encriptarCaracter(datos[j]);
+            cambiados++;
+            escritos += largo;
+            return escribirCompleto(fdSalida, datos, largo, desde); });
+    if (fdEntrada >= 0)
+    {
+        correcto = fstat(fdEntrada, &despues) == 0 && correcto;
+        close(fdEntrada);
+    }
+    if (fdSalida >= 0)
+        close(fdSalida);
+
+    r.bloquesCambiados = cambiados;
+    r.bytesEscritos = escritos;
+    r.bytesLeidos = r.bytes;
+    if (!correcto)
+        r.error = "error de E/S con " + entrada + " o " + salida;
+    else if (despues.st_size != antes.st_size || nanosegundosModificacion(despues) != nanosegundosModificacion(antes))
+        r.error = entrada + " cambio mientras se leia";
+    else if (stat(salida.c_str(), &estadoSalida) != 0)
+        r.error = "no se pudo leer " + salida;
+
+    if (!r.error.empty())
+        unlink(rutaFirma.c_str()); // La salida puede no corresponder a ninguna firma: la próxima vez, entera
+    else
+    {
+        firma.salidaModificacion = nanosegundosModificacion(estadoSalida);
+        firma.arbol = calcularHashArbol(firma.digestos);
+        r.hashArbol = firma.arbol;
+        r.correcto = guardarFirmaBloques(rutaFirma, firma);
+        if (!r.correcto)
+            r.error = "no se pudo escribir " + rutaFirma;
+    }
+    r.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+/**
+ * @brief crypto delta -i ENTRADA -o SALIDA [--hilos N] [--bloque BYTES] [--completo] [--formato texto|json]
+ */
+int mainDelta(int argc, char *argv[])
+{
+    string entrada, salida;
+    int hilos = 0;
+    long long bloque = TAMANO_BLOQUE_DELTA;
+    bool completo = false, json = false, valido = true;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        bool valor = a + 1 < argc;
+        if ((opcion == "-i" || opcion == "--entrada") && valor)
+            entrada = argv[++a];
+        else if ((opcion == "-o" || opcion == "--salida") && valor)
+            salida = argv[++a];
+        else if (opcion == "--hilos" && valor)
+            hilos = atoi(argv[++a]);
+        else if (opcion == "--bloque" && valor)
+            bloque = atoll(argv[++a]);
+        else if (opcion == "--completo")
+            completo = true;
+        else if (opcion == "--formato" && valor)
+            json = string(argv[++a]) == "json";
+        else
+            valido = false;
+    }
+    if (!valido || entrada.empty() || salida.empty() || bloque <= 0)
+    {
+        cerr << "Uso: crypto delta -i ENTRADA -o SALIDA [--hilos N] [--bloque BYTES] [--completo] [--formato texto|json]" << endl;
+        return SALIDA_ERROR_USO;
+    }
+
+    ResultadoDelta r = reencriptarDelta(entrada, salida, hilos, completo, bloque);
+    if (json)
+        cout << fixed << setprecision(6) << "{\"comando\":\"delta\",\"ruta\":\"" << escaparJSON(entrada) << "\",\"salida\":\"" << escaparJSON(salida)
+             << "\",\"correcto\":" << (r.correcto ? "true" : "false") << ",\"sinCambios\":" << (r.sinCambios ? "true" : "false")
+             << ",\"completo\":" << (r.completo ? "true" : "false") << ",\"bytes\":" << r.bytes << ",\"bloques\":" << r.bloques
+             << ",\"bloquesCambiados\":" << r.bloquesCambiados << ",\"bytesLeidos\":" << r.bytesLeidos << ",\"bytesEscritos\":" << r.bytesEscritos
+             << ",\"sha256Arbol\":\"" << r.hashArbol << "\",\"segundos\":" << r.segundos
+             << (r.error.empty() ? "" : ",\"error\":\"" + escaparJSON(r.error) + "\"") << "}" << endl;
+    else if (!r.correcto)
+        cerr << "Error: " << r.error << endl;
+    else
+        cout << r.hashArbol << "  " << entrada << "\n"
+             << (r.sinCambios ? "Sin cambios" : r.completo ? "Reescrito entero" : "Reencriptado por bloques") << ": " << r.bloquesCambiados
+             << " de " << r.bloques << " bloques, " << formatearBytes(r.bytesEscritos) << " escritos, " << fixed << setprecision(3) << r.segundos
+             << " s" << endl;
+    return r.correcto ? SALIDA_CORRECTA : SALIDA_ERROR_USO;
+}
+
+bool esSubcomandoDelta(const string &nombre) { return nombre == "delta"; }
+
+#endif // F31_DELTA_H
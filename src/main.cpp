@@ -1,6 +1,15 @@
+#define REEMPLAZAR_OPERADORES_MEMORIA // Este programa reemplaza operator new/delete para --memoria (F26_memoria.h)
 #include "../resources.h"
+#include <memory>
 #include "F06_main_secuencial.h"
 #include "F07_main_paralelo.h"
+#include "F12_planificador_dag.h"
+#include "F13_lote.h"
+#include "F15_robo_trabajo.h"
+#include "F18_corrutinas.h"
+#include "F24_banco_pruebas.h"
+#include "F30_vigilancia.h"
+#include "F31_delta.h"
 
 // PARA COPIA N = 1
 // 1- Copiar el contenido original.txt en copia1.txt
@@ -10,31 +19,328 @@
 // 5- Comparar los hash
 // 6- Desencriptar copia1.txt en otro archivo d_copia1.txt
 // 7- Comparar el contenido de d_copia1.txt con original.txt
+//
+// Opciones de línea de comandos:
+//   --dedup       Reutiliza los .sha/.des de entradas con el mismo contenido (almacén por contenido)
+//   --fusionado   Ejecuta los 7 pasos en un solo recorrido por bloques del original
+//   --verificar   Comprueba el desencriptado en memoria, sin escribir los archivos .des
+//   --etapas      Muestra el tiempo acumulado de cada etapa (activado siempre con --fusionado)
+//   --ciclos      Con las etapas, mide también ciclos por byte con el TSC (calibrado al arrancar)
+//   --contadores  Con las etapas, cuenta IPC y fallos de caché/saltos/página por etapa (perf_event_open)
+//   --memoria     Con las etapas, cuenta bytes reservados, reservas y pico de memoria por etapa y por proceso
+//   --sin-pool    Los buffers de E/S y de trabajo se reservan con new en cada operación (sin el pool por hilo)
+//   --paginas-grandes  El pool de buffers pide páginas grandes transparentes (madvise) para su memoria
+//   --histogramas ARCHIVO  Con las etapas, guarda los histogramas de latencia (por etapa y por proceso)
+//   --traza ARCHIVO  Guarda los spans de cada hilo en formato Chrome Trace Event (se abre en Perfetto)
+//   --dag         La fase paralela ejecuta las etapas de cada proceso como un grafo de tareas
+//   --hilos N     Cantidad de hilos del pool (por defecto, los núcleos disponibles)
+//   --hilo-por-copia  La fase paralela usa el modelo original de un hilo por copia
+//   --corrutinas  La fase paralela usa corrutinas sobre un reactor epoll (requiere compilar con C++20)
+//   --en-vuelo N  Procesos en curso a la vez con --corrutinas (por defecto 1024)
+//   --adaptativo P    Ajusta en marcha los hilos activos del pool: escalada (hill climbing) o aimd
+//   --hilos-min N / --hilos-max N  Límites del ajuste (por defecto 1 y 2 por núcleo); --hilos es el valor inicial
+//   --periodo-control MS  Cada cuánto mide y decide el controlador (por defecto 250 ms)
+//   --control-en-vivo     Muestra cada decisión del controlador en cuanto la toma
+//   --afinidad P      Fija los hilos del pool a CPUs: ninguna, round-robin, compacta o dispersa
+//   --nodos-simulados K  Trata las CPUs como K nodos NUMA (para probar en máquinas de un nodo)
+//
+// Banco de pruebas (repite secuencial y paralelo y da medianas con intervalo de confianza):
+//   --banco               Activa el banco en lugar de una sola ejecución de cada modo
+//   --repeticiones R      Rondas medidas (por defecto 5)
+//   --calentamiento W     Rondas iniciales que no se cuentan (por defecto 1)
+//   --sin-alternar        Ejecuta siempre secuencial y después paralelo
+//   --regenerar           Borra las copias generadas (y el almacén de --dedup) antes de cada ejecución
+//   --vaciar-cache        Descarta de la caché de páginas los directorios de trabajo antes de cada ejecución
+//   --json ARCHIVO        Guarda también los resultados (con todas las muestras) en JSON
+//
+// Modo por lotes (no pregunta N; procesa archivos reales en lugar de copias de original.txt):
+//   --lote-dir DIR        Procesa todos los archivos bajo DIR (recorrido paralelo)
+//   --lote-lista ARCHIVO  Procesa las rutas listadas en ARCHIVO, una por línea ("-" = stdin);
+//                         también acepta el manifiesto de benchmarks/generar_corpus
+//   --salida DIR          Directorio de salida del lote (por defecto file_workspace_batch/)
+//   --robo                Reparte los archivos en fragmentos con robo de trabajo entre hilos; siempre
+//                         verifica en memoria y no admite --dedup, --fusionado ni la medida de etapas
+//   --fragmento BYTES     Tamaño de los fragmentos de --robo (por defecto 1 MiB)
 
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && esSubcomandoCLI(argv[1]))
+        return mainCLI(argc - 1, argv + 1);
+    if (argc > 1 && esSubcomandoDemonio(argv[1]))
+        return mainSubcomandoDemonio(argc - 1, argv + 1);
+    if (argc > 1 && esSubcomandoVigilancia(argv[1]))
+        return mainVigilancia(argc - 1, argv + 1);
+    if (argc > 1 && esSubcomandoDelta(argv[1]))
+        return mainDelta(argc - 1, argv + 1);
+
+    bool deduplicar = false, fusionado = false, soloVerificar = false, etapas = false, dag = false, hiloPorCopia = false, corrutinas = false;
+    int hilos = 0, nodosSimulados = 0, enVuelo = 1024;
+    PoliticaAfinidad afinidad = AFINIDAD_NINGUNA;
+    bool adaptativo = false, ciclos = false, contadores = false, memoria = false;
+    ConfiguracionControl control;
+    bool banco = false;
+    ConfiguracionBanco configuracionBanco;
+    string archivoJSON;
+    string loteDirectorio, loteLista, salidaLote = "file_workspace_batch/", archivoHistogramas, archivoTraza;
+    bool robo = false;
+    long long fragmento = TAMANO_FRAGMENTO_ROBO;
+    for (int a = 1; a < argc; a++)
+    {
+        string opcion = argv[a];
+        if (opcion == "--dedup")
+            deduplicar = true;
+        else if (opcion == "--fusionado")
+            fusionado = etapas = true;
+        else if (opcion == "--verificar")
+            soloVerificar = true;
+        else if (opcion == "--etapas")
+            etapas = true;
+        else if (opcion == "--ciclos")
+            etapas = ciclos = true;
+        else if (opcion == "--contadores")
+            etapas = contadores = true;
+        else if (opcion == "--memoria")
+            etapas = memoria = true;
+        else if (opcion == "--sin-pool")
+            desactivarPoolBuffers();
+        else if (opcion == "--paginas-grandes")
+            activarPaginasGrandes();
+        else if (opcion == "--histogramas" && a + 1 < argc)
+        {
+            archivoHistogramas = argv[++a];
+            etapas = true;
+        }
+        else if (opcion == "--traza" && a + 1 < argc)
+            archivoTraza = argv[++a];
+        else if (opcion == "--dag")
+            dag = true;
+        else if (opcion == "--hilo-por-copia")
+            hiloPorCopia = true;
+        else if (opcion == "--corrutinas")
+            corrutinas = true;
+        else if (opcion == "--en-vuelo" && a + 1 < argc)
+            enVuelo = max(1, atoi(argv[++a]));
+        else if (opcion == "--hilos" && a + 1 < argc)
+            hilos = atoi(argv[++a]);
+        else if (opcion == "--adaptativo" && a + 1 < argc)
+        {
+            string politica = argv[++a];
+            adaptativo = politica == nombresControl[CONTROL_ESCALADA] || politica == nombresControl[CONTROL_AIMD];
+            control.politica = politica == nombresControl[CONTROL_AIMD] ? CONTROL_AIMD : CONTROL_ESCALADA;
+            if (!adaptativo)
+                cerr << "Politica de control desconocida: " << politica << endl;
+        }
+        else if (opcion == "--hilos-min" && a + 1 < argc)
+            control.minimo = atoi(argv[++a]);
+        else if (opcion == "--hilos-max" && a + 1 < argc)
+            control.maximo = atoi(argv[++a]);
+        else if (opcion == "--periodo-control" && a + 1 < argc)
+            control.periodoMs = atoi(argv[++a]);
+        else if (opcion == "--control-en-vivo")
+            control.mostrarEnVivo = true;
+        else if (opcion == "--afinidad" && a + 1 < argc)
+        {
+            if (!leerPoliticaAfinidad(argv[++a], afinidad))
+                cerr << "Politica de afinidad desconocida: " << argv[a] << endl;
+        }
+        else if (opcion == "--nodos-simulados" && a + 1 < argc)
+            nodosSimulados = atoi(argv[++a]);
+        else if (opcion == "--banco")
+            banco = true;
+        else if (opcion == "--repeticiones" && a + 1 < argc)
+            configuracionBanco.repeticiones = atoi(argv[++a]);
+        else if (opcion == "--calentamiento" && a + 1 < argc)
+            configuracionBanco.calentamiento = atoi(argv[++a]);
+        else if (opcion == "--sin-alternar")
+            configuracionBanco.alternar = false;
+        else if (opcion == "--regenerar")
+            configuracionBanco.regenerar = true;
+        else if (opcion == "--vaciar-cache")
+            configuracionBanco.vaciarCache = true;
+        else if (opcion == "--json" && a + 1 < argc)
+            archivoJSON = argv[++a];
+        else if (opcion == "--lote-dir" && a + 1 < argc)
+            loteDirectorio = argv[++a];
+        else if (opcion == "--lote-lista" && a + 1 < argc)
+            loteLista = argv[++a];
+        else if (opcion == "--salida" && a + 1 < argc)
+            salidaLote = argv[++a];
+        else if (opcion == "--robo")
+            robo = true;
+        else if (opcion == "--fragmento" && a + 1 < argc)
+            fragmento = max(1LL, atoll(argv[++a]));
+        else
+            cerr << "Opcion desconocida: " << opcion << endl;
+    }
+
+    // El robo de trabajo tiene su propio pipeline: no pasa por el almacén ni por los cronómetros de etapa
+    if (robo && (deduplicar || fusionado || etapas))
+    {
+        cerr << "--robo no admite --dedup, --fusionado, --etapas, --ciclos, --contadores, --memoria ni --histogramas" << endl;
+        return 1;
+    }
+
+    if (ciclos)
+        calibrarCiclos(); // Antes de lanzar hilos, con la máquina todavía en reposo
+    if (!archivoTraza.empty())
+    {
+        activarTraza();
+        nombrarHiloTraza("principal");
+    }
+    if (memoria)
+        activarRastreoMemoria();
+
+    if (!loteDirectorio.empty() || !loteLista.empty())
+    {
+        vector<string> archivos;
+        if (!loteDirectorio.empty())
+            archivos = RecorridoParalelo(salidaLote).recorrer(loteDirectorio, hilos);
+        else
+            archivos = leerListaArchivos(loteLista);
+
+        if (robo)
+        {
+            ResumenLote resumen = mainRoboTrabajo(archivos, salidaLote, hilos, fragmento);
+            if (!archivoTraza.empty())
+                guardarTraza(archivoTraza);
+            return resumen.fallidos == 0 ? 0 : 1;
+        }
+
+        unique_ptr<AlmacenContenido> almacenLote;
+        TiemposEtapas tiemposLote;
+        OpcionesProceso opcionesLote;
+        opcionesLote.fusionado = fusionado;
+        opcionesLote.soloVerificar = soloVerificar;
+        tiemposLote.medirCiclos = ciclos;
+        tiemposLote.medirContadores = contadores;
+        tiemposLote.medirMemoria = memoria;
+        if (etapas)
+            opcionesLote.tiempos = &tiemposLote;
+        if (deduplicar)
+        {
+            crearDirectorio(normalizarDirectorio(salidaLote));
+            almacenLote.reset(new AlmacenContenido(normalizarDirectorio(salidaLote) + "almacen/"));
+            opcionesLote.almacen = almacenLote.get();
+        }
+
+        ResumenLote resumen = mainLote(archivos, salidaLote, opcionesLote, hilos);
+        if (!archivoHistogramas.empty())
+            guardarHistogramas(archivoHistogramas, {{"lote", &tiemposLote}});
+        if (!archivoTraza.empty())
+            guardarTraza(archivoTraza);
+        return resumen.fallidos == 0 ? 0 : 1;
+    }
+
     int N = 0;
-    cout << "Indica el numero de copias a realizar (menor a 50): ";
+    cout << "Indica el numero de copias a realizar: ";
     cin >> N;
-    while (N < 1 || N > 50)
+    while (N < 1 || (hiloPorCopia && N > 50))
+    {
+        // Con un hilo por copia se mantiene el límite original; el pool no lo necesita
+        cout << (hiloPorCopia ? "El numero debe ser entre 1 y 50. Intenta de nuevo: " : "El numero debe ser mayor que 0. Intenta de nuevo: ");
+        if (!(cin >> N))
+            return 1;
+    }
+
+    // Cada modo usa su propio almacén para que uno no caliente los resultados del otro
+    unique_ptr<AlmacenContenido> almacenSecuencial, almacenParalelo;
+    OpcionesProceso opcionesSecuencial, opcionesParalelo;
+    TiemposEtapas tiemposSecuencial, tiemposParalelo;
+    opcionesSecuencial.fusionado = opcionesParalelo.fusionado = fusionado;
+    opcionesSecuencial.soloVerificar = opcionesParalelo.soloVerificar = soloVerificar;
+    tiemposSecuencial.medirCiclos = tiemposParalelo.medirCiclos = ciclos;
+    tiemposSecuencial.medirContadores = tiemposParalelo.medirContadores = contadores;
+    tiemposSecuencial.medirMemoria = tiemposParalelo.medirMemoria = memoria;
+    if (etapas)
     {
-        cout << "El numero debe ser entre 1 y 50. Intenta de nuevo: ";
-        cin >> N;
+        opcionesSecuencial.tiempos = &tiemposSecuencial;
+        opcionesParalelo.tiempos = &tiemposParalelo;
+    }
+    if (deduplicar)
+    {
+        almacenSecuencial.reset(new AlmacenContenido("file_workspace_sequential/almacen/"));
+        almacenParalelo.reset(new AlmacenContenido("file_workspace_parallel/almacen/"));
+        opcionesSecuencial.almacen = almacenSecuencial.get();
+        opcionesParalelo.almacen = almacenParalelo.get();
     }
 
-    Temporizador tiempoSecuencial = mainSecuencial(N);
-    cout << endl;
-    Temporizador tiempoParalelo = mainParalelo(N);
+    unique_ptr<ColocacionHilos> colocacion;
+    if (afinidad != AFINIDAD_NINGUNA || nodosSimulados > 0)
+        colocacion.reset(new ColocacionHilos(afinidad, nodosSimulados));
 
-    double tiempoSec = tiempoSecuencial.duracionSegundos();
-    double tiempoPar = tiempoParalelo.duracionSegundos();
+#ifndef CORRUTINAS_DISPONIBLES
+    if (corrutinas)
+    {
+        cerr << "--corrutinas requiere compilar con -std=c++20 en Linux; se usa el pool de hilos" << endl;
+        corrutinas = false;
+    }
+    (void)enVuelo; // Solo lo usa el modo de corrutinas
+#endif
+    // En corrutinas cada etapa se cronometra en el hilo del reactor pero se ejecuta en los pools:
+    // los contadores y la memoria de ese hilo no dirían nada de la etapa
+    if (corrutinas && (contadores || memoria))
+    {
+        cerr << "--contadores y --memoria no se miden con --corrutinas; solo se muestran en el modo secuencial" << endl;
+        tiemposParalelo.medirContadores = tiemposParalelo.medirMemoria = false;
+    }
 
-    double mejora = ((tiempoSec - tiempoPar) / tiempoSec) * 100.0;
+    // Fase paralela con el modelo elegido en la línea de comandos
+    auto ejecutarParalelo = [&]() -> Temporizador
+    {
+#ifdef CORRUTINAS_DISPONIBLES
+        if (corrutinas)
+            return mainCorrutinas(N, opcionesParalelo, 1, hilos, enVuelo);
+#endif
+        return dag            ? mainDAG(N, opcionesParalelo, hilos)
+               : hiloPorCopia ? mainParaleloHiloPorCopia(N, opcionesParalelo)
+                              : mainParalelo(N, opcionesParalelo, hilos, colocacion.get(), adaptativo ? &control : nullptr);
+    };
+
+    if (banco)
+    {
+        configuracionBanco.directorios = {"file_workspace_sequential/", "file_workspace_parallel/"};
+        if (deduplicar)
+            configuracionBanco.almacenes = {"file_workspace_sequential/almacen/", "file_workspace_parallel/almacen/"};
+        BancoPruebas bancoPruebas(configuracionBanco);
+        bancoPruebas.antesDeMedir([&]
+                                  { tiemposSecuencial.reiniciar();
+                                    tiemposParalelo.reiniciar(); });
+        bancoPruebas.agregar("secuencial", [&]
+                             { return mainSecuencial(N, opcionesSecuencial).duracionSegundos(); });
+        bancoPruebas.agregar("paralelo", [&]
+                             { return ejecutarParalelo().duracionSegundos(); });
+        bancoPruebas.ejecutar();
+        cout << bancoPruebas.resumen() << endl;
+        if (!archivoJSON.empty())
+        {
+            ofstream salida(archivoJSON);
+            if (!salida.is_open())
+                cerr << "No se pudo crear " << archivoJSON << endl;
+            else
+                salida << bancoPruebas.json() << endl;
+        }
+    }
+    else
+    {
+        Temporizador tiempoSecuencial = mainSecuencial(N, opcionesSecuencial);
+        cout << endl;
+        Temporizador tiempoParalelo = ejecutarParalelo();
+
+        double tiempoSec = tiempoSecuencial.duracionSegundos();
+        double tiempoPar = tiempoParalelo.duracionSegundos();
+
+        double mejora = ((tiempoSec - tiempoPar) / tiempoSec) * 100.0;
+
+        cout << fixed << setprecision(2);
+        cout << "================================" << endl;
+        cout << "PORCENTAJE DE MEJORA: " << mejora << " %" << endl;
+        cout << "================================" << endl;
+    }
 
-    cout << fixed << setprecision(2);
-    cout << "================================" << endl;
-    cout << "PORCENTAJE DE MEJORA: " << mejora << " %" << endl;
-    cout << "================================" << endl;
+    if (!archivoHistogramas.empty())
+        guardarHistogramas(archivoHistogramas, {{"secuencial", &tiemposSecuencial}, {"paralelo", &tiemposParalelo}});
+    if (!archivoTraza.empty())
+        guardarTraza(archivoTraza);
 
     return 0;
 }
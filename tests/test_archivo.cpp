@@ -31,6 +31,10 @@
  *   diferencias.
  * - Compara el contenido de origin.txt y d_copia1.txt con compararArchivos para confirmar
  *   que la desencriptación recupera el contenido original.
+ * - Verifica con verificarDesencriptado que desencriptar en memoria copia1_encriptada.txt
+ *   reproduce origin.txt sin escribir ningún archivo.
+ * - Comprueba que generarHashArchivo da el SHA-256 de la entrada vacía para un archivo vacío
+ *   y una cadena vacía para un archivo que no existe.
  *
  * @return int Retorna 0 si la prueba se ejecuta correctamente.
  */
@@ -73,5 +77,17 @@ int main()
      bool sonIgualesContenido = compararArchivos(workspace_root + archivoEntrada, workspace_root + archivoDesencriptado);
      cout << "\n- El contenido del archivo original y el desencriptado son iguales: " << (sonIgualesContenido ? "Sí" : "No") << endl;
 
+     // Verificar el desencriptado en memoria, sin generar un archivo intermedio
+     bool verificado = verificarDesencriptado(workspace_root + archivoEncriptado, workspace_root + archivoEntrada);
+     cout << "\n- El desencriptado en memoria coincide con el original: " << (verificado ? "Sí" : "No") << endl;
+
+     // Un archivo vacío tiene hash (el mismo que da sha256sum); solo un archivo ilegible da ""
+     string archivoVacio = workspace_root + "vacio.txt";
+     ofstream(archivoVacio).close();
+     bool hashVacio = generarHashArchivo(archivoVacio) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+     bool hashInexistente = generarHashArchivo(workspace_root + "no_existe.txt").empty();
+     remove(archivoVacio.c_str());
+     cout << "\n- El archivo vacío tiene el hash de la entrada vacía: " << (hashVacio && hashInexistente ? "Sí" : "No") << endl;
+
      return 0;
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+/**
+ * @file test_delta.cpp
+ * @brief Prueba unitaria para el reencriptado por bloques.
+ *
+ * Este archivo contiene una prueba unitaria que verifica reencriptarDelta, definida en
+ * F31_delta.h. Modifica, acorta y alarga un archivo entre ejecuciones, y estropea su firma de
+ * bloques, comprobando en cada caso que la salida queda byte a byte igual a la de
+ * encriptarArchivo y que solo se reescribieron los bloques esperados.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F31_delta.h: Contiene reencriptarDelta y, a través de F01_archivo.h, encriptarArchivo.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F31_delta.h"
+
+const string workspace_root = "test_file_workspace/";
+const long long bloque = 4096; // Bloques pequeños para tener varios sin archivos grandes
+
+/**
+ * @brief Escribe el contenido en la ruta y adelanta su fecha de modificación.
+ *
+ * reencriptarDelta da el archivo por igual si el tamaño y la fecha coinciden con la firma; con
+ * relojes de resolución gruesa dos escrituras seguidas podrían tener la misma fecha.
+ */
+void escribirArchivo(const string &ruta, const string &contenido, int segundos)
+{
+    ofstream archivo(ruta, ios::binary | ios::trunc);
+    archivo << contenido;
+    archivo.close();
+    timespec fechas[2] = {{0, UTIME_OMIT}, {1700000000 + segundos, 0}};
+    utimensat(AT_FDCWD, ruta.c_str(), fechas, 0);
+}
+
+/**
+ * @brief Indica si la salida de reencriptarDelta es idéntica a la de encriptarArchivo.
+ */
+bool igualAEncriptarArchivo(const string &entrada, const string &salida)
+{
+    string referencia = workspace_root + "delta_referencia.sha";
+    encriptarArchivo(entrada, referencia);
+    return devolverContenidoArchivo(referencia) == devolverContenidoArchivo(salida);
+}
+
+/**
+ * @brief Ejecuta una prueba unitaria para reencriptarDelta.
+ *
+ * Parte de un archivo de 10 bloques y medio de 4 KiB y lo reencripta después de: no cambiar
+ * nada, cambiar un byte del bloque 3, acortarlo a 5 bloques y medio, alargarlo a 8 bloques y
+ * estropear la firma. Muestra por consola, para cada caso, si la salida coincide con la de
+ * encriptarArchivo y si la cantidad de bloques reescritos es la esperada.
+ *
+ * @return int Retorna 0 si la prueba se ejecuta correctamente.
+ */
+
+int main()
+{
+    string entrada = workspace_root + "delta_original.txt";
+    string salida = workspace_root + "delta_original.sha";
+    unlink((salida + EXTENSION_FIRMA_BLOQUES).c_str());
+
+    string contenido;
+    for (long long j = 0; j < 10 * bloque + bloque / 2; j++)
+        contenido += static_cast<char>('a' + (j * 7 + j / 13) % 26);
+    escribirArchivo(entrada, contenido, 0);
+
+    // Primera vez: no hay firma, se escribe la salida entera
+    ResultadoDelta inicial = reencriptarDelta(entrada, salida, 2, false, bloque);
+    bool inicialBien = inicial.correcto && inicial.completo && igualAEncriptarArchivo(entrada, salida);
+
+    // Sin cambios: tamaño y fecha iguales a la firma
+    ResultadoDelta igual = reencriptarDelta(entrada, salida, 2, false, bloque);
+    bool igualBien = igual.correcto && igual.sinCambios && igual.hashArbol == inicial.hashArbol;
+
+    // Un byte distinto en el bloque 3: solo ese bloque se reescribe
+    contenido[3 * bloque + 10] = contenido[3 * bloque + 10] == 'z' ? 'a' : 'z';
+    escribirArchivo(entrada, contenido, 1);
+    ResultadoDelta modificado = reencriptarDelta(entrada, salida, 2, false, bloque);
+    bool modificadoBien = modificado.correcto && !modificado.completo && modificado.bloquesCambiados == 1 &&
+                          igualAEncriptarArchivo(entrada, salida);
+
+    // Más corto: los bloques que quedan no cambian y el último (parcial) es nuevo
+    contenido.resize(5 * bloque + bloque / 2);
+    escribirArchivo(entrada, contenido, 2);
+    ResultadoDelta acortado = reencriptarDelta(entrada, salida, 2, false, bloque);
+    bool acortadoBien = acortado.correcto && !acortado.completo && acortado.bloquesCambiados == 1 &&
+                        igualAEncriptarArchivo(entrada, salida);
+
+    // Más largo: el bloque que era parcial y los dos siguientes son nuevos
+    contenido += string(8 * bloque - contenido.size(), 'q');
+    escribirArchivo(entrada, contenido, 3);
+    ResultadoDelta alargado = reencriptarDelta(entrada, salida, 2, false, bloque);
+    bool alargadoBien = alargado.correcto && !alargado.completo && alargado.bloquesCambiados == 3 &&
+                        igualAEncriptarArchivo(entrada, salida);
+
+    // Firma estropeada: no se puede confiar en ella y se reescribe todo
+    escribirArchivo(salida + EXTENSION_FIRMA_BLOQUES, "esto no es una firma\n", 4);
+    contenido[0] = contenido[0] == 'z' ? 'a' : 'z';
+    escribirArchivo(entrada, contenido, 5);
+    ResultadoDelta firmaInvalida = reencriptarDelta(entrada, salida, 2, false, bloque);
+    bool firmaInvalidaBien = firmaInvalida.correcto && firmaInvalida.completo && firmaInvalida.bloquesCambiados == 8 &&
+                             igualAEncriptarArchivo(entrada, salida);
+
+    cout << "Bloques cambiados: modificado " << modificado.bloquesCambiados << ", acortado " << acortado.bloquesCambiados << ", alargado "
+         << alargado.bloquesCambiados << ", firma invalida " << firmaInvalida.bloquesCambiados << endl;
+    cout << "\nPrimera ejecucion igual a encriptarArchivo: " << (inicialBien ? "Sí" : "No") << endl;
+    cout << "Sin cambios no reescribe nada: " << (igualBien ? "Sí" : "No") << endl;
+    cout << "Un byte cambiado reescribe un bloque: " << (modificadoBien ? "Sí" : "No") << endl;
+    cout << "Archivo acortado igual a encriptarArchivo: " << (acortadoBien ? "Sí" : "No") << endl;
+    cout << "Archivo alargado igual a encriptarArchivo: " << (alargadoBien ? "Sí" : "No") << endl;
+    cout << "Firma invalida reescribe la salida entera: " << (firmaInvalidaBien ? "Sí" : "No") << endl;
+
+    return 0;
+}
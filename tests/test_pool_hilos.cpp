@@ -0,0 +1,85 @@
+/**
+ * @file test_pool_hilos.cpp
+ * @brief Prueba unitaria para el pool de hilos con cola acotada.
+ *
+ * Este archivo contiene una prueba unitaria que verifica la clase PoolHilos definida en
+ * F14_pool_hilos.h. Envía muchos más trabajos que la capacidad de la cola y comprueba que
+ * todos se ejecutan, tanto los que devuelven su resultado con un future como los que lo
+ * entregan a una función de retorno. También comprueba que un pool limitado a 1 de sus hilos
+ * (ajustarActivos) sigue completando trabajos.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F14_pool_hilos.h: Contiene la clase PoolHilos.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F14_pool_hilos.h"
+#include <atomic>
+
+/**
+ * @brief Ejecuta una prueba unitaria para la clase PoolHilos.
+ *
+ * Crea un pool de 4 hilos con una cola de 8 trabajos, envía 1000 trabajos con future que
+ * calculan el cuadrado de su índice y 1000 trabajos con función de retorno que suman a un
+ * contador atómico. Después limita un pool de 8 hilos a 1 activo y envía trabajos de uno en
+ * uno, esperando cada uno como mucho 2 segundos: si el aviso de trabajo nuevo despertara solo a
+ * un hilo sin permiso, el trabajo se quedaría en la cola. Muestra por consola si las sumas
+ * obtenidas coinciden con las esperadas y si el pool limitado completó todos los trabajos.
+ *
+ * @return int Retorna 0 si la prueba se ejecuta correctamente.
+ */
+
+int main()
+{
+    const int trabajos = 1000;
+    PoolHilos pool(4, 8);
+
+    vector<future<long long>> resultados;
+    for (int i = 0; i < trabajos; i++)
+        resultados.push_back(pool.enviar([i]
+                                         { return static_cast<long long>(i) * i; }));
+
+    long long sumaFutures = 0;
+    for (auto &resultado : resultados)
+        sumaFutures += resultado.get();
+
+    atomic<long long> sumaRetorno(0);
+    for (int i = 0; i < trabajos; i++)
+        pool.enviar([i]
+                    { return static_cast<long long>(i); },
+                    [&sumaRetorno](long long valor)
+                    { sumaRetorno += valor; });
+    pool.esperarTodo();
+
+    long long esperadaFutures = static_cast<long long>(trabajos - 1) * trabajos * (2 * trabajos - 1) / 6;
+    long long esperadaRetorno = static_cast<long long>(trabajos - 1) * trabajos / 2;
+
+    // Pool limitado a 1 de 8 hilos: los 7 sin permiso duermen en la misma variable de condición
+    int completadosLimitado = 0;
+    const int trabajosLimitado = 200;
+    {
+        PoolHilos limitado(8, 4);
+        limitado.ajustarActivos(1);
+        for (int i = 0; i < trabajosLimitado; i++)
+        {
+            future<int> resultado = limitado.enviar([i]
+                                                    { return i; });
+            if (resultado.wait_for(chrono::seconds(2)) != future_status::ready)
+                break;
+            completadosLimitado += resultado.get() == i;
+        }
+    }
+
+    cout << "Hilos del pool:          " << pool.numeroHilos() << endl;
+    cout << "Suma con future:         " << sumaFutures << " (esperada " << esperadaFutures << ")" << endl;
+    cout << "Suma con retorno:        " << sumaRetorno << " (esperada " << esperadaRetorno << ")" << endl;
+    cout << "Limitado a 1 hilo:       " << completadosLimitado << " de " << trabajosLimitado << " trabajos" << endl;
+    cout << "\nEl pool ejecutó todos los trabajos: " << (sumaFutures == esperadaFutures && sumaRetorno == esperadaRetorno ? "Sí" : "No") << endl;
+    cout << "El pool limitado ejecutó todos los trabajos: " << (completadosLimitado == trabajosLimitado ? "Sí" : "No") << endl;
+
+    return 0;
+}
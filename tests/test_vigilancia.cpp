@@ -0,0 +1,123 @@
+/**
+ * @file test_vigilancia.cpp
+ * @brief Prueba unitaria para el modo vigilancia ejecutado desde la raíz del árbol.
+ *
+ * Este archivo contiene una prueba unitaria que verifica VigilanciaDirectorio, definida en
+ * F30_vigilancia.h, cuando el árbol vigilado es "." y el directorio de salida está dentro de él.
+ * Comprueba que la salida no se vuelve a procesar aunque se escriba de otra forma ("./", ruta
+ * absoluta) y que los archivos *.tmp y el manifiesto quedan fuera.
+ *
+ * Dependencias:
+ * - resources.h: Incluye librerías estándar de C++ (string, iostream, etc) para simplificar las inclusiones.
+ * - F30_vigilancia.h: Contiene VigilanciaDirectorio y, a través de F01_archivo.h, encriptarArchivo.
+ *
+ * @author badjavii
+ * @date 10-18-2026
+ */
+
+#include "../resources.h"
+#include "../src/F30_vigilancia.h"
+
+const string workspace_root = "test_file_workspace/";
+const string arbol = workspace_root + "vigilancia/";
+
+/**
+ * @brief Cuenta las entradas de un manifiesto de vigilancia e indica si alguna es la ruta dada.
+ */
+int entradasManifiesto(const string &ruta, const string &buscada, bool &encontrada)
+{
+    ifstream manifiesto(ruta);
+    string linea;
+    int entradas = 0;
+    encontrada = false;
+    while (getline(manifiesto, linea))
+    {
+        if (linea.empty() || linea[0] == '#')
+            continue;
+        entradas++;
+        if (linea.compare(0, buscada.size() + 1, buscada + "\t") == 0)
+            encontrada = true;
+    }
+    return entradas;
+}
+
+/**
+ * @brief Sincroniza el árbol actual una vez y devuelve la cantidad de errores.
+ */
+long long vigilarUnaVez(const string &raiz, const string &salida, const string &manifiesto = "")
+{
+    VigilanciaDirectorio vigilancia(raiz, salida, manifiesto, 2, 0);
+    if (!vigilancia.iniciar())
+        return -1;
+    vigilancia.ejecutar(true);
+    return vigilancia.numeroErrores();
+}
+
+/**
+ * @brief Ejecuta una prueba unitaria para VigilanciaDirectorio.
+ *
+ * Crea un árbol con a.txt, sub/b.txt y c.tmp, entra en él y lo sincroniza: primero con "." y la
+ * salida por defecto, después con "./" y la salida como ruta absoluta, y por último con el
+ * manifiesto dentro del árbol. Muestra por consola si la salida es la esperada y si el árbol de
+ * salida, los temporales y el manifiesto quedaron fuera de la vigilancia.
+ *
+ * @return int Retorna 0 si la prueba se ejecuta correctamente.
+ */
+
+int main()
+{
+    // Restos de una ejecución anterior
+    for (const char *ruta : {"a.txt", "c.tmp", "sub/b.txt", "file_workspace_watch/a.txt.enc", "file_workspace_watch/sub/b.txt.enc",
+                               "file_workspace_watch/vigilancia.manifiesto", "vigilancia.manifiesto"})
+        unlink((arbol + ruta).c_str());
+    for (const char *ruta : {"file_workspace_watch/sub", "file_workspace_watch", "sub"})
+        rmdir((arbol + ruta).c_str());
+
+    crearDirectorio(arbol);
+    crearDirectorio(arbol + "sub");
+    ofstream(arbol + "a.txt") << "Hola mundo\n";
+    ofstream(arbol + "sub/b.txt") << "Otro archivo\n";
+    ofstream(arbol + "c.tmp") << "Temporal\n";
+
+    char directorioInicial[4096];
+    if (getcwd(directorioInicial, sizeof(directorioInicial)) == nullptr || chdir(arbol.c_str()) != 0)
+    {
+        cerr << "No se pudo entrar en " << arbol << endl;
+        return 1;
+    }
+    char raizAbsoluta[4096];
+    string salidaAbsoluta = string(getcwd(raizAbsoluta, sizeof(raizAbsoluta))) + "/file_workspace_watch/";
+
+    // Desde la raíz, con la salida por defecto dentro del árbol
+    long long errores = vigilarUnaVez(".", "file_workspace_watch/");
+    encriptarArchivo("a.txt", "a.referencia");
+    bool salidaBien = devolverContenidoArchivo("file_workspace_watch/a.txt.enc") == devolverContenidoArchivo("a.referencia") &&
+                      devolverTamanoArchivo("file_workspace_watch/sub/b.txt.enc") > 0;
+    unlink("a.referencia");
+    bool encontrada;
+    int entradas = entradasManifiesto("file_workspace_watch/vigilancia.manifiesto", "./c.tmp", encontrada);
+    bool sinAnidar = devolverTamanoArchivo("file_workspace_watch/file_workspace_watch/a.txt.enc.enc") < 0 &&
+                     devolverTamanoArchivo("file_workspace_watch/a.txt.enc.enc") < 0;
+    bool primeraBien = errores == 0 && salidaBien && entradas == 2 && sinAnidar;
+    bool temporalFuera = !encontrada;
+
+    // Otra vez, escribiendo la raíz y la salida de otra forma: la salida sigue fuera
+    errores = vigilarUnaVez("./", salidaAbsoluta);
+    entradas = entradasManifiesto("file_workspace_watch/vigilancia.manifiesto", "./file_workspace_watch/a.txt.enc", encontrada);
+    bool segundaBien = errores == 0 && entradas == 2 && !encontrada && devolverTamanoArchivo("file_workspace_watch/a.txt.enc.enc") < 0;
+
+    // Con el manifiesto dentro del árbol, el manifiesto no se procesa a sí mismo
+    errores = vigilarUnaVez(".", "file_workspace_watch/", "./vigilancia.manifiesto");
+    entradas = entradasManifiesto("vigilancia.manifiesto", "./vigilancia.manifiesto", encontrada);
+    bool manifiestoFuera = errores == 0 && entradas == 2 && !encontrada;
+
+    if (chdir(directorioInicial) != 0)
+        return 1;
+
+    cout << "Salida de la primera sincronizacion correcta y sin anidar: " << (primeraBien ? "Sí" : "No") << endl;
+    cout << "La salida escrita con otra ruta no se vuelve a procesar: " << (segundaBien ? "Sí" : "No") << endl;
+    cout << "Los archivos .tmp no se procesan: " << (temporalFuera ? "Sí" : "No") << endl;
+    cout << "El manifiesto dentro del arbol no se procesa: " << (manifiestoFuera ? "Sí" : "No") << endl;
+
+    return 0;
+}